@@ -27,6 +27,9 @@
 #include <deque>
 #include <set>
 #include <map>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
 #include "actions_types.h"
 #include "boost/dynamic_bitset.hpp"
 #include "../../../language/language.h"
@@ -47,7 +50,7 @@ namespace kripke {
 
         [[nodiscard]] del::language_ptr get_language() const;
         [[nodiscard]] action_type get_type() const;
-        [[nodiscard]] std::string get_name() const;
+        [[nodiscard]] const std::string &get_name() const;
         [[nodiscard]] unsigned long long get_events_number() const;
         [[nodiscard]] const event_bitset &get_agent_possible_events(del::agent ag, event_id e) const;
         [[nodiscard]] bool has_edge(del::agent ag, event_id e, event_id f) const;
@@ -56,9 +59,27 @@ namespace kripke {
         [[nodiscard]] const event_set &get_designated_events() const;
         [[nodiscard]] bool is_designated(event_id e) const;
 
+        // Preprocessed representation of the action, computed once at construction
+        [[nodiscard]] event_span get_agent_successors(del::agent ag, event_id e) const;
+        // Events with the same ag-successors have the same ag-row (for equivalence relations, rows are the classes)
+        [[nodiscard]] row_id get_agent_row_id(del::agent ag, event_id e) const;
+        [[nodiscard]] bool is_equivalence(del::agent ag) const;
+        [[nodiscard]] const std::vector<event_id> &get_sorted_designated_events() const;
+        [[nodiscard]] unsigned long get_formulas_number() const;
+        [[nodiscard]] const del::formula &get_formula(formula_id f) const;
+        [[nodiscard]] formula_id get_precondition_id(event_id e) const;
+        [[nodiscard]] postconditions_span get_compiled_postconditions(event_id e) const;
+
         [[nodiscard]] bool is_ontic(event_id e) const;
         [[nodiscard]] bool is_purely_epistemic() const;
         [[nodiscard]] unsigned long get_maximum_depth() const;
+        [[nodiscard]] bool has_propositional_postconditions() const;
+
+        // Cache of the relabellings (label_id, e) -> label_id of propositional postconditions. Label ids refer to the
+        // label storage of the current planning task, so an action must not be shared among tasks with different storages.
+        // The cache is shared by the threads of the parallel search
+        [[nodiscard]] std::optional<label_id> get_label_transition(event_id e, label_id l) const;
+        void add_label_transition(event_id e, label_id l, label_id l_) const;
 
         friend std::ostream &operator<<(std::ostream &os, const action &act);
 
@@ -73,9 +94,24 @@ namespace kripke {
         postconditions m_postconditions;
         boost::dynamic_bitset<> m_is_ontic;
         event_set m_designated_events;
-        unsigned long m_maximum_depth;
+        unsigned long m_maximum_depth, m_postconditions_depth;
+
+        std::vector<event_id> m_successors;                         // The sorted successors of (ag, e) are stored in
+        std::vector<std::size_t> m_successors_offsets;              // [offsets[ag*|E|+e], offsets[ag*|E|+e+1])
+        std::vector<row_id> m_rows_ids;                             // The ag-row of e is rows_ids[ag*|E|+e]
+        boost::dynamic_bitset<> m_is_equivalence;
+        boost::dynamic_bitset<> m_designated_bitset;
+        std::vector<event_id> m_sorted_designated_events;
+        std::vector<del::formula_ptr> m_formulas;                   // Table of the distinct pre- and postconditions
+        std::vector<formula_id> m_preconditions_ids;
+        std::vector<compiled_postcondition> m_compiled_postconditions;   // Sorted by atom, those of e are in
+        std::vector<std::size_t> m_postconditions_offsets;               // [offsets[e], offsets[e+1])
+
+        mutable events_label_transitions m_label_transitions;
+        std::unique_ptr<std::shared_mutex> m_label_transitions_mutex;     // Behind a pointer to keep actions movable
 
         void calculate_maximum_depth();
+        void preprocess();
     };
 }
 
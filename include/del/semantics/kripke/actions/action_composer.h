@@ -0,0 +1,56 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef DAEDALUS_ACTION_COMPOSER_H
+#define DAEDALUS_ACTION_COMPOSER_H
+
+#include <map>
+#include "action.h"
+#include "actions_types.h"
+#include "../../../formulas/all_formulas.h"
+
+namespace kripke {
+    class action_composer {
+    public:
+        // Builds the event model a;b, such that s (x) (a;b) is bisimilar to (s (x) a) (x) b. Events of a;b are the pairs
+        // (e, f) with precondition pre(e) /\ [e]pre(f). If minimize is true, we only keep the events that are reachable
+        // from the designated ones and we contract the resulting event model
+        static action compose(const action &a, const action &b, bool minimize = true);
+        static action compose(const action_deque &as, bool minimize = true);
+
+    private:
+        using regression_memo = std::map<std::pair<const del::formula *, event_id>, del::formula_ptr>;
+
+        // regress(f, a, e) is a formula that holds in w iff f holds in (w, e), for all worlds w that satisfy pre(e)
+        static del::formula_ptr regress(const del::formula_ptr &f, const action &a, event_id e, regression_memo &memo);
+
+        static del::formula_ptr regress_atom   (const del::formula_ptr &f, const action &a, event_id e);
+        static del::formula_ptr regress_box    (const del::box_formula     &f, const action &a, event_id e, regression_memo &memo);
+        static del::formula_ptr regress_diamond(const del::diamond_formula &f, const action &a, event_id e, regression_memo &memo);
+
+        static del::formula_ptr make_and(del::formula_deque fs);
+        static del::formula_ptr make_or (del::formula_deque fs);
+    };
+}
+
+#endif //DAEDALUS_ACTION_COMPOSER_H
@@ -29,9 +29,11 @@
 #include <set>
 #include <deque>
 #include <unordered_set>
+#include <unordered_map>
 #include "../../../language/language_types.h"
 #include "../../../../utils/bit_deque.h"
 #include "../../../formulas/formula.h"
+#include "../states/states_types.h"
 
 namespace kripke {
     class formula;
@@ -50,6 +52,26 @@ namespace kripke {
     using event_post     = std::unordered_map<del::atom, del::formula_ptr>;
     using postconditions = std::vector<event_post>;
 
+    using formula_id               = unsigned long;
+    using compiled_postcondition   = std::pair<del::atom, formula_id>;
+
+    // Contiguous range of elements of a preprocessed action
+    template<typename T>
+    struct array_span {
+        const T *m_begin, *m_end;
+
+        [[nodiscard]] const T *begin() const { return m_begin; }
+        [[nodiscard]] const T *end()   const { return m_end;   }
+        [[nodiscard]] std::size_t size() const { return m_end - m_begin; }
+        [[nodiscard]] bool empty() const { return m_begin == m_end; }
+    };
+
+    using event_span          = array_span<event_id>;
+    using postconditions_span = array_span<compiled_postcondition>;
+
+    using label_transitions        = std::unordered_map<label_id, label_id>;
+    using events_label_transitions = std::vector<label_transitions>;
+
     enum class action_type : uint8_t {
         public_ontic,
         private_ontic,
@@ -57,7 +79,8 @@ namespace kripke {
         public_sensing,
         private_announcement,
         semi_private_announcement,
-        public_announcement
+        public_announcement,
+        composite
     };
 }
 
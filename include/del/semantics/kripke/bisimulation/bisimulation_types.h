@@ -38,61 +38,19 @@ namespace kripke {
         canonical
     };
 
-    using agent_worlds_labels = std::vector<del::agent>;
-
-    struct q_block;
-    struct x_block;
-
-    using block                 = bit_deque;
-    using q_block_ptr           = std::shared_ptr<q_block>;
-    using x_block_ptr           = std::shared_ptr<x_block>;
-    using q_partition           = std::vector<q_block_ptr>;
-    using x_partition           = std::list<x_block_ptr>;
-    using compound_x_blocks_set = std::unordered_set<x_block_ptr>;
-    using q_block_ptr_vector    = std::vector<q_block_ptr>;
-    using q_block_ptr_list      = std::list<q_block_ptr>;
-    using counts_vector         = std::vector<unsigned long>;
-    using split_q_blocks_map    = std::unordered_map<q_block_ptr, q_block_ptr>;
-
-    // Paige and Tarjan data structures
-    /* - Each block of Q has an associated integer giving its size (already present in std::list) and
-     * - Points to a doubly linked list of the elements in it.
-     * - Each block of Q points to the block of X containing it.*/
-    struct q_block {
-        block elements;
-        x_block_ptr super_block;
-
-        q_block(block elements_, x_block_ptr super_block_) :
-            elements{std::move(elements_)},
-            super_block{std::move(super_block_)} {}
-
-        q_block(const q_block&) = default;
-        q_block& operator=(const q_block&) = delete;
-
-        q_block(q_block&&) = default;
-        q_block& operator=(q_block&&) = default;
-
-        ~q_block() = default;
+    // Engines that calculate the bisimulation classes for full contractions
+    enum class refinement_engine : uint8_t {
+        paige_tarjan,
+        bounded_refinement,
+        partition_intersection
     };
 
-    /* - Each block of X points to a doubly linked list of the blocks of Q contained in it.
-     * -*/
-    struct x_block {
-        q_block_ptr_list sub_blocks;
-        counts_vector counts;
-
-        x_block(q_block_ptr_list sub_blocks_, counts_vector counts_) :
-            sub_blocks{std::move(sub_blocks_)},
-            counts{std::move(counts_)} {}
-
-        x_block(const x_block&) = default;
-        x_block& operator=(const x_block&) = delete;
+    using block = bit_deque;
 
-        x_block(x_block&&) = default;
-        x_block& operator=(x_block&&) = default;
-
-        ~x_block() = default;
-    };
+    // Ids of worlds, edges and blocks in the data structures of the partition refinement algorithms. These structures
+    // are all stored in flat arrays, so that the memory they use is linear in |W| + |R|
+    using pt_id     = unsigned long;
+    using pt_vector = std::vector<pt_id>;
 }
 
 #endif //DAEDALUS_BISIMULATION_TYPES_H
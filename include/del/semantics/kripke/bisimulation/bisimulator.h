@@ -24,11 +24,15 @@
 #ifndef DAEDALUS_BISIMULATOR_H
 #define DAEDALUS_BISIMULATOR_H
 
+#include <algorithm>
+#include <atomic>
+#include <tuple>
 #include <utility>
 #include "../../../language/language.h"
 #include "bounded_bisimulation_types.h"
 #include "../../../../utils/storages_handler.h"
 #include "../states/state.h"
+#include "../actions/action.h"
 #include "bisimulation_types.h"
 #include "../../../../search/search_types.h"
 
@@ -40,11 +44,74 @@ namespace kripke {
 
         static bool are_bisimilar(const state &s, const state &t, unsigned long k, del::storages_handler_ptr handler);
 
-        /*static std::tuple<bool, state, bpr_structures> resume_contraction(contraction_type type, const state &s, unsigned long k,
-                                                         bpr_structures &structures, del::storages_handler_ptr handler = nullptr);*/
+        // Unbounded version of are_bisimilar, which refines the disjoint union of s and t with Paige-Tarjan
+        static bool are_bisimilar(const state &s, const state &t);
+
+        // Hash of s that is invariant under k-bisimulation: if s and t are k-bisimilar, then they have the same
+        // k-fingerprint. It hashes the set of the k-signatures of the designated worlds, where the (h+1)-signature of
+        // a world hashes its h-signature and the sets of h-signatures of its successors for each agent
+        [[nodiscard]] static std::size_t calculate_fingerprint(const state &s, unsigned long k);
+
+        // Returns the bisimulation contraction of the event model a, where events are initially partitioned by their
+        // preconditions and postconditions. Events that are not reachable from the designated ones are discarded
+        static action contract(const action &a);
+
+        // Rooted (or canonical) contraction of s wrt. bound k, together with the refinement structures needed to resume it
+        static std::tuple<bool, state, bpr_structures> resumable_contract(contraction_type type, const state &s, unsigned long k,
+                                                                          del::storages_handler_ptr handler = nullptr);
+
+        // Rooted (or canonical) contraction of s wrt. bound k, given the structures calculated wrt. bound k-1. The
+        // structures are updated with one extra refinement step
+        static std::pair<bool, state> resume_contraction(contraction_type type, const state &s, unsigned long k,
+                                                         bpr_structures &structures, del::storages_handler_ptr handler = nullptr);
+
+        // Number of full contractions calculated so far with the given engine
+        [[nodiscard]] static unsigned long long get_full_contractions_number(refinement_engine engine);
+
+        // Chooses the engine that is expected to calculate the bisimulation classes of s faster. States whose relations
+        // are all stored as classes use the partition intersection. Full contractions fall back to Paige-Tarjan if the
+        // chosen engine is not stable within its budget of steps
+        [[nodiscard]] static refinement_engine choose_refinement_engine(const state &s);
 
     private:
+        // Paige-Tarjan takes about as long as this many bounded refinement steps, times log |W|
+        static constexpr double paige_tarjan_cost_factor = 1.5;
+
+        // Number of refinement steps that cost as much as Paige-Tarjan on s
+        [[nodiscard]] static unsigned long calculate_max_steps(const state &s);
+
+        // Number of bounded refinement steps that cost as much as Paige-Tarjan on s, or 0 if s certainly needs more
+        [[nodiscard]] static unsigned long calculate_max_bounded_steps(const state &s);
+
+        static std::atomic<unsigned long long> m_paige_tarjan_contractions_number, m_bounded_contractions_number,
+                                               m_partition_intersection_contractions_number;
+
+        static std::pair<bool, state> calculate_full_contraction(const state &s, del::storages_handler_ptr handler);
+
+        // Quotient of s wrt. the given classes, only keeping the classes that are reachable from the designated ones
+        static state build_quotient(const state &s, world_id classes_number, const std::vector<world_id> &classes);
+
         static state disjoint_union(const state &s, const state &t);
+
+        // True if every designated world of s is in the same block as some designated world of t, and vice versa, where
+        // blocks refer to the worlds of the disjoint union of s and t
+        template<typename Blocks>
+        static bool have_same_designated_blocks(const state &s, const state &t, const Blocks &blocks) {
+            const world_id offset = s.get_worlds_number();
+
+            for (const world_id wd : s.get_designated_worlds())
+                if (std::all_of(t.get_designated_worlds().begin(), t.get_designated_worlds().end(),
+                                [&](const world_id vd) { return blocks[wd] != blocks[offset + vd]; }))
+                    return false;
+
+            for (const world_id vd : t.get_designated_worlds())
+                if (std::all_of(s.get_designated_worlds().begin(), s.get_designated_worlds().end(),
+                                [&](const world_id wd) { return blocks[offset + vd] != blocks[wd]; }))
+                    return false;
+
+            return true;
+        }
+        static state build_events_state(const action &a);
     };
 }
 
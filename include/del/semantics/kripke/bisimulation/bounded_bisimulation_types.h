@@ -33,23 +33,30 @@
 #include "../../../../utils/bit_deque.h"
 #include "../../../../utils/storage.h"
 #include "../states/states_types.h"
+#include "refinable_partition.h"
 #include "../../delphic/states/possibility.h"
 
 namespace kripke {
-    using block_id         = unsigned long;
-    using block            = bit_deque;
-    using block_ptr        = std::shared_ptr<block>;
-    using block_vector     = std::vector<block_ptr>;
-    using block_matrix     = std::vector<block_vector>;
-    using block_deque      = std::deque<block_ptr>;
-    using partition        = std::vector<block_deque>;
-    using split_blocks_map = std::unordered_map<block_ptr, block_ptr>;
+    using block_id      = uint32_t;
+    using level_blocks  = std::vector<block_id>;        // level_blocks[x] is the id of the block of x
+    using levels_blocks = std::vector<level_blocks>;
 
+    // Worlds of the blocks of a level, grouped by counting sort: the worlds of block b are worlds[offsets[b], offsets[b+1])
+    struct level_members {
+        std::vector<world_id> offsets, worlds;
+    };
+
+    // Levels are the plain h-bisimulation partitions, so they do not depend on the bound and the refinement can be
+    // resumed when the bound grows. Compacted structures only keep the levels from 'first_level' on, and drop Q and
+    // r_1, which are rebuilt when the refinement is resumed
     struct bpr_structures {
-        partition Q;
-        block_matrix worlds_blocks;
-        relations r_1;
-        block_id count;
+        unsigned long k;                // Number of refinement steps done so far
+        refinable_partition Q;          // Partition of the last computed level
+        levels_blocks levels;           // levels[h - first_level][x] is the id of the h-block of x
+        relations_preimage r_1;
+        unsigned long first_level = 0;
+
+        [[nodiscard]] const level_blocks &get_level(const unsigned long h) const { return levels[h - first_level]; }
     };
 
     using bpr_structures_ptr = std::shared_ptr<bpr_structures>;
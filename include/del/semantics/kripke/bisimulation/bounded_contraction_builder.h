@@ -26,6 +26,7 @@
 
 #include <set>
 #include <queue>
+#include <tuple>
 #include "bounded_bisimulation_types.h"
 #include "../../../../utils/storages_handler.h"
 #include "../../../../search/search_space.h"
@@ -38,10 +39,13 @@ namespace kripke {
         static std::pair<bool, state> calculate_rooted_contraction(const state &s, unsigned long k, bool canonical = false,
                                                                    del::storages_handler_ptr handler = nullptr);
 
-        /*static std::tuple<bool, state, bpr_structures> update_rooted_contraction(const state &s, unsigned long k, bpr_structures &structures,
-                                                                bool canonical = false, del::storages_handler_ptr handler = nullptr);*/
+        // As calculate_rooted_contraction, but it also returns the (compacted) refinement structures, so that the
+        // contraction wrt. bound k+1 can be calculated by update_rooted_contraction with a single refinement step
+        static std::tuple<bool, state, bpr_structures> calculate_resumable_rooted_contraction(const state &s, unsigned long k, bool canonical = false,
+                                                                                             del::storages_handler_ptr handler = nullptr);
 
-        static std::pair<bool, state> calculate_standard_contraction(const state &n, del::storages_handler_ptr handler = nullptr);
+        static std::pair<bool, state> update_rooted_contraction(const state &s, unsigned long k, bpr_structures &structures,
+                                                                bool canonical = false, del::storages_handler_ptr handler = nullptr);
 
     private:
         static std::pair<bool, state> rooted_contraction_helper(const state &s, unsigned long k, bool is_bisim,
@@ -49,14 +53,17 @@ namespace kripke {
                                                                 del::storages_handler_ptr handler = nullptr);
 
         static std::vector<world_id> calculate_max_representatives(const state &s, unsigned long k,
-                                                                   const block_matrix &worlds_blocks);
+                                                                   const bpr_structures &structures);
+
+        static std::vector<world_id> calculate_min_max_representatives(const level_blocks &blocks,
+                                                                       const std::vector<world_id> &max_reprs);
 
 //        static std::tuple<signature_matrix, signature_vector, signature_map, std::vector<world_id>>
 //            calculate_max_signatures(const state &s, unsigned long k, del::storages_handler_ptr handler);
 
-        static world_id get_block_max_representative(const state &s, const block_ptr &block);
+        static world_id get_block_max_representative(const state &s, const level_members &members, block_id b);
 
-        static void update_block_max_representative(const state &s, const block_ptr &block, world_id max_representative,
+        static void update_block_max_representative(const level_members &members, block_id b, world_id max_representative,
                                                     boost::dynamic_bitset<> &represented, std::vector<world_id> &worlds_max_reprs);
 
 //        static world_id get_max_representative_sign(const state &s, const world_bitset &worlds);
@@ -67,7 +74,8 @@ namespace kripke {
 //                                                   std::vector<world_id> &worlds_max_reprs);
 
         static void update_to_visit_worlds(const state &s, unsigned long k, std::queue<world_id> &to_visit,
-                                           world_id current, boost::dynamic_bitset<> &represented);
+                                           world_id current, const boost::dynamic_bitset<> &represented,
+                                           boost::dynamic_bitset<> &queued);
     };
 }
 
@@ -26,6 +26,8 @@
 
 #include <memory>
 #include <queue>
+#include <utility>
+#include <vector>
 #include "bounded_bisimulation_types.h"
 #include "../../../../utils/storages_handler.h"
 #include "../states/states_types.h"
@@ -38,10 +40,18 @@ namespace kripke {
 
         static information_state_id calculate_state_id(const state &s, unsigned long k, del::storages_handler_ptr &handler);
 
-        static signature_id calculate_world_signature(const state &s, world_id x, unsigned long h,
-                                                      del::storages_handler_ptr &handler, signature_matrix &worlds_signatures);
+        // Calculates the signatures level by level: the 0-signature of x is its label, and its h-signature is its label
+        // together with, for each agent, the sorted (h-1)-signatures of its successors. We only need the h-signatures of
+        // the worlds at distance at most k-h from the designated ones. The returned vector holds the k-signatures, which
+        // are only calculated for the designated worlds
+        static signature_vector calculate_signatures(const state &s, unsigned long k, del::storages_handler_ptr &handler);
 
     private:
+        static constexpr unsigned long min_parallel_worlds_number = 10000;
+
+        // Worlds at distance at most k from the designated ones, in breadth-first order, and the end of each distance layer
+        static std::pair<std::vector<world_id>, std::vector<unsigned long>> calculate_layers(const state &s, unsigned long k);
+
 //        static void calculate_world_signature(const state &s, unsigned long k, world_id x, unsigned long h,
 //                                              del::storages_handler_ptr handler, signature_matrix &worlds_signatures,
 //                                              signature_map &sign_map);
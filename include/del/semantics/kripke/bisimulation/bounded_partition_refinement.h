@@ -29,6 +29,8 @@
 #include <map>
 #include <memory>
 #include <deque>
+#include <limits>
+#include <optional>
 #include <set>
 #include <boost/dynamic_bitset.hpp>
 #include "bounded_bisimulation_types.h"
@@ -43,37 +45,33 @@ namespace kripke {
     public:
         static std::pair<bool, bpr_structures> do_refinement_steps(const state &s, unsigned long k);
         static bool do_extra_refinement_step(const state &s, bpr_structures &structures);
-        static bpr_structures do_all_refinement_steps(const state &s);
 
-    private:
-        static void refinement_step_helper(const state &s, unsigned long k, bpr_structures &structures);
+        // Refines the levels until they are stable, only keeping the last one. Returns the number of bisimulation
+        // classes of s, together with the class of each world of s, or nothing if the levels are not stable after
+        // max_steps refinement steps
+        static std::optional<std::pair<world_id, std::vector<world_id>>>
+        calculate_classes(const state &s, unsigned long max_steps = std::numeric_limits<unsigned long>::max());
 
-        static void do_refinement_step(const state &s, unsigned long k, unsigned long h, bpr_structures &structures);
+        // Drops the parts of the structures that are not needed to resume the refinement and to build the rooted
+        // contraction of s wrt. the next bound, namely structures.k
+        static void compact(const state &s, bpr_structures &structures);
 
-        static void copy_partition(const state &s, unsigned long k, unsigned long h, partition &Q,
-                                   block_matrix &worlds_blocks, block_id &count);
+        // Memory used by the structures, in bytes
+        [[nodiscard]] static unsigned long get_memory_usage(const bpr_structures &structures);
 
-        static void refine(const state &s, unsigned long k, unsigned long h, partition &Q, const block_ptr &B,
-                           const relations &r_1, block_matrix &worlds_blocks, block_id &count);
+        // Groups the worlds by their block in the given level
+        static level_members calculate_members(const level_blocks &blocks);
 
-        static block calculate_preimages(const state &s, const block &B_, const relations &r_1, del::agent ag);
-
-        static void split(const state &s, unsigned long k, unsigned long h, partition &Q,
-                          const block &block_preimage, block_matrix &worlds_blocks, block_id &count);
+    private:
+        static void refinement_step_helper(const state &s, unsigned long k, bpr_structures &structures);
 
-        /*static std::pair<block_id, block_set> compact_block_ids(block_matrix &worlds_blocks);
+        static bool do_refinement_step(const state &s, unsigned long h, bpr_structures &structures);
 
-        static void build_signatures(const state &s, unsigned long long k, block_matrix &worlds_blocks);*/
+        static void save_level(unsigned long h, bpr_structures &structures);
 
         // Initialization of structures
         static bpr_structures init_structures(const state &s, unsigned long long k);
-
-        static void init_partitions_helper(const state &s, std::map<const label_id, block_ptr> &partition,
-                                           world_id w, block_matrix &worlds_blocks, block_id &count);
-
-        static relations init_preimage(const state &s);
-
-//        static void update_structures(search::node_ptr &n);
+        static void restore_structures(const state &s, bpr_structures &structures);
     };
 }
 
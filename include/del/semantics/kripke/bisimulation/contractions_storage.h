@@ -0,0 +1,68 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef DAEDALUS_CONTRACTIONS_STORAGE_H
+#define DAEDALUS_CONTRACTIONS_STORAGE_H
+
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "../states/states_types.h"
+
+namespace kripke {
+    // Interns full contractions, assigning the same id to bisimilar states. Full contractions are minimal, so bisimilar
+    // contractions are isomorphic, but their worlds may be numbered differently and we can not simply intern their
+    // rows. Instead, stored states are bucketed by their number of worlds and by a bounded fingerprint, and a state gets
+    // the id of a bisimilar state in its bucket, if any, or a fresh id. Ids start from 1, since 0 is the id of states
+    // that are not identified
+    class contractions_storage {
+    public:
+        contractions_storage() = default;
+
+        contractions_storage(const contractions_storage&) = delete;
+        contractions_storage& operator=(const contractions_storage&) = delete;
+
+        contractions_storage(contractions_storage&&) = delete;
+        contractions_storage& operator=(contractions_storage&&) = delete;
+
+        ~contractions_storage() = default;
+
+        // The id of the full contraction s
+        [[nodiscard]] state_id emplace(const state &s);
+
+    private:
+        using bucket = std::vector<std::pair<state_ptr, state_id>>;
+
+        // Bound of the fingerprints, so that identifying deep states does not take quadratic time
+        static constexpr unsigned long fingerprint_bound = 8;
+
+        std::unordered_map<std::size_t, bucket> m_buckets;
+        state_id m_count = 0;
+        std::mutex m_mutex;
+
+        [[nodiscard]] static state_ptr copy(const state &s);
+    };
+}
+
+#endif //DAEDALUS_CONTRACTIONS_STORAGE_H
@@ -0,0 +1,48 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef DAEDALUS_PARTITION_INTERSECTION_H
+#define DAEDALUS_PARTITION_INTERSECTION_H
+
+#include <optional>
+#include <utility>
+#include <vector>
+#include "../states/states_types.h"
+
+namespace kripke {
+    class state;
+
+    // Refinement for states whose relations are all stored as classes (see state::is_partitioned). The successors of
+    // a world are the worlds of its class, so the set of blocks reached by ag from w only depends on the ag-class of w.
+    // Each step calculates these sets once per class, and intersects the current partition with the partitions of the
+    // worlds by the sets of their classes, for each agent. A step takes O(|AG|*|W|*log|W|) time
+    class partition_intersection {
+    public:
+        // Returns the number of bisimulation classes of s, together with the class of each world of s, or nothing if
+        // the partition is not stable after max_steps steps
+        static std::optional<std::pair<world_id, std::vector<world_id>>> calculate_classes(const state &s, unsigned long max_steps);
+    };
+}
+
+#endif //DAEDALUS_PARTITION_INTERSECTION_H
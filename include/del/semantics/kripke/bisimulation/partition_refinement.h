@@ -26,59 +26,48 @@
 
 #include "../../../language/language.h"
 #include "bisimulation_types.h"
+#include "refinable_partition.h"
 #include "../states/states_types.h"
 #include "../../../../search/search_types.h"
+#include <vector>
 
 namespace kripke {
     class state;
 
+    struct pt_structures {
+        relations_preimage r_1;
+        refinable_partition Q;      // Its super blocks are the blocks of X
+
+        // Count records: edge_counts[e] is the record of count(ag, x, S), where e is an edge of agent ag from x to
+        // some world of the block S of X
+        pt_vector counts, edge_counts, free_counts;
+
+        // Scratch space of the current splitter B: its elements, their preimage and, for each x in it, count(ag, x, B)
+        // and the record of count(ag, x, S)
+        pt_vector B_, preimage, B_counts, x_counts;
+    };
+
     class partition_refinement {
     public:
         static std::pair<bool, state> contract(state &s);
         static bool contract(search::node_ptr &n);
 
+        // Returns the number of bisimulation classes of s, together with the class of each world of s
+        static std::pair<world_id, std::vector<world_id>> calculate_classes(const state &s);
+
     private:
         static std::pair<bool, state> contraction_helper(const state &s);
 
-        static state build_full_contraction(const state &s, const agent_relation &r, const agent_worlds_labels &labels,
-                                            q_partition &Q, const q_partition &Q_sinks);
-
-        static q_block_ptr get_smaller_block(x_block_ptr &S, compound_x_blocks_set &C);
-        static counts_vector calculate_block_counts(const agent_relation &r, const q_block_ptr &B);
-
-        static void refine(q_partition &Q, x_partition &X, compound_x_blocks_set &C, x_block_ptr &S, const q_block &B_,
-                           counts_vector &B_counts, const agent_relation &r_preimage, q_block_ptr_vector &worlds_blocks,
-                           const world_id preprocessed_worlds_no);
-
-        static void refine_helper(q_partition &Q, x_partition &X, compound_x_blocks_set &C, const block &block_preimage,
-                                  q_block_ptr_vector &worlds_blocks, const world_id preprocessed_worlds_no);
-
-        static void clean_and_update_partitions(q_partition &Q, x_partition &X, compound_x_blocks_set &C,
-                                                split_q_blocks_map &split_blocks);
-
-        static void update_counts(x_block_ptr &S, const q_block &B_, const counts_vector &B_counts,
-                                  const agent_relation &r_preimage);
-
-        static std::pair<agent_relation, agent_worlds_labels> build_preprocessed_state(const state &s);
-
-        static void init_data_structures(const state &s, const agent_relation &r, const agent_worlds_labels &labels,
-                                         q_partition &Q, q_partition &Q_sinks, x_partition &X, compound_x_blocks_set &C,
-                                         q_block_ptr_vector &worlds_blocks, agent_relation &r_preimage,
-                                         const world_id preprocessed_worlds_no);
-
-        static void init_partitions(const state &s, const agent_relation &r, const agent_worlds_labels &labels,
-                                    q_partition &Q, q_partition &Q_sinks, x_partition &X, compound_x_blocks_set &C,
-                                    q_block_ptr_vector &worlds_blocks, const world_id preprocessed_worlds_no);
-
-        static bool is_sink(const state &s, world_id w);
+        static state build_full_contraction(const state &s, world_id worlds_number, const std::vector<world_id> &classes);
 
-        template<class T>
-        static void init_partitions_helper(std::map<T, q_block> &partition, world_id w, T key, const world_id preprocessed_worlds_no);
+        static pt_structures init_structures(const state &s);
+        static refinable_partition init_partition(const state &s);
+        static void init_counts(const state &s, pt_structures &pt);
 
-        static void init_preimage(const agent_relation &r, agent_relation &r_preimage, const world_id preprocessed_worlds_no);
-        static void init_counts(const agent_relation &r, x_block_ptr &S);
+        static void calculate_partition(pt_structures &pt);
+        static void refine(pt_structures &pt, del::agent ag);
 
-        static bool is_compound(const x_block_ptr &x);
+        static pt_id new_count(pt_structures &pt, pt_id count);
     };
 }
 
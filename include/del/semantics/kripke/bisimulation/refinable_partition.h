@@ -0,0 +1,113 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef DAEDALUS_REFINABLE_PARTITION_H
+#define DAEDALUS_REFINABLE_PARTITION_H
+
+#include "bisimulation_types.h"
+#include "../states/states_types.h"
+
+namespace kripke {
+    class state;
+
+    // Preimages of the relations of a state in CSR format: the worlds x such that x R(ag) y are stored in
+    // sources[offsets[y*|AG|+ag], offsets[y*|AG|+ag+1]). Each edge is identified by its position in 'sources'
+    struct relations_preimage {
+        del::agent agents_number = 0;
+        pt_vector offsets, sources;
+
+        relations_preimage() = default;
+        explicit relations_preimage(const state &s);
+
+        [[nodiscard]] pt_id begin(const pt_id y, const del::agent ag) const { return offsets[y * agents_number + ag];     }
+        [[nodiscard]] pt_id end  (const pt_id y, const del::agent ag) const { return offsets[y * agents_number + ag + 1]; }
+
+        [[nodiscard]] bool empty() const { return offsets.empty(); }
+        [[nodiscard]] unsigned long get_memory_usage() const;
+    };
+
+    // Partition of {0, ..., n-1} with integer block ids, supporting splits in time linear in the number of marked
+    // elements. Elements are stored in an array permuted so that each block B is the contiguous range
+    // [first(B), end(B)), and the marked elements of B are moved to its front, i.e., to [first(B), mid(B)).
+    // Blocks are grouped into super blocks (the blocks of the partition X of Paige and Tarjan) by intrusive doubly
+    // linked lists, and the compound super blocks are kept in a stack
+    class refinable_partition {
+    public:
+        static constexpr pt_id null_id = static_cast<pt_id>(-1);
+
+        refinable_partition() = default;
+
+        // Builds the partition where element x is in block elements_blocks[x]. Block ids must be in [0, blocks_number)
+        // and all blocks must be nonempty. Initially, all blocks belong to the same super block
+        refinable_partition(const pt_vector &elements_blocks, pt_id blocks_number);
+
+        refinable_partition(const refinable_partition&) = default;
+        refinable_partition& operator=(const refinable_partition&) = default;
+
+        refinable_partition(refinable_partition&&) = default;
+        refinable_partition& operator=(refinable_partition&&) = default;
+
+        ~refinable_partition() = default;
+
+        [[nodiscard]] pt_id get_blocks_number() const { return m_first.size(); }
+        [[nodiscard]] pt_id get_block(const pt_id x) const { return m_blocks[x]; }
+        [[nodiscard]] const pt_vector &get_blocks() const { return m_blocks; }
+
+        [[nodiscard]] const pt_vector &get_elements() const { return m_elements; }
+        [[nodiscard]] pt_id get_first(const pt_id B) const { return m_first[B]; }
+        [[nodiscard]] pt_id get_end  (const pt_id B) const { return m_end[B];   }
+        [[nodiscard]] pt_id get_block_size(const pt_id B) const { return m_end[B] - m_first[B]; }
+
+        // Marks x, if it is not already marked
+        void mark(pt_id x);
+
+        // Splits each block B containing some marked element into the marked part (a new block in the same super
+        // block of B) and the unmarked one (which keeps the id of B). Blocks whose elements are all marked are not
+        // split. Afterwards, no element is marked
+        void split();
+
+        [[nodiscard]] pt_id get_super_block(const pt_id B) const { return m_super_blocks[B]; }
+        [[nodiscard]] bool has_compound_super_blocks() const { return not m_compound_super_blocks.empty(); }
+
+        // Removes some compound super block from the stack of compound super blocks and returns it
+        pt_id pop_compound_super_block();
+
+        // Memory used by the partition, in bytes
+        [[nodiscard]] unsigned long get_memory_usage() const;
+
+        // Removes the smaller of the first two blocks of the compound super block S and puts it in a new simple super
+        // block. If S is still compound, it is pushed back into the stack of compound super blocks. Returns the block
+        pt_id extract_smaller_block(pt_id S);
+
+    private:
+        pt_vector m_elements, m_locations, m_blocks;
+        pt_vector m_first, m_mid, m_end, m_super_blocks;
+        pt_vector m_next_blocks, m_prev_blocks;         // Doubly linked list of the blocks in the same super block
+        pt_vector m_touched_blocks;                     // Blocks containing marked elements
+
+        pt_vector m_super_blocks_first, m_super_blocks_sizes, m_compound_super_blocks;
+    };
+}
+
+#endif //DAEDALUS_REFINABLE_PARTITION_H
@@ -27,20 +27,31 @@
 #include "states/state.h"
 #include "states/states_types.h"
 #include "../../formulas/all_formulas.h"
+#include <unordered_map>
+#include <utility>
+#include <boost/functional/hash.hpp>
 
 namespace kripke {
     class model_checker {
     public:
+        // The truth of box and diamond formulas in a world only depends on its row, so it can be shared among the
+        // worlds of the same row (e.g., the worlds of an equivalence class). A memo is only valid for a single state
+        using formula_row_pair = std::pair<const del::formula *, row_id>;
+        using rows_memo        = std::unordered_map<formula_row_pair, bool, boost::hash<formula_row_pair>>;
+
         static bool holds_in(const state &s, world_id w, const del::formula &f, const del::label_storage &l_storage);
+        static bool holds_in(const state &s, world_id w, const del::formula &f, const del::label_storage &l_storage,
+                             rows_memo &memo);
 
     private:
+        static bool holds_in(const state &s, world_id w, const del::formula &f, const del::label_storage &l_storage, rows_memo *memo);
         static bool holds_in(const state &s, world_id w, const del::atom_formula &f, const del::label_storage &l_storage);
-        static bool holds_in(const state &s, world_id w, const del::not_formula &f, const del::label_storage &l_storage);
-        static bool holds_in(const state &s, world_id w, const del::and_formula &f, const del::label_storage &l_storage);
-        static bool holds_in(const state &s, world_id w, const del::or_formula &f, const del::label_storage &l_storage);
-        static bool holds_in(const state &s, world_id w, const del::imply_formula &f, const del::label_storage &l_storage);
-        static bool holds_in(const state &s, world_id w, const del::box_formula &f, const del::label_storage &l_storage);
-        static bool holds_in(const state &s, world_id w, const del::diamond_formula &f, const del::label_storage &l_storage);
+        static bool holds_in(const state &s, world_id w, const del::not_formula &f, const del::label_storage &l_storage, rows_memo *memo);
+        static bool holds_in(const state &s, world_id w, const del::and_formula &f, const del::label_storage &l_storage, rows_memo *memo);
+        static bool holds_in(const state &s, world_id w, const del::or_formula &f, const del::label_storage &l_storage, rows_memo *memo);
+        static bool holds_in(const state &s, world_id w, const del::imply_formula &f, const del::label_storage &l_storage, rows_memo *memo);
+        static bool holds_in(const state &s, world_id w, const del::box_formula &f, const del::label_storage &l_storage, rows_memo *memo);
+        static bool holds_in(const state &s, world_id w, const del::diamond_formula &f, const del::label_storage &l_storage, rows_memo *memo);
     };
 }
 
@@ -29,6 +29,7 @@
 #include <ostream>
 #include <vector>
 #include "states_types.h"
+#include "worlds_range.h"
 #include "../../../formulas/formula.h"
 #include "../../../language/language.h"
 #include "../../../../utils/storage_types.h"
@@ -39,6 +40,11 @@ namespace kripke {
         state(del::language_ptr language, unsigned long long worlds_number, relations relations,
               label_vector valuation, world_bitset designated_worlds, unsigned long long state_id = 0);
 
+        // Builds the state from shared rows. Equal rows of the same agent are merged, so the given ones need not be distinct.
+        // If no rows are given for an agent, then its relation is an equivalence and rows_ids[ag][w] is the class of w
+        state(del::language_ptr language, unsigned long long worlds_number, relations_rows rows, relations_rows_ids rows_ids,
+              label_vector valuation, world_bitset designated_worlds, unsigned long long state_id = 0);
+
         state(const state&) = delete;
         state& operator=(const state&) = delete;
 
@@ -48,14 +54,29 @@ namespace kripke {
         ~state() = default;
 
         [[nodiscard]] unsigned long long get_worlds_number() const;
-        [[nodiscard]] const world_bitset &get_agent_possible_worlds(del::agent ag, world_id w) const;
+        [[nodiscard]] worlds_range get_agent_possible_worlds(del::agent ag, world_id w) const;
         [[nodiscard]] bool has_edge(del::agent ag, world_id w, world_id v) const;
+
+        // Worlds with the same ag-successors have the same ag-row. Computations that only depend on the successors of
+        // a world can be done once per row
+        [[nodiscard]] row_id get_agent_row_id(del::agent ag, world_id w) const;
+        [[nodiscard]] unsigned long long get_agent_rows_number(del::agent ag) const;
+        [[nodiscard]] worlds_range get_agent_row(del::agent ag, row_id r) const;
+
+        // Transitive and euclidean relations are stored as classes, which are their rows. Then the row id of a world is
+        // its class id, and the rows of the agent are pairwise disjoint
+        [[nodiscard]] bool has_classes(del::agent ag) const;
+        [[nodiscard]] bool is_equivalence(del::agent ag) const;
+        // Whether the relations of all agents are stored as classes
+        [[nodiscard]] bool is_partitioned() const;
         [[nodiscard]] const label_id &get_label_id(world_id w) const;
         [[nodiscard]] const world_bitset &get_designated_worlds() const;
         [[nodiscard]] unsigned long long get_id() const;
+        void set_id(unsigned long long state_id);
         [[nodiscard]] bool is_designated(world_id w) const;
 
         [[nodiscard]] del::language_ptr get_language() const;
+        // Distance of w from the designated worlds, or ULONG_MAX if w is not reachable from them
         [[nodiscard]] unsigned long get_depth(world_id w) const;
         [[nodiscard]] unsigned long get_max_depth() const;
         [[nodiscard]] bool satisfies(const del::formula_ptr &f, const del::label_storage &l_storage) const;
@@ -70,7 +91,9 @@ namespace kripke {
     private:
         del::language_ptr m_language;
         unsigned long long m_worlds_number;
-        relations m_relations;
+        relations_rows m_rows;
+        relations_rows_ids m_rows_ids;
+        std::vector<agent_classes> m_classes;       // Empty for the agents whose relation is stored as rows
         label_vector m_labels;
         world_bitset m_designated_worlds;
         unsigned long long m_state_id;
@@ -78,6 +101,9 @@ namespace kripke {
         unsigned long m_max_depth;
 
         void calculate_worlds_depth();
+        void share_rows();
+        void build_classes();
+        void build_classes(del::agent ag, unsigned long long classes_number);
     };
 }
 
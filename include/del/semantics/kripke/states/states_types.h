@@ -48,6 +48,23 @@ namespace kripke {
     using agent_relation    = std::vector<world_bitset>;
     using relations         = std::vector<agent_relation>;
 
+    // Relations where worlds with the same successors share a single row: rows[ag] holds the distinct successor sets
+    // of agent ag, and rows_ids[ag][w] is the index of the successor set of w in rows[ag]
+    using row_id            = unsigned long long;
+    using agent_rows_ids    = std::vector<row_id>;
+    using relations_rows    = std::vector<agent_relation>;
+    using relations_rows_ids = std::vector<agent_rows_ids>;
+
+    // Transitive and euclidean relations (e.g. S5 and KD45 ones) are stored as classes instead of rows: all worlds
+    // of a row are in the same row, so rows are disjoint. The worlds of class c are worlds[offsets[c], offsets[c+1]),
+    // and is_member[w] iff w is in its own class (always true for equivalences). This takes O(|W|) memory per agent
+    struct agent_classes {
+        std::vector<world_id> worlds;
+        std::vector<unsigned long long> offsets;
+        boost::dynamic_bitset<> is_member;
+        bool is_equivalence = false;
+    };
+
     using label_id          = unsigned long long;
     using label_vector      = std::vector<label_id>;
 }
@@ -0,0 +1,111 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef DAEDALUS_WORLDS_RANGE_H
+#define DAEDALUS_WORLDS_RANGE_H
+
+#include <cstddef>
+#include <iterator>
+#include "states_types.h"
+
+namespace kripke {
+    // Read-only view of the worlds of a row of a state, which is either stored as a bitset or as a class
+    class worlds_range {
+    public:
+        class iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = world_id;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = const world_id *;
+            using reference         = const world_id &;
+
+            iterator() = default;
+            explicit iterator(world_bitset::iterator it) : m_it{it} {}
+            explicit iterator(const world_id *ptr) : m_ptr{ptr}, m_is_class{true} {}
+
+            reference operator*() const { return m_is_class ? *m_ptr : *m_it; }
+
+            iterator &operator++() {
+                if (m_is_class) ++m_ptr; else ++m_it;
+                return *this;
+            }
+
+            iterator operator++(int) {
+                iterator it = *this;
+                ++*this;
+                return it;
+            }
+
+            bool operator==(const iterator &rhs) const { return m_is_class ? m_ptr == rhs.m_ptr : m_it == rhs.m_it; }
+            bool operator!=(const iterator &rhs) const { return not (*this == rhs); }
+
+        private:
+            world_bitset::iterator m_it;
+            const world_id *m_ptr = nullptr;
+            bool m_is_class = false;
+        };
+
+        explicit worlds_range(const world_bitset &row) : m_row{&row} {}
+
+        worlds_range(const agent_classes &classes, const agent_rows_ids &classes_ids, const row_id c) :
+                m_classes{&classes},
+                m_classes_ids{&classes_ids},
+                m_class{c} {}
+
+        [[nodiscard]] iterator begin() const {
+            return m_row ? iterator{m_row->begin()} : iterator{m_classes->worlds.data() + m_classes->offsets[m_class]};
+        }
+
+        [[nodiscard]] iterator end() const {
+            return m_row ? iterator{m_row->end()} : iterator{m_classes->worlds.data() + m_classes->offsets[m_class+1]};
+        }
+
+        [[nodiscard]] std::size_t size() const {
+            return m_row ? m_row->size() : m_classes->offsets[m_class+1] - m_classes->offsets[m_class];
+        }
+
+        [[nodiscard]] bool empty() const { return size() == 0; }
+
+        bool operator[](const world_id v) const {
+            return m_row ? (*m_row)[v] : (*m_classes_ids)[v] == m_class and m_classes->is_member[v];
+        }
+
+        [[nodiscard]] world_bitset to_bitset(const unsigned long long worlds_number) const {
+            world_bitset row(worlds_number);
+
+            for (const world_id v : *this)
+                row.push_back(v);
+            return row;
+        }
+
+    private:
+        const world_bitset *m_row = nullptr;
+        const agent_classes *m_classes = nullptr;
+        const agent_rows_ids *m_classes_ids = nullptr;
+        row_id m_class = 0;
+    };
+}
+
+#endif //DAEDALUS_WORLDS_RANGE_H
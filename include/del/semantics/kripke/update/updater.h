@@ -30,7 +30,9 @@
 #include "../../../../utils/storage_types.h"
 #include "../states/state.h"
 #include "../actions/action.h"
+#include "../model_checker.h"
 #include "boost/dynamic_bitset.hpp"
+#include <boost/functional/hash.hpp>
 #include "../bisimulation/bisimulation_types.h"
 #include "../bisimulation/bounded_bisimulation_types.h"
 
@@ -55,24 +57,44 @@ namespace kripke {
                                     unsigned long k = 0);
 
     private:
-        using updated_world_pair       = std::pair<const updated_world, const updated_world>;
         using updated_worlds_map       = std::unordered_map<updated_world, world_id>;
-        using updated_world_pair_deque = std::deque<updated_world_pair>;
-        using updated_edges_vector     = std::vector<updated_world_pair_deque>;
 
-        static bool is_applicable_world(const state &s, const action &a, world_id wd, const del::label_storage &l_storage);
+        // The ag-successors of (w, e) only depend on the ag-rows of w and e, so they are calculated once per such
+        // pair. rows[ag] holds the successors of each pair, and rows_ids[ag][w_] is the row of the updated world w_.
+        // When both relations are equivalences, this is the partition of the product by pairs of classes, and the class
+        // of (w, e) is the pair (class of w, class of e). Then we only store the id of the pair, without its worlds
+        using updated_row              = std::vector<updated_world>;
+        using updated_rows             = std::vector<std::vector<updated_row>>;
+        using rows_pair                = std::pair<row_id, row_id>;
+        using updated_rows_map         = std::unordered_map<rows_pair, row_id, boost::hash<rows_pair>>;
+
+        struct formulas_memo {
+            std::vector<uint8_t> truths;        // Truth of (w, f) at w * |F| + f: 0 unknown, 1 false, 2 true
+            model_checker::rows_memo rows;      // Truth of the modal subformulas in the rows of s
+        };
+
+        static bool is_applicable_world(const state &s, const action &a, world_id wd, const del::label_storage &l_storage,
+                                        model_checker::rows_memo &memo);
+
+        static bool holds_in(const state &s, world_id w, const action &a, formula_id f,
+                             const del::label_storage &l_storage, formulas_memo &memo);
 
         static std::pair<world_id, world_bitset> calculate_worlds(const state &s, const action &a, updated_worlds_map &w_map,
-                                                                  updated_edges_vector &r_map, del::label_storage &l_storage);
+                                                                  updated_rows &rows, relations_rows_ids &rows_ids,
+                                                                  del::label_storage &l_storage, formulas_memo &memo);
 
-        static relations calculate_relations(const state &s, const action &a, world_id worlds_number,
-                                             const updated_worlds_map &w_map, const updated_edges_vector &r_map);
+        static relations_rows calculate_relations(const state &s, const action &a, world_id worlds_number,
+                                                  const updated_worlds_map &w_map, const updated_rows &rows);
 
         static label_vector calculate_labels(const state &s, const action &a, world_id worlds_number,
-                                             const updated_worlds_map &w_map, del::label_storage &l_storage);
+                                             const updated_worlds_map &w_map, del::label_storage &l_storage,
+                                             formulas_memo &memo);
 
-        static label_id update_world(const state &s, const world_id &w, const action &a, const event_id &e,
+        static label_id update_label(const state &s, const world_id &w, const action &a, const event_id &e,
                                      del::label_storage &l_storage);
+
+        static label_id update_world(const state &s, const world_id &w, const action &a, const event_id &e,
+                                     del::label_storage &l_storage, formulas_memo *memo = nullptr);
     };
 }
 
@@ -0,0 +1,52 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef DAEDALUS_SYMBOLIC_MODEL_CHECKER_H
+#define DAEDALUS_SYMBOLIC_MODEL_CHECKER_H
+
+#include "states/state.h"
+#include "states/states_types.h"
+#include "../../formulas/all_formulas.h"
+
+namespace symbolic {
+    class model_checker {
+    public:
+        // The BDD of the worlds of s where f holds
+        static bdd calculate(const state &s, const del::formula &f);
+
+    private:
+        static bdd calculate(const state &s, const del::atom_formula &f);
+        static bdd calculate(const state &s, const del::not_formula &f);
+        static bdd calculate(const state &s, const del::and_formula &f);
+        static bdd calculate(const state &s, const del::or_formula &f);
+        static bdd calculate(const state &s, const del::imply_formula &f);
+        static bdd calculate(const state &s, const del::box_formula &f);
+        static bdd calculate(const state &s, const del::diamond_formula &f);
+
+        // The BDD of the worlds of s that have an ag-successor in the given worlds
+        static bdd calculate_preimage(const state &s, del::agent ag, bdd worlds);
+    };
+}
+
+#endif //DAEDALUS_SYMBOLIC_MODEL_CHECKER_H
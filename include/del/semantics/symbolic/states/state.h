@@ -0,0 +1,81 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef DAEDALUS_SYMBOLIC_STATE_H
+#define DAEDALUS_SYMBOLIC_STATE_H
+
+#include <vector>
+#include "states_types.h"
+#include "../../../formulas/formula.h"
+#include "../../../language/language.h"
+
+namespace symbolic {
+    // Symbolic representation of a Kripke state. The vocabulary of the state consists of the atoms of the language,
+    // followed by auxiliary variables that distinguish worlds with the same valuation. The worlds are the assignments
+    // of the vocabulary that satisfy the BDD of the worlds, and the relation of each agent is a BDD over the
+    // vocabulary (source world) and its primed copy (target world). Relations only contain pairs of worlds
+    class state {
+    public:
+        state(del::language_ptr language, bdd_manager_ptr manager, unsigned long variables_number, bdd worlds,
+              relations relations, bdd designated_worlds);
+
+        state(const state&) = delete;
+        state& operator=(const state&) = delete;
+
+        state(state&&) = default;
+        state& operator=(state&&) = default;
+
+        ~state() = default;
+
+        // Builds the knowledge structure whose worlds are the valuations that satisfy the (propositional) law, where each
+        // agent cannot distinguish the worlds that agree on its observable atoms
+        static state build_knowledge_structure(const del::language_ptr &language, const bdd_manager_ptr &manager,
+                                               const del::formula &law, const std::vector<std::vector<del::atom>> &observables,
+                                               const del::formula &designated);
+
+        [[nodiscard]] del::language_ptr get_language() const;
+        [[nodiscard]] const bdd_manager_ptr &get_manager() const;
+        [[nodiscard]] unsigned long get_variables_number() const;
+        [[nodiscard]] bdd get_worlds() const;
+        [[nodiscard]] bdd get_agent_relation(del::agent ag) const;
+        [[nodiscard]] bdd get_designated_worlds() const;
+
+        [[nodiscard]] double get_worlds_number() const;
+        // The BDD variables of the vocabulary and of its primed copy
+        [[nodiscard]] variables get_variables() const;
+        [[nodiscard]] variables get_primed_variables() const;
+
+        [[nodiscard]] bool satisfies(const del::formula_ptr &f) const;
+
+    private:
+        del::language_ptr m_language;
+        bdd_manager_ptr m_manager;
+        unsigned long m_variables_number;
+        bdd m_worlds;
+        relations m_relations;
+        bdd m_designated_worlds;
+    };
+}
+
+#endif //DAEDALUS_SYMBOLIC_STATE_H
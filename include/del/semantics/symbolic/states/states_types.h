@@ -0,0 +1,58 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef DAEDALUS_SYMBOLIC_STATES_TYPES_H
+#define DAEDALUS_SYMBOLIC_STATES_TYPES_H
+
+#include <deque>
+#include <memory>
+#include <vector>
+#include "../../../../utils/bdd_manager.h"
+
+namespace symbolic {
+    class state;
+    using state_ptr   = std::shared_ptr<state>;
+    using state_deque = std::deque<state_ptr>;
+
+    using bdd          = bdd_manager::bdd;
+    using variable     = bdd_manager::variable;
+    using variables    = std::vector<variable>;
+    using relations    = std::vector<bdd>;
+
+    // Each variable x of a state has a primed copy, used to encode the target worlds of the relations. The BDD variables
+    // of x and of its copy are adjacent, so that priming a BDD preserves the order of its variables
+    inline variable unprimed(const variable x) { return 2 * x; }
+    inline variable primed(const variable x)   { return 2 * x + 1; }
+
+    // Renaming of the variables 0, ..., variables_number - 1 to their primed copies
+    inline variables get_priming(const unsigned long variables_number) {
+        variables priming(2 * variables_number);
+
+        for (variable x = 0; x < variables_number; ++x)
+            priming[unprimed(x)] = priming[primed(x)] = primed(x);
+        return priming;
+    }
+}
+
+#endif //DAEDALUS_SYMBOLIC_STATES_TYPES_H
@@ -0,0 +1,48 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef DAEDALUS_SYMBOLIC_UTILS_H
+#define DAEDALUS_SYMBOLIC_UTILS_H
+
+#include "states/state.h"
+#include "../kripke/states/state.h"
+#include "../../../utils/storage_types.h"
+
+namespace symbolic {
+    class symbolic_utils {
+    public:
+        // Encodes an explicit state. Worlds with the same label are distinguished by auxiliary variables, which hold the
+        // index of each world among those with its label
+        static state convert(const kripke::state &s, const del::label_storage &l_storage, const bdd_manager_ptr &manager);
+
+        // Returns a state bisimilar to s. The worlds that are not reachable from the designated ones are dropped, and the
+        // auxiliary variables are quantified away whenever this maps worlds to bisimilar ones (e.g. if worlds with the
+        // same valuation have successors with the same valuations). The remaining auxiliary variables are renamed to
+        // the first ones. If all of them are removed, the result is the valuation quotient of s over the atoms, so that
+        // bisimilar states that are reduced this way have the same BDDs
+        static state reduce(const state &s);
+    };
+}
+
+#endif //DAEDALUS_SYMBOLIC_UTILS_H
@@ -0,0 +1,50 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef DAEDALUS_SYMBOLIC_UPDATER_H
+#define DAEDALUS_SYMBOLIC_UPDATER_H
+
+#include <vector>
+#include "../states/state.h"
+#include "../../kripke/actions/action.h"
+
+namespace symbolic {
+    // Symbolic product update with explicit actions. The updated world (w, e) is encoded by the variables of w, by
+    // the bits of e in new event variables, and by the atoms changed by the postconditions of e. Since the old values
+    // of the changed atoms still distinguish the updated worlds, they are moved to new copy variables. Hence, the
+    // vocabulary grows by ceil(log2 |E|) variables, plus one for each atom changed by the action
+    class updater {
+    public:
+        static bool is_applicable(const state &s, const kripke::action &a);
+        static state product_update(const state &s, const kripke::action &a);
+
+    private:
+        // The atoms with a postcondition in some ontic event of a, sorted
+        static std::vector<del::atom> calculate_changed_atoms(const kripke::action &a);
+
+        static unsigned long calculate_event_bits(const kripke::action &a);
+    };
+}
+
+#endif //DAEDALUS_SYMBOLIC_UPDATER_H
@@ -0,0 +1,83 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef DAEDALUS_ACTION_INDEX_H
+#define DAEDALUS_ACTION_INDEX_H
+
+#include <unordered_map>
+#include <vector>
+#include "boost/dynamic_bitset.hpp"
+#include "../del/semantics/kripke/states/state.h"
+#include "../del/semantics/kripke/actions/action.h"
+#include "../del/formulas/formula.h"
+#include "../utils/storage_types.h"
+
+namespace search {
+    // Index of the actions of a planning task by the propositional skeleton of their preconditions, i.e., the atoms that
+    // must be true (resp. false) in a world for a designated event to be applicable there. Actions whose skeletons are not
+    // matched by the labels of all designated worlds of a state are certainly not applicable in that state
+    class action_index {
+    public:
+        action_index() = default;
+        action_index(const kripke::action_deque &actions, del::atom atoms_number);
+
+        action_index(const action_index&) = delete;
+        action_index& operator=(const action_index&) = delete;
+
+        action_index(action_index&&) = default;
+        action_index& operator=(action_index&&) = default;
+
+        ~action_index() = default;
+
+        // Returns the set of (positions of the) actions that pass the propositional prefilter in s
+        [[nodiscard]] boost::dynamic_bitset<> get_candidates(const kripke::state &s, const del::label_storage &l_storage) const;
+
+        // Returns false only if a is indexed and it is not among the given candidates
+        [[nodiscard]] bool is_candidate(const boost::dynamic_bitset<> &candidates, const kripke::action &a) const;
+
+    private:
+        struct skeleton {
+            boost::dynamic_bitset<> m_positive, m_negative;
+            bool m_is_unsatisfiable;
+        };
+
+        using events_skeletons = std::vector<skeleton>;
+
+        del::atom m_atoms_number = 0;
+        std::vector<events_skeletons> m_skeletons;                  // Skeletons of the designated events of each action
+        std::unordered_map<const kripke::action *, std::size_t> m_positions;
+
+        mutable const del::label_storage *m_memo_storage = nullptr;           // Candidate actions of the labels met so far
+        mutable std::unordered_map<kripke::label_id, boost::dynamic_bitset<>> m_labels_memo;
+
+        [[nodiscard]] const boost::dynamic_bitset<> &get_label_candidates(kripke::label_id l, const del::label_storage &l_storage) const;
+
+        [[nodiscard]] skeleton calculate_skeleton(const del::formula &f, bool positive) const;
+        [[nodiscard]] skeleton make_skeleton(bool is_unsatisfiable = false) const;
+        static void conjoin(skeleton &s1, const skeleton &s2);
+        static void disjoin(skeleton &s1, const skeleton &s2);
+    };
+}
+
+#endif //DAEDALUS_ACTION_INDEX_H
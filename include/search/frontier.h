@@ -25,14 +25,22 @@
 
 #include "search_space.h"
 #include "search_types.h"
+#include "strategies.h"
+#include "heuristics.h"
 #include <deque>
 #include <map>
+#include <utility>
 
 namespace search {
     class frontier {
     public:
         frontier() = default;
 
+        // The heuristic is used by the search to give the heuristic values of the nodes, before they are pushed
+        frontier(search_order order, heuristic_ptr heuristic) :
+                m_order{order},
+                m_heuristic{std::move(heuristic)} {}
+
         frontier(const frontier&) = delete;
         frontier& operator=(const frontier&) = delete;
 
@@ -46,13 +54,18 @@ namespace search {
         }
 
         void push(const node_ptr &n) {
-            m_frontiers[n->get_graph_depth()].push_back(n);
+            m_frontiers[get_priority(n)].push_back(n);
         }
 
         [[nodiscard]] const node_ptr &front() const {
             return m_frontiers.begin()->second.front();
         }
 
+        // The nodes with the highest priority (with breadth-first order, the nodes with the smallest graph depth)
+        [[nodiscard]] const node_deque &front_layer() const {
+            return m_frontiers.begin()->second;
+        }
+
         void pop_front() {
             auto &[depth, deq] = *m_frontiers.begin();
             deq.pop_front();
@@ -72,8 +85,28 @@ namespace search {
         [[nodiscard]] auto begin() const { return m_frontiers.begin(); }
         [[nodiscard]] auto end()   const { return m_frontiers.end();   }
 
+        [[nodiscard]] search_order get_order() const { return m_order; }
+        [[nodiscard]] const heuristic_ptr &get_heuristic() const { return m_heuristic; }
+
+        // An empty frontier with the same order
+        [[nodiscard]] frontier make_empty() const { return frontier{m_order, m_heuristic}; }
+
     private:
-        std::map<unsigned long, node_deque> m_frontiers;
+        std::map<unsigned long, node_deque> m_frontiers;        // Smaller keys have higher priority
+        search_order m_order = search_order::breadth_first;
+        heuristic_ptr m_heuristic;
+
+        [[nodiscard]] unsigned long get_priority(const node_ptr &n) const {
+            switch (m_order) {
+                case search_order::breadth_first:
+                    return n->get_graph_depth();
+                case search_order::greedy_best_first:
+                    return n->get_heuristic_value();
+                case search_order::astar:
+                    return n->get_graph_depth() + n->get_heuristic_value();
+            }
+            return n->get_graph_depth();
+        }
     };
 }
 
@@ -0,0 +1,115 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef DAEDALUS_HEURISTICS_H
+#define DAEDALUS_HEURISTICS_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "boost/dynamic_bitset.hpp"
+#include "../del/semantics/kripke/states/state.h"
+#include "../del/formulas/formula.h"
+#include "../utils/storage_types.h"
+
+namespace search {
+    class planning_task;
+
+    enum class heuristic_type : uint8_t {
+        goal_count,
+        relaxed_plan
+    };
+
+    class heuristic;
+    using heuristic_ptr = std::shared_ptr<heuristic>;
+
+    // Estimate of the number of actions needed to reach the goal of a planning task from a state. Heuristics are
+    // evaluated by the threads of the parallel search, so evaluating a state must not modify the heuristic. Estimates
+    // may exceed the actual number of actions (heuristics are not admissible)
+    class heuristic {
+    public:
+        heuristic() = default;
+
+        heuristic(const heuristic&) = delete;
+        heuristic& operator=(const heuristic&) = delete;
+
+        heuristic(heuristic&&) = default;
+        heuristic& operator=(heuristic&&) = default;
+
+        virtual ~heuristic() = default;
+
+        [[nodiscard]] virtual unsigned long evaluate(const kripke::state &s, const del::label_storage &l_storage) const = 0;
+
+        [[nodiscard]] static heuristic_ptr build(heuristic_type type, const planning_task &task);
+    };
+
+    // Number of conjuncts of the goal that do not hold in all designated worlds. It is zero exactly in the goal states.
+    // It is not admissible, since a single action may make several conjuncts true
+    class goal_count_heuristic : public heuristic {
+    public:
+        explicit goal_count_heuristic(const del::formula_ptr &goal);
+
+        [[nodiscard]] unsigned long evaluate(const kripke::state &s, const del::label_storage &l_storage) const override;
+
+    private:
+        del::formula_deque m_conjuncts;
+
+        void add_conjuncts(const del::formula_ptr &f);
+    };
+
+    // Delete relaxation of the task over literals (an atom and its truth value). The goal needs some literals to be true
+    // in some world of a state, and an event can make its effects true in some world if its precondition literals are.
+    // Starting from the literals of the worlds of a state, events are applied in layers, without ever losing literals,
+    // and the estimate is the sum of the layers where the literals of the goal first appear. As in the additive
+    // heuristic of classical planning, the sum is not admissible
+    class relaxed_plan_heuristic : public heuristic {
+    public:
+        explicit relaxed_plan_heuristic(const planning_task &task);
+
+        [[nodiscard]] unsigned long evaluate(const kripke::state &s, const del::label_storage &l_storage) const override;
+
+    private:
+        struct literals {
+            boost::dynamic_bitset<> m_positive, m_negative;
+            bool m_is_unsatisfiable;
+        };
+
+        struct relaxed_event {
+            literals m_precondition, m_effects;
+        };
+
+        del::atom m_atoms_number;
+        literals m_goal;
+        std::vector<relaxed_event> m_events;
+
+        // Literals that f (resp. not f, if positive is false) needs to be true in some world, assuming that all agents
+        // consider some world possible
+        [[nodiscard]] literals calculate_literals(const del::formula &f, bool positive) const;
+        [[nodiscard]] literals make_literals(bool is_unsatisfiable = false) const;
+        static void conjoin(literals &ls1, const literals &ls2);
+        static void disjoin(literals &ls1, const literals &ls2);
+    };
+}
+
+#endif //DAEDALUS_HEURISTICS_H
@@ -24,9 +24,11 @@
 #ifndef DAEDALUS_PLANNER_H
 #define DAEDALUS_PLANNER_H
 
+#include <deque>
 #include <functional>
 #include <memory>
 #include <queue>
+#include <vector>
 #include "planning_task.h"
 #include "search_space.h"
 #include "../del/semantics/kripke/states/state.h"
@@ -36,31 +38,53 @@
 #include "search_types.h"
 #include "strategies.h"
 #include "frontier.h"
+#include "heuristics.h"
 
 namespace search {
     class planner {
     public:
+        // Memory budget for the refinement structures kept by the nodes of the iterative bounded search (1 GiB)
+        static constexpr unsigned long long max_bpr_structures_memory = 1ULL << 30;
+
         static std::pair<node_deque, statistics>
         search(const planning_task &task, strategy strategy, contraction_type contraction_type,
-               del::storages_handler_ptr handler, const daedalus::tester::printer_ptr &printer = nullptr);
+               del::storages_handler_ptr handler, const daedalus::tester::printer_ptr &printer = nullptr,
+               parallelism parallelism = parallelism::layers_and_nodes, search_order order = search_order::breadth_first,
+               heuristic_type heuristic_type = heuristic_type::goal_count);
 
         static void print_plan(const node_deque &path);
 
     private:
-        static node_deque unbounded_search(const planning_task &task, statistics &stats, visited_states &visited_states,
+        // Product update of the state of a node with an action and its contraction. This is the part of the expansion of
+        // a node that does not depend on the visited states, so the children of a search layer can be calculated in
+        // parallel and then added to the search space in the same order as in the sequential search
+        struct child_update {
+            bool m_is_calculated = false, m_is_within_bound = false, m_is_applicable = false;
+            bool m_is_bisim = false, m_is_resumable = false, m_is_goal_checked = false, m_satisfies_goal = false;
+            unsigned long m_bound = 0, m_heuristic_value = 0;
+            kripke::state_ptr m_original_state, m_state;
+            kripke::bpr_structures m_structures;
+        };
+
+        // The (empty) frontier of the previous iteration gives the order of the search
+        static node_deque unbounded_search(const planning_task &task, parallelism parallelism, statistics &stats,
+                         frontier &previous_iter_frontier, visited_states &visited_states,
                          del::storages_handler_ptr handler, const daedalus::tester::printer_ptr &printer);
 
         static node_deque
-        iterative_bounded_search(const planning_task &task, strategy strategy, contraction_type contraction_type, statistics &stats,
+        iterative_bounded_search(const planning_task &task, strategy strategy, contraction_type contraction_type,
+                                 parallelism parallelism, statistics &stats, frontier &previous_iter_frontier,
                                  visited_states &visited_states, del::storages_handler_ptr handler,
                                  const daedalus::tester::printer_ptr &printer);
 
-        static node_deque bounded_search(const planning_task &task, strategy strategy, contraction_type contraction_type, statistics &stats,
+        static node_deque bounded_search(const planning_task &task, strategy strategy, contraction_type contraction_type,
+                                         parallelism parallelism, statistics &stats,
                                          frontier &previous_iter_frontier, unsigned long b,
                                          unsigned long long &id, visited_states &visited_states,
                                          del::storages_handler_ptr handler, const daedalus::tester::printer_ptr &printer);
 
-        static node_deque bfs(const planning_task &task, strategy strategy, contraction_type contraction_type, statistics &stats,
+        static node_deque bfs(const planning_task &task, strategy strategy, contraction_type contraction_type,
+                              parallelism parallelism, statistics &stats,
                               frontier &previous_iter_frontier, unsigned long b, unsigned long long &id,
                               visited_states &visited_states, del::storages_handler_ptr handler,
                               const daedalus::tester::printer_ptr &printer);
@@ -69,10 +93,20 @@ namespace search {
                                         unsigned long b, frontier &previous_iter_frontier, statistics &stats,
                                         visited_states &visited_states, del::storages_handler_ptr handler);
 
+        // The i-th update of updates, if calculated, is the one of the i-th action. The others are calculated on demand.
+        // If no update is given and parallelism allows it, the updates of all actions are first calculated in parallel
         static node_deque expand_node(const planning_task &task, strategy strategy, contraction_type contraction_type,
-                                      statistics &stats, node_ptr &n, const kripke::action_deque &actions, frontier &frontier,
+                                      parallelism parallelism, statistics &stats, node_ptr &n, const kripke::action_deque &actions, frontier &frontier,
                                       unsigned long goal_depth, unsigned long long &id, visited_states &visited_states,
-                                      del::storages_handler_ptr handler, const daedalus::tester::printer_ptr &printer);
+                                      del::storages_handler_ptr handler, const daedalus::tester::printer_ptr &printer,
+                                      std::vector<child_update> updates = {});
+
+        // Calculates in parallel the updates of the nodes of layer. The updates that come after a goal state in the
+        // sequential order are skipped, when possible
+        static std::deque<std::vector<child_update>> calculate_layer(const planning_task &task, strategy strategy,
+                                                                     contraction_type contraction_type, const node_deque &layer,
+                                                                     const heuristic_ptr &heuristic,
+                                                                     del::storages_handler_ptr handler);
 
         static void update_statistics(search::statistics &stats, search::node_ptr &n);
 
@@ -80,24 +114,42 @@ namespace search {
 
         static bool validate(const planning_task &task, const node_deque &path, del::storages_handler_ptr handler);
 
-        static search::node_ptr update_node(strategy strategy, contraction_type contraction_type, const node_ptr &n,
-                                            const kripke::action_ptr &a, unsigned long long &id,
-                                            const visited_states &visited_states, del::storages_handler_ptr handler,
-                                            unsigned long goal_depth = 0);
+        static child_update calculate_child(const planning_task &task, strategy strategy, contraction_type contraction_type,
+                                            const node_ptr &n, const kripke::action_ptr &a,
+                                            const boost::dynamic_bitset<> &candidates, const heuristic_ptr &heuristic,
+                                            del::storages_handler_ptr handler, bool check_goal);
 
         static void refresh_node(node_ptr &n, contraction_type contraction_type, statistics &stats,
                                  visited_states &visited_states, del::storages_handler_ptr handler);
 
         static search::node_ptr init_node(contraction_type contraction_type, const kripke::state_ptr &s,
                                           const kripke::action_ptr &a, bool was_bisim, const node_ptr &parent, unsigned long long id,
-                                          const visited_states &visited_states, del::storages_handler_ptr handler, unsigned long b = 0);
+                                          const visited_states &visited_states, del::storages_handler_ptr handler, unsigned long b = 0,
+                                          bool resumable = false);
+
+        static search::node_ptr init_node(child_update &&update, const kripke::action_ptr &a, const node_ptr &parent,
+                                          unsigned long long id, const visited_states &visited_states,
+                                          del::storages_handler_ptr handler);
+
+        // Fills the contraction of s in update
+        static void contract(contraction_type contraction_type, const kripke::state_ptr &s, bool was_bisim, unsigned long b,
+                             bool resumable, child_update &update, del::storages_handler_ptr handler);
+
+        // Keeps the refinement structures of n, if they fit into the memory budget
+        static void retain_bpr_structures(node_ptr &n, kripke::bpr_structures structures);
+
+        // Visited states are stored up to the symmetries of the task, if it has any
+        static void init_visited_states(const planning_task &task, contraction_type contraction_type,
+                                        visited_states &visited_states);
 
-        static void update_visited_states(const kripke::state_ptr &s, visited_states &visited_states);
+        static void update_visited_states(const kripke::state_ptr &s, unsigned long b, visited_states &visited_states,
+                                          del::storages_handler_ptr handler);
 
         static bool is_already_visited(const kripke::state &s, unsigned long b, const visited_states &visited_states, del::storages_handler_ptr handler);
 
         // Print utilities
-        static void print_info(const planning_task &task, strategy strategy, contraction_type contraction_type);
+        static void print_info(const planning_task &task, strategy strategy, contraction_type contraction_type,
+                               search_order order, heuristic_type heuristic_type);
         static void print_statistics(statistics &stats, strategy strategy);
 
         static void print_max_graph_depth(const daedalus::tester::printer_ptr &printer, unsigned long long max_graph_depth);
@@ -29,6 +29,10 @@
 #include "../del/semantics/kripke/actions/action.h"
 #include "../del/formulas/formula.h"
 #include "../del/language/language.h"
+#include "action_index.h"
+#include "relevance_analysis.h"
+#include "symmetry_analysis.h"
+#include "../utils/storage_types.h"
 
 namespace search {
     class planning_task;
@@ -37,7 +41,8 @@ namespace search {
     class planning_task {
     public:
         planning_task(std::string domain_name, std::string problem_id, del::language_ptr language,
-                      kripke::state initial_state, kripke::action_deque actions, del::formula_ptr goal);
+                      kripke::state initial_state, kripke::action_deque actions, del::formula_ptr goal,
+                      del::label_storage &l_storage);
 
         planning_task(const planning_task&) = delete;
         planning_task& operator=(const planning_task&) = delete;
@@ -50,27 +55,44 @@ namespace search {
         [[nodiscard]] std::string get_domain_name() const;
         [[nodiscard]] std::string get_problem_id() const;
         [[nodiscard]] unsigned long get_maximum_depth() const;
+        [[nodiscard]] unsigned long long get_original_events_number() const;
+        [[nodiscard]] unsigned long long get_events_number() const;
 
         [[nodiscard]] del::language_ptr get_language() const;
         [[nodiscard]] kripke::state_ptr get_initial_state() const;
         [[nodiscard]] const kripke::action_deque &get_actions() const;
         [[nodiscard]] del::formula_ptr get_goal() const;
+        [[nodiscard]] const action_index &get_action_index() const;
+        [[nodiscard]] const relevance_analysis &get_relevance_analysis() const;
+        [[nodiscard]] const symmetry_analysis &get_symmetry_analysis() const;
 
         [[nodiscard]] const kripke::action_ptr &get_action(const std::string &name) const;
         [[nodiscard]] kripke::action_deque get_actions(const std::vector<std::string> &names) const;
 
+        // Returns the composition of the given sequence of actions. Compositions are built once and then cached
+        [[nodiscard]] const kripke::action_ptr &get_macro_action(const std::vector<std::string> &names) const;
+
     private:
         std::string m_domain_name, m_problem_id;
         unsigned long m_maximum_depth;
+        unsigned long long m_original_events_number, m_events_number;
 
         del::language_ptr m_language;
         kripke::state_ptr m_initial_state;
         kripke::action_deque m_actions;
         del::formula_ptr m_goal;
+        action_index m_action_index;
+        relevance_analysis m_relevance_analysis;
+        symmetry_analysis m_symmetry_analysis;
 
         std::map<std::string, kripke::action_ptr> m_actions_map;
+        mutable std::map<std::vector<std::string>, kripke::action_ptr> m_macro_actions_map;
 
         void init_maximum_depth();
+        void init_relevant_task(del::label_storage &l_storage);
+        void init_minimal_actions();
+        void init_symmetry_analysis(del::label_storage &l_storage);
+        void init_action_index();
         void init_actions_map();
     };
 }
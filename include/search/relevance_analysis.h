@@ -0,0 +1,74 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef DAEDALUS_RELEVANCE_ANALYSIS_H
+#define DAEDALUS_RELEVANCE_ANALYSIS_H
+
+#include <queue>
+#include "boost/dynamic_bitset.hpp"
+#include "../del/semantics/kripke/states/state.h"
+#include "../del/semantics/kripke/actions/action.h"
+#include "../del/formulas/formula.h"
+#include "../utils/storage_types.h"
+
+namespace search {
+    // Atoms and agents of a planning task that may affect the truth of its goal or of the preconditions of its actions.
+    // An atom is relevant if it occurs in one of these formulas, or in a postcondition that assigns a relevant atom. An
+    // agent is relevant if it occurs in a modality of these formulas. Projecting the labels of the states on the relevant
+    // atoms and dropping the relations of the irrelevant agents does not change which plans are valid, and it makes
+    // bisimulation contractions coarser
+    class relevance_analysis {
+    public:
+        relevance_analysis() = default;
+        relevance_analysis(const del::language_ptr &language, const kripke::action_deque &actions, const del::formula_ptr &goal);
+
+        relevance_analysis(const relevance_analysis&) = delete;
+        relevance_analysis& operator=(const relevance_analysis&) = delete;
+
+        relevance_analysis(relevance_analysis&&) = default;
+        relevance_analysis& operator=(relevance_analysis&&) = default;
+
+        ~relevance_analysis() = default;
+
+        [[nodiscard]] const boost::dynamic_bitset<> &get_relevant_atoms() const;
+        [[nodiscard]] const boost::dynamic_bitset<> &get_relevant_agents() const;
+
+        // True if all atoms and agents are relevant, so that projections leave states and actions unchanged
+        [[nodiscard]] bool is_trivial() const;
+
+        // Copy of s where irrelevant atoms are false in all worlds and irrelevant agents have no edges
+        [[nodiscard]] kripke::state project(const kripke::state &s, del::label_storage &l_storage) const;
+
+        // Copy of a without the postconditions of irrelevant atoms and the edges of irrelevant agents
+        [[nodiscard]] kripke::action project(const kripke::action &a) const;
+
+    private:
+        boost::dynamic_bitset<> m_relevant_atoms, m_relevant_agents;
+
+        // Marks the atoms and agents of f as relevant. Atoms that were not relevant yet are queued in to_visit
+        void add_formula(const del::formula &f, std::queue<del::atom> &to_visit);
+    };
+}
+
+#endif //DAEDALUS_RELEVANCE_ANALYSIS_H
@@ -0,0 +1,55 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef DAEDALUS_ROOTED_STATES_SET_H
+#define DAEDALUS_ROOTED_STATES_SET_H
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include "../del/semantics/kripke/states/states_types.h"
+#include "../utils/storage_types.h"
+
+namespace search {
+    // Set of the states visited by the search with rooted contractions. Since rooted contractions are not canonical, a
+    // state is visited wrt. bound k if it is k-bisimilar to some stored state. To avoid comparing it with all of them,
+    // the stored states are bucketed by their k-fingerprints, and only the states in the same bucket are checked for
+    // k-bisimilarity. The buckets for bound k are built the first time that k is queried, and then kept up to date
+    class rooted_states_set {
+    public:
+        void emplace(const kripke::state_ptr &s);
+
+        [[nodiscard]] bool contains(const kripke::state &s, unsigned long k, const del::storages_handler_ptr &handler) const;
+
+        [[nodiscard]] std::size_t size() const { return m_states.size(); }
+
+    private:
+        using buckets = std::unordered_map<std::size_t, std::vector<kripke::state_ptr>>;
+
+        std::vector<kripke::state_ptr> m_states;
+        mutable std::map<unsigned long, buckets> m_buckets;     // m_buckets[k] groups the states by k-fingerprint
+    };
+}
+
+#endif //DAEDALUS_ROOTED_STATES_SET_H
@@ -24,6 +24,7 @@
 #ifndef DAEDALUS_SEARCH_SPACE_H
 #define DAEDALUS_SEARCH_SPACE_H
 
+#include <atomic>
 #include <memory>
 #include "search_types.h"
 #include "../del/semantics/kripke/states/state.h"
@@ -53,21 +54,30 @@ namespace search {
         [[nodiscard]] unsigned long get_bound() const;
         [[nodiscard]] bool is_bisim() const;
         [[nodiscard]] bool is_already_visited() const;
+        [[nodiscard]] unsigned long get_heuristic_value() const;
 
         [[nodiscard]] node_ptr get_parent() const;
         [[nodiscard]] const node_deque &get_children() const;
         [[nodiscard]] const kripke::action_deque &get_to_apply_actions() const;
 
-//        [[nodiscard]] kripke::bpr_structures &get_bpr_structures();
+        [[nodiscard]] bool has_bpr_structures() const;
+        [[nodiscard]] kripke::bpr_structures &get_bpr_structures();
+
+        // Memory used by the refinement structures of all nodes, in bytes, and its peak value since the last reset. The
+        // counters are atomic, since structures may be released by the threads of the parallel search
+        [[nodiscard]] static unsigned long long get_bpr_structures_memory();
+        [[nodiscard]] static unsigned long long get_max_bpr_structures_memory();
+        static void reset_max_bpr_structures_memory();
 
         void set_state(kripke::state_ptr s);
+        void set_heuristic_value(unsigned long h);
         void increment_bound();
         void set_is_bisim(bool is_bisim);
         void add_child(const node_ptr &child);
         void clear_non_bisim_children();
         void set_to_apply_action(kripke::action_deque actions);
-        /*void set_bpr_structures(kripke::bpr_structures structures);
-        void clear_bpr_structures();*/
+        void set_bpr_structures(kripke::bpr_structures structures, unsigned long long memory);
+        void clear_bpr_structures();
 
         void set_original_state(kripke::state_ptr s);
         void clear_original_state();
@@ -79,11 +89,14 @@ namespace search {
         kripke::action_ptr m_action;
         unsigned long m_bound;
         bool m_is_bisim, m_already_visited;
+        unsigned long m_heuristic_value = 0;
 
         node_ptr m_parent;
         node_deque m_children, m_non_bisim_children;
         kripke::action_deque m_to_apply_actions;
         kripke::bpr_structures_ptr m_structures;
+
+        static std::atomic<unsigned long long> m_bpr_structures_memory, m_max_bpr_structures_memory;
     };
 }
 
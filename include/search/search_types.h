@@ -32,6 +32,8 @@
 #include <unordered_set>
 #include <variant>
 #include "../del/semantics/kripke/states/states_types.h"
+#include "rooted_states_set.h"
+#include "symmetric_states_set.h"
 
 namespace search {
     class node;
@@ -40,12 +42,16 @@ namespace search {
     using node_priority_queue = std::priority_queue<node_ptr>;
 
     using states_ids_set = std::unordered_set<kripke::state_id>;
-    using visited_states = std::variant<states_ids_set, kripke::state_set>;
+    using visited_states = std::variant<states_ids_set, rooted_states_set, symmetric_states_set>;
 
     class delphic_node;
     using delphic_node_ptr   = std::shared_ptr<delphic_node>;
     using delphic_node_deque = std::deque<delphic_node_ptr>;
 
+    class symbolic_node;
+    using symbolic_node_ptr   = std::shared_ptr<symbolic_node>;
+    using symbolic_node_deque = std::deque<symbolic_node_ptr>;
+
     struct statistics {
         unsigned long m_plan_length{};
         double m_computation_time{};
@@ -55,6 +61,11 @@ namespace search {
         unsigned long long m_non_revisited_states_no{};       // Number of computed states that are discarded because already visited
         unsigned long m_iterations_no{};
         unsigned long m_plan_bound{};
+        unsigned long long m_max_bpr_structures_memory{};   // Peak memory of the refinement structures kept by the nodes
+        unsigned long long m_paige_tarjan_contractions_no{};  // Full contractions calculated by each refinement engine
+        unsigned long long m_bounded_contractions_no{};
+        unsigned long long m_partition_intersection_contractions_no{};
+        unsigned long long m_expanded_nodes_no{};
     };
 }
 #endif //DAEDALUS_SEARCH_TYPES_H
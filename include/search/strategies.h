@@ -32,6 +32,25 @@ namespace search {
         iterative_bounded_search,
         approx_iterative_bounded_search
     };
+
+    // Parts of the search that run on the thread pool: the children of whole search layers, the children of single
+    // nodes (used for the layers that are too small to be split among the threads), or both
+    enum class parallelism : uint8_t {
+        none,
+        layers,
+        nodes,
+        layers_and_nodes
+    };
+
+    // Order in which the nodes of the frontier are expanded: by graph depth, by heuristic value (greedy best-first) or
+    // by their sum (A*). Nodes with the same priority are expanded in the order they were generated. None of the
+    // heuristics is admissible and visited states are pruned when generated, so only breadth-first search finds
+    // shortest plans: A* is a heuristic search without optimality guarantees
+    enum class search_order : uint8_t {
+        breadth_first,
+        greedy_best_first,
+        astar
+    };
 }
 
 #endif //DAEDALUS_STRATEGIES_H
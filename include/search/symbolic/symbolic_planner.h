@@ -0,0 +1,62 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef DAEDALUS_SYMBOLIC_PLANNER_H
+#define DAEDALUS_SYMBOLIC_PLANNER_H
+
+#include <set>
+#include <utility>
+#include <vector>
+#include "symbolic_search_space.h"
+#include "../planning_task.h"
+#include "../search_types.h"
+#include "../strategies.h"
+#include "../../utils/storages_handler.h"
+
+namespace search {
+    // Breadth-first search over symbolic states. The initial state of the task is encoded once, and the actions are
+    // applied with the symbolic product update. Each state is reduced (see symbolic_utils::reduce), which removes most
+    // of the auxiliary variables added by the updates. States with the same encoding are recognized as already visited,
+    // which includes all bisimilar states that are reduced to the atoms. Only the unbounded strategy is supported
+    class symbolic_planner {
+    public:
+        static std::pair<symbolic_node_deque, statistics> search(const planning_task &task, strategy strategy,
+                                                                 del::storages_handler_ptr handler);
+
+        static void print_plan(const symbolic_node_deque &path);
+
+    private:
+        using encodings_set = std::set<std::vector<symbolic::bdd>>;
+
+        static symbolic_node_deque bfs(const planning_task &task, const symbolic::state_ptr &s0, statistics &stats);
+
+        static bool update_visited_states(const symbolic::state &s, encodings_set &visited_states);
+        static void update_statistics(statistics &stats, const symbolic_node_ptr &n);
+        static symbolic_node_deque extract_path(symbolic_node_ptr n);
+
+        static void print_statistics(const statistics &stats, unsigned long bdd_nodes_number);
+    };
+}
+
+#endif //DAEDALUS_SYMBOLIC_PLANNER_H
@@ -0,0 +1,62 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef DAEDALUS_SYMBOLIC_SEARCH_SPACE_H
+#define DAEDALUS_SYMBOLIC_SEARCH_SPACE_H
+
+#include "../search_types.h"
+#include "../../del/semantics/kripke/actions/actions_types.h"
+#include "../../del/semantics/symbolic/states/states_types.h"
+#include "../../del/semantics/symbolic/states/state.h"
+
+namespace search {
+    class symbolic_node {
+    public:
+        symbolic_node(unsigned long long id, symbolic::state_ptr state, kripke::action_ptr action, symbolic_node_ptr parent = nullptr);
+
+        symbolic_node(const symbolic_node&) = delete;
+        symbolic_node& operator=(const symbolic_node&) = delete;
+
+        symbolic_node(symbolic_node&&) = default;
+        symbolic_node& operator=(symbolic_node&&) = default;
+
+        ~symbolic_node() = default;
+
+        [[nodiscard]] unsigned long long get_id() const;
+        [[nodiscard]] unsigned long long get_tree_depth() const;
+
+        [[nodiscard]] symbolic::state_ptr get_state() const;
+        [[nodiscard]] kripke::action_ptr get_action() const;
+        [[nodiscard]] symbolic_node_ptr get_parent() const;
+
+    private:
+        unsigned long long m_id, m_tree_depth;
+
+        symbolic::state_ptr m_state;
+        kripke::action_ptr m_action;
+        symbolic_node_ptr m_parent;
+    };
+}
+
+#endif //DAEDALUS_SYMBOLIC_SEARCH_SPACE_H
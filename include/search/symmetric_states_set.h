@@ -0,0 +1,83 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef DAEDALUS_SYMMETRIC_STATES_SET_H
+#define DAEDALUS_SYMMETRIC_STATES_SET_H
+
+#include <unordered_set>
+#include "rooted_states_set.h"
+#include "symmetry_analysis.h"
+#include "../del/semantics/kripke/bisimulation/bisimulation_types.h"
+
+namespace search {
+    // Set of the states visited by the search of a task with symmetries. A state is visited if it is equivalent to the
+    // image of a stored state under some symmetry. Identifying every image of every stored state is too expensive with
+    // large groups, so the stored states are bucketed by a fingerprint that is invariant under both bisimulation and the
+    // symmetries, and we only add the images of a stored state the first time that a state falls into its bucket. Most
+    // states are fixed by many symmetries, so the images are found by a visit of the orbit of the state that applies
+    // the generators of the symmetries, which takes (size of the orbit) * (number of generators) identifications. With
+    // full and canonical contractions, states are stored by their ids wrt. the bound of their identification: this is
+    // the search bound for canonical contractions, and the depth of the state plus one for full contractions. With
+    // rooted contractions, they are stored in a rooted_states_set
+    class symmetric_states_set {
+    public:
+        symmetric_states_set(const symmetry_analysis &symmetries, kripke::contraction_type type);
+
+        void emplace(const kripke::state_ptr &s, unsigned long k, const del::storages_handler_ptr &handler);
+
+        [[nodiscard]] bool contains(const kripke::state &s, unsigned long k, const del::storages_handler_ptr &handler) const;
+
+    private:
+        struct stored_state {
+            kripke::state_ptr m_state;
+            unsigned long m_k;
+            bool m_is_expanded;                                 // True if the images of m_state were added
+        };
+
+        // Number of refinement rounds of the symmetric fingerprints
+        static constexpr unsigned long fingerprint_bound = 2;
+
+        const symmetry_analysis *m_symmetries;
+        kripke::contraction_type m_type;
+        unsigned long m_agents_orbits_number;
+        mutable std::unordered_map<std::size_t, std::vector<stored_state>> m_buckets;
+        mutable std::unordered_set<kripke::state_id> m_states_ids;
+        mutable rooted_states_set m_rooted_states;
+        mutable std::vector<std::unordered_map<kripke::label_id, kripke::label_id>> m_permuted_labels;     // One per generator
+
+        // Adds the images of t that are not already in the set
+        void expand(const stored_state &t, const del::storages_handler_ptr &handler) const;
+        [[nodiscard]] bool contains_exactly(const kripke::state &s, unsigned long k, const del::storages_handler_ptr &handler) const;
+
+        [[nodiscard]] kripke::state_id calculate_state_id(const kripke::state &s, unsigned long k,
+                                                          del::storages_handler_ptr handler) const;
+
+        // Like bisimulator::calculate_fingerprint, but labels are only hashed by the number of true atoms in each atom
+        // orbit, and the successors of the agents in the same orbit are hashed as a multiset
+        [[nodiscard]] std::size_t calculate_symmetric_fingerprint(const kripke::state &s, unsigned long k,
+                                                                  del::label_storage &l_storage) const;
+    };
+}
+
+#endif //DAEDALUS_SYMMETRIC_STATES_SET_H
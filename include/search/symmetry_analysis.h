@@ -0,0 +1,139 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef DAEDALUS_SYMMETRY_ANALYSIS_H
+#define DAEDALUS_SYMMETRY_ANALYSIS_H
+
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "boost/dynamic_bitset.hpp"
+#include "../del/semantics/kripke/states/state.h"
+#include "../del/semantics/kripke/actions/action.h"
+#include "../del/formulas/formula.h"
+#include "../utils/storage_types.h"
+
+namespace search {
+    // Permutation of the agents and of the atoms of a language: agent ag is renamed m_agents[ag] and atom p is renamed
+    // m_atoms[p]
+    struct symmetry {
+        std::vector<del::agent> m_agents;
+        std::vector<del::atom> m_atoms;
+    };
+
+    // Symmetries of a planning task: permutations of its agents and atoms that map the initial state to a bisimilar
+    // state, every action to a bisimilar action of the task and the goal to itself (up to the order of conjuncts and
+    // disjuncts). If s is reachable by a plan, then so is its image under a symmetry, and it satisfies the goal iff s
+    // does, so the search only needs to visit one state per orbit. The symmetries are found by enumerating the
+    // permutations that preserve some cheap invariants of agents and atoms, and verifying the ones that are not generated
+    // by the previously verified symmetries. Since every found symmetry is sound, stopping the enumeration early only
+    // makes the reduction weaker
+    class symmetry_analysis {
+    public:
+        symmetry_analysis() = default;
+        symmetry_analysis(const del::language_ptr &language, const kripke::state &s0, const kripke::action_deque &actions,
+                          const del::formula_ptr &goal, const boost::dynamic_bitset<> &relevant_atoms,
+                          const boost::dynamic_bitset<> &relevant_agents, del::label_storage &l_storage);
+
+        symmetry_analysis(const symmetry_analysis&) = delete;
+        symmetry_analysis& operator=(const symmetry_analysis&) = delete;
+
+        symmetry_analysis(symmetry_analysis&&) = default;
+        symmetry_analysis& operator=(symmetry_analysis&&) = default;
+
+        ~symmetry_analysis() = default;
+
+        // The found symmetries, starting with the identity
+        [[nodiscard]] const std::vector<symmetry> &get_symmetries() const;
+
+        // Subset of the found symmetries (without the identity) that generates a group containing all of them
+        [[nodiscard]] const std::vector<symmetry> &get_generators() const;
+
+        // True if the identity is the only found symmetry
+        [[nodiscard]] bool is_trivial() const;
+
+        // Orbits of the agents (resp. atoms) under the found symmetries: agents (resp. atoms) in the same orbit have the
+        // same id, and orbits are numbered from 0
+        [[nodiscard]] const std::vector<unsigned long> &get_agents_orbits() const;
+        [[nodiscard]] const std::vector<unsigned long> &get_atoms_orbits() const;
+
+        // Copy of s where agents and atoms are renamed by sym. The renamed labels are memoized in permuted_labels, which
+        // can be shared by the calls with the same symmetry
+        [[nodiscard]] static kripke::state permute(const kripke::state &s, const symmetry &sym, del::label_storage &l_storage,
+                                                   std::unordered_map<kripke::label_id, kripke::label_id> &permuted_labels);
+
+    private:
+        // Bounds to the number of kept symmetries and of verified candidate permutations
+        static constexpr unsigned long max_symmetries_number = 720, max_candidates_number = 50000;
+
+        // incidence[ag][p] is twice the number of occurrences of p in the scope of a modality of ag in the goal and in
+        // the pre- and postconditions of the actions, plus one if ag can observe p in the initial state. Symmetries
+        // preserve incidences, so they only map agents (resp. atoms) to agents (resp. atoms) of the same color
+        using incidence = std::vector<std::vector<unsigned long>>;
+        using permutations = std::pair<std::vector<del::agent>, std::vector<del::atom>>;
+
+        struct candidates_search {
+            incidence m_incidence;
+            boost::dynamic_bitset<> m_relevant_agents, m_relevant_atoms, m_used_agents, m_used_atoms;
+            std::vector<unsigned long> m_agents_colors, m_atoms_colors;
+            std::function<bool(const symmetry &)> m_verify;
+            unsigned long m_candidates_number;
+            std::set<permutations> m_group;                     // Generated by the verified symmetries
+        };
+
+        std::vector<symmetry> m_symmetries, m_generators;
+        std::vector<unsigned long> m_agents_orbits, m_atoms_orbits;
+
+        void calculate_generators(std::size_t group_size);
+
+        // Closure of group under composition with generators
+        [[nodiscard]] static std::set<permutations> close(const std::set<permutations> &group,
+                                                          const std::vector<symmetry> &generators);
+
+        // Orbits of the elements of a set of size n, where the i-th element is mapped to images(k)[i] by the k-th symmetry
+        [[nodiscard]] std::vector<unsigned long> calculate_orbits(unsigned long n,
+                                                                  const std::function<const std::vector<unsigned long> &(const symmetry &)> &images) const;
+
+        // Description of f after renaming by sym, where the operands of conjunctions and disjunctions are sorted
+        [[nodiscard]] static std::string to_canonical_string(const del::formula &f, const symmetry &sym);
+
+        // Event model whose events are labelled by the canonical descriptions of their pre- and postconditions after
+        // renaming by sym. Equal descriptions get the same label ids in labels_ids
+        [[nodiscard]] static kripke::state build_events_state(const kripke::action &a, const symmetry &sym,
+                                                              std::map<std::string, kripke::label_id> &labels_ids);
+
+        [[nodiscard]] static incidence calculate_incidence(const kripke::state &s0, const kripke::action_deque &actions,
+                                                           const del::formula &goal, const del::label_storage &l_storage);
+        static void add_formula(const del::formula &f, std::vector<del::agent> &scope, incidence &inc);
+
+        // Extends the partial permutation of the agents, and then of the atoms, in all ways that preserve the colors
+        void enumerate_agents(symmetry &sym, del::agent ag, candidates_search &search);
+        void enumerate_atoms(symmetry &sym, del::atom p, candidates_search &search);
+    };
+}
+
+#endif //DAEDALUS_SYMMETRY_ANALYSIS_H
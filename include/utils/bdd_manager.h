@@ -0,0 +1,115 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef DAEDALUS_BDD_MANAGER_H
+#define DAEDALUS_BDD_MANAGER_H
+
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+class bdd_manager;
+using bdd_manager_ptr = std::shared_ptr<bdd_manager>;
+
+// Reduced ordered binary decision diagrams. The BDDs of a manager share their nodes, so that two BDDs represent the
+// same boolean function iff they are the same node. Variables are ordered by index. Nodes are never freed, and the
+// results of the operations are cached until the caches grow too large. A manager is not thread-safe
+class bdd_manager {
+public:
+    using bdd      = unsigned long;
+    using variable = unsigned long;
+
+    static constexpr bdd false_bdd = 0, true_bdd = 1;
+
+    bdd_manager();
+
+    bdd_manager(const bdd_manager&) = delete;
+    bdd_manager& operator=(const bdd_manager&) = delete;
+
+    bdd_manager(bdd_manager&&) = default;
+    bdd_manager& operator=(bdd_manager&&) = default;
+
+    ~bdd_manager() = default;
+
+    [[nodiscard]] bdd get_variable(variable x);
+    // Conjunction of the variables xs, or of their values in bits if given
+    [[nodiscard]] bdd get_cube(const std::vector<variable> &xs);
+    [[nodiscard]] bdd get_minterm(const std::vector<variable> &xs, unsigned long long bits);
+
+    [[nodiscard]] bdd apply_not(bdd f);
+    [[nodiscard]] bdd apply_and(bdd f, bdd g);
+    [[nodiscard]] bdd apply_or(bdd f, bdd g);
+    [[nodiscard]] bdd apply_iff(bdd f, bdd g);
+    [[nodiscard]] bdd apply_ite(bdd f, bdd g, bdd h);
+
+    // Existential quantification of the variables of the cube from f, and from f AND g (relational product)
+    [[nodiscard]] bdd exists(bdd f, bdd cube);
+    [[nodiscard]] bdd and_exists(bdd f, bdd g, bdd cube);
+
+    // Replaces each variable x < renaming.size() of f by renaming[x]. The renaming need not preserve the order
+    [[nodiscard]] bdd rename(bdd f, const std::vector<variable> &renaming);
+
+    // Number of assignments of the variables xs (sorted by index) that satisfy f. The variables of f must be among xs
+    [[nodiscard]] double count_models(bdd f, const std::vector<variable> &xs) const;
+
+    // Number of nodes reachable from f, and overall
+    [[nodiscard]] unsigned long get_size(bdd f) const;
+    [[nodiscard]] unsigned long get_nodes_number() const;
+
+private:
+    struct node {
+        variable m_var;
+        bdd m_low, m_high;
+    };
+
+    struct triple_hash {
+        std::size_t operator()(const std::tuple<bdd, bdd, bdd> &t) const noexcept;
+    };
+
+    using nodes_table = std::unordered_map<std::tuple<bdd, bdd, bdd>, bdd, triple_hash>;
+    using ite_cache   = std::unordered_map<std::tuple<bdd, bdd, bdd>, bdd, triple_hash>;
+
+    static constexpr variable terminal_var = static_cast<variable>(-1);
+    static constexpr unsigned long max_cache_size = 1ul << 22;
+
+    std::vector<node> m_nodes;
+    nodes_table m_unique;
+    ite_cache m_ite_cache, m_exists_cache, m_and_exists_cache;
+
+    [[nodiscard]] bdd make_node(variable x, bdd low, bdd high);
+    [[nodiscard]] variable get_var(bdd f) const { return m_nodes[f].m_var; }
+    [[nodiscard]] bdd get_low (bdd f, variable x) const { return get_var(f) == x ? m_nodes[f].m_low  : f; }
+    [[nodiscard]] bdd get_high(bdd f, variable x) const { return get_var(f) == x ? m_nodes[f].m_high : f; }
+
+    [[nodiscard]] bdd ite_helper(bdd f, bdd g, bdd h);
+    [[nodiscard]] bdd exists_helper(bdd f, bdd cube);
+    [[nodiscard]] bdd and_exists_helper(bdd f, bdd g, bdd cube);
+    [[nodiscard]] bdd rename_helper(bdd f, const std::vector<variable> &renaming, std::unordered_map<bdd, bdd> &memo);
+
+    void check_caches();
+};
+
+#endif //DAEDALUS_BDD_MANAGER_H
@@ -24,11 +24,17 @@
 #ifndef DAEDALUS_STORAGE_H
 #define DAEDALUS_STORAGE_H
 
+#include <array>
 #include <memory>
-#include <deque>
 #include <map>
+#include <mutex>
+#include <boost/integer/integer_log2.hpp>
+#include "thread_pool.h"
 
 namespace del {
+    // Interns elements, assigning the same id to equal elements. Storages are shared by the threads of the parallel
+    // search: emplacing is serialized (when the search is parallel), while getting is lock-free. Elements are kept in chunks of increasing sizes that
+    // are never moved, and an id is only known to a thread after its element has been stored, so reading it is safe
     template<typename Elem>
     class storage {
         using storage_ptr = std::shared_ptr<storage<Elem>>;
@@ -37,34 +43,53 @@ namespace del {
 
     public:
         storage() {
-            m_elements.emplace_back(nullptr);
-            m_count = 1;
+            push_back(nullptr);
         }
 
         explicit storage(Elem &&null) {
-            m_count = 0;
             emplace(std::move(null));
         }
 
-        storage(const storage &) = default;
-        storage &operator=(const storage &) = default;
+        storage(const storage &other) :
+                m_elements_ids{other.m_elements_ids} {
+            for (Elem_id id = 0; id < other.m_count; ++id)
+                push_back(other.get(id));
+        }
+
+        storage &operator=(const storage &other) {
+            if (this != &other)
+                *this = storage{other};
+            return *this;
+        }
 
-        storage(storage &&) noexcept = default;
-        storage &operator=(storage &&) noexcept = default;
+        storage(storage &&other) noexcept :
+                m_elements_ids{std::move(other.m_elements_ids)},
+                m_chunks{std::move(other.m_chunks)},
+                m_count{other.m_count} {}
+
+        storage &operator=(storage &&other) noexcept {
+            m_elements_ids = std::move(other.m_elements_ids);
+            m_chunks = std::move(other.m_chunks);
+            m_count = other.m_count;
+            return *this;
+        }
 
         ~storage() = default;
 
         typename storage<Elem>::Elem_id emplace(Elem &&elem) {
-            if (m_elements_ids.find(elem) != m_elements_ids.end())          // If the element is already stored, then we simply
-                return m_elements_ids.at(elem);                             // return its id
+            const auto lock = thread_pool::lock_if_concurrent<std::unique_lock<std::mutex>>(m_mutex);
+
+            if (const auto it = m_elements_ids.find(elem); it != m_elements_ids.end())  // If the element is already stored,
+                return it->second;                                                      // then we simply return its id
 
             const auto &[it, _] = m_elements_ids.emplace(std::move(elem), m_count);
-            m_elements.emplace_back(std::make_shared<Elem>(it->first));     // Otherwise, we assign the new element a fresh id,
-            return m_count++;                                               // we add it to the deque to ensure constant time
-        }                                                                   // retrieval from id and we return its id
+            push_back(std::make_shared<Elem>(it->first));   // Otherwise, we assign the new element a fresh id, we add it to
+            return m_count - 1;                             // the chunks to ensure constant time retrieval and we return it
+        }
 
         typename storage<Elem>::Elem_ptr get(Elem_id id) const {
-            return m_elements[id];
+            const auto [chunk, offset] = locate(id);
+            return m_chunks[chunk][offset];
         }
 
         [[nodiscard]] bool is_null(Elem_id id) const {
@@ -72,9 +97,29 @@ namespace del {
         }
 
     private:
+        // Chunk c holds the ids in [2^(c + first_chunk_bits) - 2^first_chunk_bits, 2^(c + first_chunk_bits + 1) - 2^first_chunk_bits)
+        static constexpr unsigned long first_chunk_bits = 10, chunks_number = 64 - first_chunk_bits;
+
         std::map<Elem, Elem_id> m_elements_ids;
-        std::deque<Elem_ptr> m_elements;
-        unsigned long m_count;
+        std::array<std::unique_ptr<Elem_ptr[]>, chunks_number> m_chunks;
+        Elem_id m_count = 0;
+        std::mutex m_mutex;
+
+        static std::pair<unsigned long, Elem_id> locate(const Elem_id id) {
+            const Elem_id position = id + (1ULL << first_chunk_bits);
+            const auto bits = static_cast<unsigned long>(boost::integer_log2(position));
+            return {bits - first_chunk_bits, position - (1ULL << bits)};
+        }
+
+        void push_back(Elem_ptr elem) {
+            const auto [chunk, offset] = locate(m_count);
+
+            if (not m_chunks[chunk])
+                m_chunks[chunk] = std::make_unique<Elem_ptr[]>(1ULL << (chunk + first_chunk_bits));
+
+            m_chunks[chunk][offset] = std::move(elem);
+            ++m_count;
+        }
     };
 }
 
@@ -26,6 +26,7 @@
 
 #include <memory>
 #include "storage.h"
+#include "vector_storage.h"
 #include "../del/semantics/delphic/states/possibility_types.h"
 
 namespace del {
@@ -35,6 +36,7 @@ namespace del {
     using possibility_storage       = storage<delphic::possibility>;
     using signature_storage         = possibility_storage;
     using information_state_storage = storage<delphic::information_state>;
+    using signature_vector_storage  = vector_storage<unsigned long long>;    // Flattened signatures of canonical contractions
 
     class storages_handler;
     using storages_handler_ptr = std::shared_ptr<storages_handler>;
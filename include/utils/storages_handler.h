@@ -25,10 +25,13 @@
 
 #include "storage.h"
 #include "storage_types.h"
+#include "thread_pool.h"
 #include "../del/language/label.h"
 #include "../del/semantics/kripke/states/states_types.h"
 #include "../del/semantics/kripke/bisimulation/bounded_bisimulation_types.h"
+#include "../del/semantics/kripke/bisimulation/contractions_storage.h"
 #include <memory>
+#include <mutex>
 
 namespace del {
     class storages_handler {
@@ -37,6 +40,7 @@ namespace del {
             l_storage   = std::move(storage);
             s_storages  = std::deque<signature_storage>(b+1);
             is_storages = std::deque<information_state_storage>(b+1);
+            sv_storages = std::deque<signature_vector_storage>(b+1);
 
             for (unsigned long i = 0; i <= b; ++i) {
                 s_storages[i]  = signature_storage();
@@ -45,18 +49,51 @@ namespace del {
         }
 
         [[nodiscard]] auto &get_label_storage() { return l_storage; }
-        [[nodiscard]] auto &get_signature_storage(unsigned long h) { return s_storages[h]; }
-        [[nodiscard]] auto &get_information_state_storage(unsigned long h) { return is_storages[h]; }
+
+        [[nodiscard]] auto &get_signature_storage(unsigned long h) {
+            const auto lock = thread_pool::lock_if_concurrent<std::unique_lock<std::mutex>>(m_mutex);
+            expand_storages_to(h);
+            return s_storages[h];
+        }
+
+        [[nodiscard]] auto &get_information_state_storage(unsigned long h) {
+            const auto lock = thread_pool::lock_if_concurrent<std::unique_lock<std::mutex>>(m_mutex);
+            expand_storages_to(h);
+            return is_storages[h];
+        }
+
+        [[nodiscard]] auto &get_signature_vector_storage(unsigned long h) {
+            const auto lock = thread_pool::lock_if_concurrent<std::unique_lock<std::mutex>>(m_mutex);
+            expand_storages_to(h);
+            return sv_storages[h];
+        }
+
+        [[nodiscard]] auto &get_state_vector_storage() { return st_storage; }
+        [[nodiscard]] auto &get_contractions_storage() { return c_storage; }
 
         void expand_storages() {
-            s_storages.emplace_back();
-            is_storages.emplace_back();
+            const auto lock = thread_pool::lock_if_concurrent<std::unique_lock<std::mutex>>(m_mutex);
+            expand_storages_to(s_storages.size());
         }
 
     private:
         label_storage l_storage;
         std::deque<signature_storage> s_storages;
         std::deque<information_state_storage> is_storages;
+        std::deque<signature_vector_storage> sv_storages;
+        signature_vector_storage st_storage;
+        kripke::contractions_storage c_storage;
+        std::mutex m_mutex;                 // The storages of the levels are created on demand by the search threads
+
+        // Storages of levels beyond the current search bound are created on demand. Growing the deques does not move
+        // the storages, so the returned references stay valid
+        void expand_storages_to(unsigned long h) {
+            while (s_storages.size() <= h) {
+                s_storages.emplace_back();
+                is_storages.emplace_back();
+                sv_storages.emplace_back();
+            }
+        }
     };
 }
 #endif //DAEDALUS_STORAGES_HANDLER_H
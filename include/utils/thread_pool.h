@@ -0,0 +1,109 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef DAEDALUS_THREAD_POOL_H
+#define DAEDALUS_THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Pool of worker threads for data-parallel loops. The tasks of a run are split into one contiguous range per thread:
+// each thread takes tasks from the front of its own range and, when its range is empty, steals the back half of the
+// range of another thread. The calling thread takes part in the computation, so a pool with n threads has n-1 workers
+class thread_pool {
+public:
+    // The pool shared by the whole planner. By default, it uses all the hardware threads
+    static thread_pool &get_instance();
+
+    explicit thread_pool(unsigned long threads_number);
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    thread_pool(thread_pool&&) = delete;
+    thread_pool& operator=(thread_pool&&) = delete;
+
+    ~thread_pool();
+
+    [[nodiscard]] unsigned long get_threads_number() const { return m_workers.size() + 1; }
+    void set_threads_number(unsigned long threads_number);
+
+    // Whether the tasks of the shared pool may run concurrently. The structures shared by the tasks only need to be
+    // locked in this case, so that a sequential search does not pay for locking
+    [[nodiscard]] static bool is_concurrent() { return get_instance().get_threads_number() > 1; }
+
+    template<typename Lock, typename Mutex>
+    [[nodiscard]] static Lock lock_if_concurrent(Mutex &m) { return is_concurrent() ? Lock{m} : Lock{m, std::defer_lock}; }
+
+    // Calls task(i) for each i in [0, tasks_number) and returns when all calls are done. Runs started while the pool
+    // is busy (e.g., from within a task) are executed sequentially by the calling thread
+    void run(unsigned long tasks_number, const std::function<void(unsigned long)> &task);
+
+    // Calls f(first_i, last_i) on consecutive chunks [first_i, last_i) covering [first, last)
+    template<typename Function>
+    void parallel_for(unsigned long first, unsigned long last, Function f) {
+        if (first >= last)
+            return;
+
+        const unsigned long chunks_number = std::min(last - first, chunks_per_thread * get_threads_number());
+        const unsigned long chunk_size = (last - first + chunks_number - 1) / chunks_number;
+
+        run((last - first + chunk_size - 1) / chunk_size, [&](const unsigned long i) {
+            f(first + i * chunk_size, std::min(last, first + (i + 1) * chunk_size));
+        });
+    }
+
+private:
+    static constexpr unsigned long chunks_per_thread = 8;
+
+    std::vector<std::thread> m_workers;
+    std::unique_ptr<std::atomic<uint64_t>[]> m_ranges;     // The range [lo, hi) of thread t is stored as lo << 32 | hi
+
+    std::mutex m_mutex;
+    std::condition_variable m_start, m_finish;
+    unsigned long m_generation, m_running;
+    bool m_stop;
+
+    std::atomic<bool> m_busy;
+    std::atomic<unsigned long> m_done;
+    const std::function<void(unsigned long)> *m_task;
+
+    void start(unsigned long threads_number);
+    void stop();
+
+    void work(unsigned long t);
+    void execute(unsigned long t);
+
+    bool pop(unsigned long t, unsigned long &task);
+    bool steal(unsigned long t, unsigned long &task);
+};
+
+#endif //DAEDALUS_THREAD_POOL_H
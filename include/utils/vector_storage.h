@@ -0,0 +1,79 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef DAEDALUS_VECTOR_STORAGE_H
+#define DAEDALUS_VECTOR_STORAGE_H
+
+#include <array>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <boost/functional/hash.hpp>
+#include "thread_pool.h"
+
+namespace del {
+    // Interns vectors by hashing, assigning the same id to equal vectors. Ids start from 1, as in storage, but the stored
+    // vectors can not be retrieved from their ids. Since the states of a search layer are identified in parallel, the
+    // vectors are split into shards by hash, each with its own lock. The i-th vector of shard j gets id i * shards + j + 1
+    template<typename Elem>
+    class vector_storage {
+        using Elem_id = unsigned long long;
+
+    public:
+        Elem_id emplace(std::vector<Elem> &&elem) {
+            const std::size_t hash = vector_hash{}(elem);
+            shard &sh = m_shards[hash % shards_number];
+            const auto lock = thread_pool::lock_if_concurrent<std::unique_lock<std::mutex>>(sh.m_mutex);
+
+            const Elem_id id = sh.m_elements_ids.size() * shards_number + hash % shards_number + 1;
+            const auto &[it, _] = sh.m_elements_ids.try_emplace(std::move(elem), id);
+            return it->second;
+        }
+
+        [[nodiscard]] std::size_t size() const {
+            std::size_t size = 0;
+
+            for (const shard &sh : m_shards)
+                size += sh.m_elements_ids.size();
+
+            return size;
+        }
+
+    private:
+        static constexpr std::size_t shards_number = 16;
+
+        struct vector_hash {
+            std::size_t operator()(const std::vector<Elem> &v) const { return boost::hash_range(v.begin(), v.end()); }
+        };
+
+        struct shard {
+            std::unordered_map<std::vector<Elem>, Elem_id, vector_hash> m_elements_ids;
+            std::mutex m_mutex;
+        };
+
+        std::array<shard, shards_number> m_shards;
+    };
+}
+
+#endif //DAEDALUS_VECTOR_STORAGE_H
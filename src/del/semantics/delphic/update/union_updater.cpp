@@ -29,6 +29,7 @@
 #include "../../../../../include/utils/storage.h"
 #include <iterator>
 #include <memory>
+#include <stdexcept>
 #include <unordered_map>
 #include <vector>
 
@@ -67,7 +68,11 @@ union_updater::update(const delphic::possibility_spectrum_ptr &W, const delphic:
             return update_semi_private_announcement(W, E);
         case action_type::semi_private_sensing:
             return update_semi_private_sensing(W, E);
+        case action_type::composite:
+            // Compositions of actions only exist in the Kripke semantics
+            throw std::invalid_argument("Composite actions are not supported by the delphic semantics");
     }
+    return nullptr;
 }
 
 possibility_spectrum_ptr
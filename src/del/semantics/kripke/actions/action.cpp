@@ -26,6 +26,9 @@
 #include "../../../../../include/del/formulas/formula.h"
 #include "../../../../../include/del/formulas/formula_types.h"
 #include "../../../../../include/utils/printer/formula_printer.h"
+#include "../../../../../include/utils/thread_pool.h"
+#include <algorithm>
+#include <mutex>
 
 using namespace kripke;
 
@@ -40,8 +43,11 @@ action::action(del::language_ptr language, action_type type, std::string name, u
        m_preconditions{std::move(pre)},
        m_postconditions{std::move(post)},
        m_is_ontic{std::move(is_ontic)},
-       m_designated_events{std::move(designated_events)} {
+       m_designated_events{std::move(designated_events)},
+       m_label_transitions{events_label_transitions(m_events_number)},
+       m_label_transitions_mutex{std::make_unique<std::shared_mutex>()} {
     calculate_maximum_depth();
+    preprocess();
 }
 
 del::language_ptr action::get_language() const {
@@ -52,12 +58,13 @@ action_type action::get_type() const {
     return m_type;
 }
 
-std::string action::get_name() const {
+const std::string &action::get_name() const {
     return m_name;
 }
 
 void action::calculate_maximum_depth() {
     m_maximum_depth = 0;
+    m_postconditions_depth = 0;
 
     for (const del::formula_ptr &f_pre : m_preconditions)
         if (f_pre->get_modal_depth() > m_maximum_depth)
@@ -65,8 +72,85 @@ void action::calculate_maximum_depth() {
 
     for (const event_post &ep : m_postconditions)
         for (const auto &[atom, f_post] : ep)
-            if (f_post->get_modal_depth() > m_maximum_depth)
-                m_maximum_depth = f_post->get_modal_depth();
+            if (f_post->get_modal_depth() > m_postconditions_depth)
+                m_postconditions_depth = f_post->get_modal_depth();
+
+    m_maximum_depth = std::max(m_maximum_depth, m_postconditions_depth);
+}
+
+void action::preprocess() {
+    const auto agents_number = m_language->get_agents_number();
+
+    m_successors_offsets.reserve(agents_number * m_events_number + 1);
+    m_successors_offsets.push_back(0);
+
+    for (del::agent ag = 0; ag < agents_number; ++ag)
+        for (event_id e = 0; e < m_events_number; ++e) {
+            const auto first = m_successors.size();
+            m_successors.insert(m_successors.end(), m_relations[ag][e].begin(), m_relations[ag][e].end());
+            std::sort(m_successors.begin() + static_cast<long>(first), m_successors.end());
+            m_successors_offsets.push_back(m_successors.size());
+        }
+
+    m_rows_ids.reserve(agents_number * m_events_number);
+
+    for (del::agent ag = 0; ag < agents_number; ++ag) {
+        std::map<std::vector<event_id>, row_id> rows;
+
+        for (event_id e = 0; e < m_events_number; ++e) {
+            const event_span successors = get_agent_successors(ag, e);
+            m_rows_ids.push_back(rows.emplace(std::vector<event_id>(successors.begin(), successors.end()), rows.size()).first->second);
+        }
+    }
+
+    // The relation of ag is an equivalence iff each event is in its own row, and all the events of a row have that row
+    m_is_equivalence = boost::dynamic_bitset<>(agents_number);
+
+    for (del::agent ag = 0; ag < agents_number; ++ag) {
+        bool is_equivalence = true;
+
+        for (event_id e = 0; e < m_events_number and is_equivalence; ++e) {
+            const event_span successors = get_agent_successors(ag, e);
+            is_equivalence = std::binary_search(successors.begin(), successors.end(), e) and
+                             std::all_of(successors.begin(), successors.end(),
+                                         [&](const event_id f) { return get_agent_row_id(ag, f) == get_agent_row_id(ag, e); });
+        }
+        m_is_equivalence[ag] = is_equivalence;
+    }
+
+    m_designated_bitset = boost::dynamic_bitset<>(m_events_number);
+
+    for (const event_id ed : m_designated_events)
+        m_designated_bitset.set(ed);
+
+    m_sorted_designated_events.assign(m_designated_events.begin(), m_designated_events.end());
+    std::sort(m_sorted_designated_events.begin(), m_sorted_designated_events.end());
+
+    std::unordered_map<const del::formula *, formula_id> formulas_ids;
+
+    const auto compile = [&](const del::formula_ptr &f) {
+        const auto [it, is_new] = formulas_ids.emplace(f.get(), m_formulas.size());
+        if (is_new) m_formulas.push_back(f);
+        return it->second;
+    };
+
+    m_preconditions_ids.reserve(m_events_number);
+    m_postconditions_offsets.reserve(m_events_number + 1);
+    m_postconditions_offsets.push_back(0);
+
+    for (event_id e = 0; e < m_events_number; ++e) {
+        m_preconditions_ids.push_back(compile(m_preconditions[e]));
+
+        if (m_is_ontic[e]) {
+            const auto first = m_compiled_postconditions.size();
+
+            for (const auto &[p, f_post] : m_postconditions[e])
+                m_compiled_postconditions.emplace_back(p, compile(f_post));
+
+            std::sort(m_compiled_postconditions.begin() + static_cast<long>(first), m_compiled_postconditions.end());
+        }
+        m_postconditions_offsets.push_back(m_compiled_postconditions.size());
+    }
 }
 
 unsigned long long action::get_events_number() const {
@@ -78,7 +162,7 @@ const event_bitset &action::get_agent_possible_events(const del::agent ag, const
 }
 
 bool action::has_edge(const del::agent ag, const event_id e, const event_id f) const {
-    return std::find(m_relations[ag].at(e).begin(), m_relations[ag].at(e).end(), f) != m_relations[ag].at(e).end();
+    return m_relations[ag][e][f];
 }
 
 del::formula_ptr action::get_precondition(const event_id e) const {
@@ -94,7 +178,41 @@ const event_set &action::get_designated_events() const {
 }
 
 bool action::is_designated(const event_id e) const {
-    return std::find(m_designated_events.begin(), m_designated_events.end(), e) != m_designated_events.end();
+    return m_designated_bitset[e];
+}
+
+event_span action::get_agent_successors(const del::agent ag, const event_id e) const {
+    const std::size_t i = ag * m_events_number + e;
+    return {m_successors.data() + m_successors_offsets[i], m_successors.data() + m_successors_offsets[i+1]};
+}
+
+row_id action::get_agent_row_id(const del::agent ag, const event_id e) const {
+    return m_rows_ids[ag * m_events_number + e];
+}
+
+bool action::is_equivalence(const del::agent ag) const {
+    return m_is_equivalence[ag];
+}
+
+const std::vector<event_id> &action::get_sorted_designated_events() const {
+    return m_sorted_designated_events;
+}
+
+unsigned long action::get_formulas_number() const {
+    return m_formulas.size();
+}
+
+const del::formula &action::get_formula(const formula_id f) const {
+    return *m_formulas[f];
+}
+
+formula_id action::get_precondition_id(const event_id e) const {
+    return m_preconditions_ids[e];
+}
+
+postconditions_span action::get_compiled_postconditions(const event_id e) const {
+    return {m_compiled_postconditions.data() + m_postconditions_offsets[e],
+            m_compiled_postconditions.data() + m_postconditions_offsets[e+1]};
 }
 
 bool action::is_ontic(const event_id e) const {
@@ -109,6 +227,21 @@ unsigned long action::get_maximum_depth() const {
     return m_maximum_depth;
 }
 
+bool action::has_propositional_postconditions() const {
+    return m_postconditions_depth == 0;
+}
+
+std::optional<label_id> action::get_label_transition(const event_id e, const label_id l) const {
+    const auto lock = thread_pool::lock_if_concurrent<std::shared_lock<std::shared_mutex>>(*m_label_transitions_mutex);
+    const auto it = m_label_transitions[e].find(l);
+    return it == m_label_transitions[e].end() ? std::nullopt : std::optional<label_id>{it->second};
+}
+
+void action::add_label_transition(const event_id e, const label_id l, const label_id l_) const {
+    const auto lock = thread_pool::lock_if_concurrent<std::unique_lock<std::shared_mutex>>(*m_label_transitions_mutex);
+    m_label_transitions[e].emplace(l, l_);
+}
+
 std::ostream &kripke::operator<<(std::ostream &os, const action &act) {
     using edges_map = std::map<std::pair<event_id, event_id>, std::vector<del::agent>>;
 
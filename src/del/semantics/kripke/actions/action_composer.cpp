@@ -0,0 +1,253 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../../../../include/del/semantics/kripke/actions/action_composer.h"
+#include "../../../../../include/del/semantics/kripke/bisimulation/bisimulator.h"
+#include <cassert>
+#include <queue>
+
+using namespace kripke;
+
+action action_composer::compose(const action &a, const action &b, const bool minimize) {
+    const auto agents_number = a.get_language()->get_agents_number();
+    const event_id b_events_number = b.get_events_number();
+    const auto pair_id = [&](const event_id e, const event_id f) { return e * b_events_number + f; };
+
+    // We first select the events (e, f) that we keep in a;b
+    std::vector<bool> is_kept(a.get_events_number() * b_events_number, not minimize);
+
+    if (minimize) {
+        std::queue<std::pair<event_id, event_id>> to_visit;
+
+        for (const event_id ed : a.get_designated_events())
+            for (const event_id fd : b.get_designated_events()) {
+                is_kept[pair_id(ed, fd)] = true;
+                to_visit.emplace(ed, fd);
+            }
+
+        while (not to_visit.empty()) {
+            const auto [e, f] = to_visit.front();
+            to_visit.pop();
+
+            for (del::agent ag = 0; ag < agents_number; ++ag)
+                for (const event_id e_ : a.get_agent_possible_events(ag, e))
+                    for (const event_id f_ : b.get_agent_possible_events(ag, f))
+                        if (not is_kept[pair_id(e_, f_)]) {
+                            is_kept[pair_id(e_, f_)] = true;
+                            to_visit.emplace(e_, f_);
+                        }
+        }
+    }
+
+    std::vector<event_id> ids(is_kept.size());
+    event_id events_number = 0;
+
+    for (event_id ef = 0; ef < is_kept.size(); ++ef)
+        if (is_kept[ef])
+            ids[ef] = events_number++;
+
+    action_relations q(agents_number);
+
+    for (del::agent ag = 0; ag < agents_number; ++ag)
+        q[ag] = action_agent_relations(events_number, event_bitset(events_number));
+
+    preconditions pre(events_number);
+    postconditions post(events_number);
+    boost::dynamic_bitset<> is_ontic(events_number);
+    event_set designated_events;
+    regression_memo memo;
+
+    for (event_id e = 0; e < a.get_events_number(); ++e)
+        for (event_id f = 0; f < b_events_number; ++f) {
+            if (not is_kept[pair_id(e, f)])
+                continue;
+
+            const event_id ef = ids[pair_id(e, f)];
+            pre[ef] = make_and({a.get_precondition(e), regress(b.get_precondition(f), a, e, memo)});
+
+            if (a.is_ontic(e))                  // Atoms that are not assigned by f keep the value assigned by e, while
+                post[ef] = a.get_postconditions(e);     // those assigned by f get the value of their postcondition in (w, e)
+
+            if (b.is_ontic(f))
+                for (const auto &[p, f_post] : b.get_postconditions(f))
+                    post[ef][p] = regress(f_post, a, e, memo);
+
+            is_ontic[ef] = a.is_ontic(e) or b.is_ontic(f);
+
+            if (a.is_designated(e) and b.is_designated(f))
+                designated_events.emplace(ef);
+
+            for (del::agent ag = 0; ag < agents_number; ++ag)
+                for (const event_id e_ : a.get_agent_possible_events(ag, e))
+                    for (const event_id f_ : b.get_agent_possible_events(ag, f))
+                        if (is_kept[pair_id(e_, f_)])
+                            q[ag][ef].push_back(ids[pair_id(e_, f_)]);
+        }
+
+    std::string name = a.get_name().empty() ? b.get_name() : a.get_name() + ";" + b.get_name();
+    action ab = action{a.get_language(), action_type::composite, std::move(name), events_number, std::move(q), std::move(pre),
+                       std::move(post), std::move(is_ontic), std::move(designated_events)};
+
+    return minimize ? bisimulator::contract(ab) : std::move(ab);
+}
+
+action action_composer::compose(const action_deque &as, const bool minimize) {
+    assert(not as.empty());
+    const del::language_ptr &language = as.front()->get_language();
+
+    // We start from the unnamed skip action, which is the identity of the composition
+    action_relations q(language->get_agents_number(), action_agent_relations(1, event_bitset(1, event_set{0})));
+    action composition = action{language, action_type::composite, "", 1, std::move(q), {std::make_shared<del::true_formula>()},
+                                postconditions(1), boost::dynamic_bitset<>(1), event_set{0}};
+
+    for (const action_ptr &a : as)
+        composition = compose(composition, *a, minimize);
+
+    return composition;
+}
+
+del::formula_ptr action_composer::regress(const del::formula_ptr &f, const action &a, const event_id e, regression_memo &memo) {
+    if (f->is_propositional() and not a.is_ontic(e))        // Epistemic events do not change the truth value of
+        return f;                                           // propositional formulas
+
+    if (const auto it = memo.find({f.get(), e}); it != memo.end())
+        return it->second;
+
+    del::formula_ptr f_ = f;
+
+    switch (f->get_type()) {
+        case del::formula_type::true_formula:
+        case del::formula_type::false_formula:
+            break;
+        case del::formula_type::atom_formula:
+            f_ = regress_atom(f, a, e);
+            break;
+        case del::formula_type::not_formula: {
+            const del::formula_ptr &g = dynamic_cast<const del::not_formula &>(*f).get_f();
+
+            if (del::formula_ptr g_ = regress(g, a, e, memo); g_ != g)
+                f_ = std::make_shared<del::not_formula>(std::move(g_));
+            break;
+        }
+        case del::formula_type::and_formula: {
+            del::formula_deque fs;
+
+            for (const del::formula_ptr &g : dynamic_cast<const del::and_formula &>(*f).get_fs())
+                fs.push_back(regress(g, a, e, memo));
+
+            f_ = make_and(std::move(fs));
+            break;
+        }
+        case del::formula_type::or_formula: {
+            del::formula_deque fs;
+
+            for (const del::formula_ptr &g : dynamic_cast<const del::or_formula &>(*f).get_fs())
+                fs.push_back(regress(g, a, e, memo));
+
+            f_ = make_or(std::move(fs));
+            break;
+        }
+        case del::formula_type::imply_formula: {
+            const auto &f_imply = dynamic_cast<const del::imply_formula &>(*f);
+            del::formula_ptr g1 = regress(f_imply.get_f1(), a, e, memo), g2 = regress(f_imply.get_f2(), a, e, memo);
+
+            if (g1 != f_imply.get_f1() or g2 != f_imply.get_f2())
+                f_ = std::make_shared<del::imply_formula>(std::move(g1), std::move(g2));
+            break;
+        }
+        case del::formula_type::box_formula:
+            f_ = regress_box(dynamic_cast<const del::box_formula &>(*f), a, e, memo);
+            break;
+        case del::formula_type::diamond_formula:
+            f_ = regress_diamond(dynamic_cast<const del::diamond_formula &>(*f), a, e, memo);
+            break;
+    }
+
+    memo.emplace(std::make_pair(f.get(), e), f_);
+    return f_;
+}
+
+del::formula_ptr action_composer::regress_atom(const del::formula_ptr &f, const action &a, const event_id e) {
+    if (not a.is_ontic(e))
+        return f;
+
+    const event_post &e_post = a.get_postconditions(e);
+    const auto it = e_post.find(dynamic_cast<const del::atom_formula &>(*f).get_atom());
+
+    return it == e_post.end() ? f : it->second;
+}
+
+del::formula_ptr action_composer::regress_box(const del::box_formula &f, const action &a, const event_id e, regression_memo &memo) {
+    del::formula_deque fs;
+
+    // [e][ag]g holds iff [ag](pre(e_) -> [e_]g) holds for all events e_ that ag considers possible in e
+    for (const event_id e_ : a.get_agent_possible_events(f.get_ag(), e)) {
+        const del::formula_ptr &pre = a.get_precondition(e_);
+        del::formula_ptr g = regress(f.get_f(), a, e_, memo);
+
+        if (pre->get_type() != del::formula_type::true_formula)
+            g = std::make_shared<del::imply_formula>(pre, std::move(g));
+
+        fs.push_back(std::make_shared<del::box_formula>(f.get_ag(), std::move(g)));
+    }
+    return make_and(std::move(fs));
+}
+
+del::formula_ptr action_composer::regress_diamond(const del::diamond_formula &f, const action &a, const event_id e, regression_memo &memo) {
+    del::formula_deque fs;
+
+    for (const event_id e_ : a.get_agent_possible_events(f.get_ag(), e))
+        fs.push_back(std::make_shared<del::diamond_formula>(f.get_ag(),
+                                                            make_and({a.get_precondition(e_), regress(f.get_f(), a, e_, memo)})));
+    return make_or(std::move(fs));
+}
+
+del::formula_ptr action_composer::make_and(del::formula_deque fs) {
+    del::formula_deque fs_;
+
+    for (del::formula_ptr &g : fs)
+        if (g->get_type() == del::formula_type::false_formula)
+            return g;
+        else if (g->get_type() != del::formula_type::true_formula)
+            fs_.push_back(std::move(g));
+
+    if (fs_.empty())
+        return std::make_shared<del::true_formula>();
+
+    return fs_.size() == 1 ? fs_.front() : std::make_shared<del::and_formula>(std::move(fs_));
+}
+
+del::formula_ptr action_composer::make_or(del::formula_deque fs) {
+    del::formula_deque fs_;
+
+    for (del::formula_ptr &g : fs)
+        if (g->get_type() == del::formula_type::true_formula)
+            return g;
+        else if (g->get_type() != del::formula_type::false_formula)
+            fs_.push_back(std::move(g));
+
+    if (fs_.empty())
+        return std::make_shared<del::false_formula>();
+
+    return fs_.size() == 1 ? fs_.front() : std::make_shared<del::or_formula>(std::move(fs_));
+}
@@ -23,18 +23,28 @@
 
 #include "../../../../../include/del/semantics/kripke/bisimulation/bisimulator.h"
 #include "../../../../../include/del/semantics/kripke/bisimulation/partition_refinement.h"
+#include "../../../../../include/del/semantics/kripke/bisimulation/partition_intersection.h"
 #include "../../../../../include/del/semantics/kripke/bisimulation/bounded_contraction_builder.h"
 #include "../../../../../include/del/semantics/kripke/bisimulation/bounded_partition_refinement.h"
-#include "../../../../../include/del/semantics/kripke/bisimulation/bounded_identification.h"
+#include "../../../../../include/utils/printer/formula_printer.h"
 #include <algorithm>
+#include <boost/functional/hash.hpp>
+#include <cassert>
+#include <climits>
+#include <cmath>
+#include <queue>
 
 using namespace kripke;
 
+std::atomic<unsigned long long> bisimulator::m_paige_tarjan_contractions_number = 0;
+std::atomic<unsigned long long> bisimulator::m_bounded_contractions_number = 0;
+std::atomic<unsigned long long> bisimulator::m_partition_intersection_contractions_number = 0;
+
 std::pair<bool, state>
 bisimulator::contract(contraction_type type, const state &s, unsigned long k, del::storages_handler_ptr handler) {
     switch (type) {
         case contraction_type::full:
-            return bounded_contraction_builder::calculate_standard_contraction(s, handler);
+            return calculate_full_contraction(s, handler);
         case contraction_type::rooted:  // todo: std::min(k, s.get_max_depth()+1)
             return bounded_contraction_builder::calculate_rooted_contraction(s, k);
         case contraction_type::canonical:
@@ -42,56 +52,358 @@ bisimulator::contract(contraction_type type, const state &s, unsigned long k, de
     }
 }
 
+unsigned long long bisimulator::get_full_contractions_number(const refinement_engine engine) {
+    switch (engine) {
+        case refinement_engine::paige_tarjan:
+            return m_paige_tarjan_contractions_number.load();
+        case refinement_engine::bounded_refinement:
+            return m_bounded_contractions_number.load();
+        case refinement_engine::partition_intersection:
+            return m_partition_intersection_contractions_number.load();
+    }
+    return 0;
+}
+
+refinement_engine bisimulator::choose_refinement_engine(const state &s) {
+    if (s.is_partitioned())
+        return refinement_engine::partition_intersection;
+    return calculate_max_bounded_steps(s) == 0 ? refinement_engine::paige_tarjan : refinement_engine::bounded_refinement;
+}
+
+unsigned long bisimulator::calculate_max_steps(const state &s) {
+    return static_cast<unsigned long>(std::ceil(paige_tarjan_cost_factor * std::log2(s.get_worlds_number() + 1)));
+}
+
+unsigned long bisimulator::calculate_max_bounded_steps(const state &s) {
+    // Both engines take O(|AG|*|W| + |R|) time per step, but Paige-Tarjan needs O(log |W|) steps, while the bounded
+    // refinement needs one step per level until the levels are stable. If all edges go from a world of depth d to one
+    // of depth d+1, then this happens within max_depth+1 steps. Otherwise, e.g. when s has cycles, it may take up to
+    // |W| steps, but it usually takes much fewer, so we try it anyway within the budget. Worlds that are not reachable
+    // from the designated ones have depth ULONG_MAX (so depth+1 would wrap around) and they are dropped by the quotient,
+    // so we skip their edges. If their blocks are not stable within the budget, we still fall back to Paige-Tarjan
+    const unsigned long max_steps = calculate_max_steps(s);
+
+    for (del::agent ag = 0; ag < s.get_language()->get_agents_number(); ++ag)
+        for (world_id w = 0; w < s.get_worlds_number(); ++w)
+            if (s.get_depth(w) != ULONG_MAX)
+                for (const world_id v : s.get_agent_possible_worlds(ag, w))
+                    if (s.get_depth(v) != s.get_depth(w) + 1)
+                        return max_steps;
+
+    // The last step checks that the levels are stable
+    return s.get_max_depth() + 2 <= max_steps ? max_steps : 0;
+}
+
+std::pair<bool, state> bisimulator::calculate_full_contraction(const state &s, del::storages_handler_ptr handler) {
+    // All engines calculate the same classes, so they yield the same contraction
+    std::optional<std::pair<world_id, std::vector<world_id>>> classes;
+
+    if (s.is_partitioned()) {
+        if ((classes = partition_intersection::calculate_classes(s, calculate_max_steps(s))))
+            ++m_partition_intersection_contractions_number;
+    } else if (const unsigned long max_steps = calculate_max_bounded_steps(s); max_steps > 0) {
+        if ((classes = bounded_partition_refinement::calculate_classes(s, max_steps)))
+            ++m_bounded_contractions_number;
+    }
+
+    if (not classes) {
+        classes = partition_refinement::calculate_classes(s);
+        ++m_paige_tarjan_contractions_number;
+    }
+
+    const auto &[classes_number, worlds_classes] = *classes;
+    state quotient = build_quotient(s, classes_number, worlds_classes);
+
+    // The quotient is minimal, so it is identified among the other quotients rather than by bounded signatures of s,
+    // which do not tell apart all non-bisimilar cyclic states
+    if (handler)
+        quotient.set_id(handler->get_contractions_storage().emplace(quotient));
+
+    return {true, std::move(quotient)};
+}
+
+state bisimulator::build_quotient(const state &s, const world_id classes_number, const std::vector<world_id> &classes) {
+    const auto agents_number = s.get_language()->get_agents_number();
+
+    // We number the classes that are reachable from the designated ones in BFS order. Since the visit only depends on
+    // the classes, and not on their ids, both engines yield the same numbering
+    const world_id unreachable = classes_number;
+    std::vector<world_id> ids(classes_number, unreachable), representatives;
+    std::queue<world_id> to_visit;
+
+    auto visit = [&](const world_id w) {
+        if (ids[classes[w]] == unreachable) {
+            ids[classes[w]] = representatives.size();
+            representatives.emplace_back(w);
+            to_visit.push(w);
+        }
+    };
+
+    for (const world_id wd : s.get_designated_worlds())
+        visit(wd);
+
+    while (not to_visit.empty()) {
+        const world_id w = to_visit.front();
+        to_visit.pop();
+
+        for (del::agent ag = 0; ag < agents_number; ++ag)
+            for (const world_id v : s.get_agent_possible_worlds(ag, w))
+                visit(v);
+    }
+
+    // Bisimilar worlds have bisimilar successors, so the edges of a representative give all the edges of its class.
+    // Representatives with the same row have the same edges, so each row of s is mapped to the quotient only once.
+    // The quotient of an equivalence is an equivalence. Bisimilar worlds have classes with the same image, so the
+    // images of two classes of s are either equal or disjoint, and they are the classes of the quotient. Since each
+    // world is in its own class, each world of the quotient is in the image of the class of its representative
+    const world_id worlds_number = representatives.size();
+    relations_rows quotient_r = relations_rows(agents_number);
+    relations_rows_ids quotient_rows_ids = relations_rows_ids(agents_number, agent_rows_ids(worlds_number));
+    label_vector quotient_l = label_vector(worlds_number);
+
+    for (del::agent ag = 0; ag < agents_number; ++ag) {
+        if (s.is_equivalence(ag)) {
+            agent_rows_ids &quotient_classes = quotient_rows_ids[ag];
+            const row_id unassigned = worlds_number;
+            row_id quotient_classes_number = 0;
+
+            std::fill(quotient_classes.begin(), quotient_classes.end(), unassigned);
+
+            for (world_id w_ = 0; w_ < worlds_number; ++w_)
+                if (quotient_classes[w_] == unassigned) {
+                    for (const world_id v : s.get_agent_row(ag, s.get_agent_row_id(ag, representatives[w_])))
+                        quotient_classes[ids[classes[v]]] = quotient_classes_number;
+                    ++quotient_classes_number;
+                }
+            continue;
+        }
+
+        std::vector<row_id> rows_map(s.get_agent_rows_number(ag), s.get_agent_rows_number(ag));
+        row_id rows_number = 0;
+
+        for (world_id w_ = 0; w_ < worlds_number; ++w_) {
+            const row_id r = s.get_agent_row_id(ag, representatives[w_]);
+
+            if (rows_map[r] == s.get_agent_rows_number(ag)) {
+                rows_map[r] = rows_number++;
+                world_bitset &row = quotient_r[ag].emplace_back(worlds_number);
+
+                for (const world_id v : s.get_agent_row(ag, r))
+                    row.push_back(ids[classes[v]]);
+            }
+            quotient_rows_ids[ag][w_] = rows_map[r];
+        }
+    }
+
+    for (world_id w_ = 0; w_ < worlds_number; ++w_)
+        quotient_l[w_] = s.get_label_id(representatives[w_]);
+
+    world_bitset designated_worlds(worlds_number);
+
+    for (const world_id wd : s.get_designated_worlds())
+        designated_worlds.push_back(ids[classes[wd]]);
+
+    return state{s.get_language(), worlds_number, std::move(quotient_r), std::move(quotient_rows_ids), std::move(quotient_l),
+                 std::move(designated_worlds)};
+}
+
 bool bisimulator::are_bisimilar(const state &s, const state &t, unsigned long k, del::storages_handler_ptr handler) {
     state u = disjoint_union(s, t);
-    unsigned long offset = s.get_worlds_number();
 
     auto [is_bisim, structures] = bounded_partition_refinement::do_refinement_steps(u, k);
-    auto worlds_blocks = structures.worlds_blocks;
-
-    for (auto wd: s.get_designated_worlds())
-        if (std::all_of(t.get_designated_worlds().begin(), t.get_designated_worlds().end(),
-                    [&](world_id vd) -> bool {
-                        auto block_wd = worlds_blocks[wd][k];
-                        return std::find(block_wd->begin(), block_wd->end(), offset + vd) == block_wd->end();}))
-            return false;
-
-    for (auto vd: t.get_designated_worlds())
-        if (std::all_of(s.get_designated_worlds().begin(), s.get_designated_worlds().end(),
-                        [&](world_id wd) -> bool {
-                            auto block_vd = worlds_blocks[offset + vd][k];
-                            return std::find(block_vd->begin(), block_vd->end(), wd) == block_vd->end();}))
-            return false;
-
-    return true;
+    return have_same_designated_blocks(s, t, structures.get_level(k));
+}
+
+bool bisimulator::are_bisimilar(const state &s, const state &t) {
+    const auto [_, classes] = partition_refinement::calculate_classes(disjoint_union(s, t));
+    return have_same_designated_blocks(s, t, classes);
+}
+
+std::size_t bisimulator::calculate_fingerprint(const state &s, unsigned long k) {
+    // Label ids are shared by all states, so we can hash them directly. Complexity: O(k * (|W| + |R|) * log(|W|))
+    std::vector<std::size_t> signatures = std::vector<std::size_t>(s.get_worlds_number());
+    std::vector<std::size_t> next_signatures = std::vector<std::size_t>(s.get_worlds_number()), successors;
+
+    for (world_id w = 0; w < s.get_worlds_number(); ++w)
+        signatures[w] = boost::hash_value(s.get_label_id(w));
+
+    for (unsigned long h = 0; h < k; ++h) {
+        for (world_id w = 0; w < s.get_worlds_number(); ++w) {
+            std::size_t signature = signatures[w];
+
+            for (del::agent ag = 0; ag < s.get_language()->get_agents_number(); ++ag) {
+                successors.clear();
+
+                for (const world_id v : s.get_agent_possible_worlds(ag, w))
+                    successors.push_back(signatures[v]);
+
+                // Bisimilar worlds may have different numbers of bisimilar successors, so we hash sets of signatures
+                std::sort(successors.begin(), successors.end());
+                successors.erase(std::unique(successors.begin(), successors.end()), successors.end());
+                boost::hash_combine(signature, boost::hash_range(successors.begin(), successors.end()));
+            }
+            next_signatures[w] = signature;
+        }
+        std::swap(signatures, next_signatures);
+    }
+
+    successors.clear();
+
+    for (const world_id wd : s.get_designated_worlds())
+        successors.push_back(signatures[wd]);
+
+    std::sort(successors.begin(), successors.end());
+    successors.erase(std::unique(successors.begin(), successors.end()), successors.end());
+    return boost::hash_range(successors.begin(), successors.end());
+}
+
+std::tuple<bool, state, bpr_structures>
+bisimulator::resumable_contract(contraction_type type, const state &s, unsigned long k, del::storages_handler_ptr handler) {
+    assert(type != contraction_type::full);
+    return bounded_contraction_builder::calculate_resumable_rooted_contraction(s, k, type == contraction_type::canonical, handler);
 }
 
-/*std::tuple<bool, state, bpr_structures> bisimulator::resume_contraction(contraction_type type, const state &s, unsigned long k,
+std::pair<bool, state> bisimulator::resume_contraction(contraction_type type, const state &s, unsigned long k,
                                                        bpr_structures &structures, del::storages_handler_ptr handler) {
-    return bounded_contraction_builder::update_rooted_contraction(s, k, structures, type == contraction_type::canonical, storages);
-}*/
+    assert(type != contraction_type::full);
+    return bounded_contraction_builder::update_rooted_contraction(s, k, structures, type == contraction_type::canonical, handler);
+}
+
+action bisimulator::contract(const action &a) {
+    const auto agents_number = a.get_language()->get_agents_number();
+    const auto [classes_number, events_classes] = partition_refinement::calculate_classes(build_events_state(a));
+
+    std::vector<event_id> representatives(classes_number, a.get_events_number());
+    action_relations classes_relations(agents_number, action_agent_relations(classes_number, event_bitset(classes_number)));
+
+    for (event_id e = 0; e < a.get_events_number(); ++e) {
+        if (representatives[events_classes[e]] == a.get_events_number())
+            representatives[events_classes[e]] = e;
+
+        for (del::agent ag = 0; ag < agents_number; ++ag)
+            for (const event_id f : a.get_agent_possible_events(ag, e))
+                classes_relations[ag][events_classes[e]].push_back(events_classes[f]);
+    }
+
+    // We only keep the classes that are reachable from the designated ones
+    const event_id unreachable = classes_number;
+    std::vector<event_id> ids(classes_number, unreachable);
+    std::queue<event_id> to_visit;
+    event_id events_number = 0;
+
+    for (const event_id ed : a.get_designated_events())
+        if (ids[events_classes[ed]] == unreachable) {
+            ids[events_classes[ed]] = events_number++;
+            to_visit.push(events_classes[ed]);
+        }
+
+    while (not to_visit.empty()) {
+        const event_id c = to_visit.front();
+        to_visit.pop();
+
+        for (del::agent ag = 0; ag < agents_number; ++ag)
+            for (const event_id d : classes_relations[ag][c])
+                if (ids[d] == unreachable) {
+                    ids[d] = events_number++;
+                    to_visit.push(d);
+                }
+    }
+
+    action_relations q(agents_number, action_agent_relations(events_number, event_bitset(events_number)));
+    preconditions pre(events_number);
+    postconditions post(events_number);
+    boost::dynamic_bitset<> is_ontic(events_number);
+    event_set designated_events;
+
+    for (event_id c = 0; c < classes_number; ++c) {
+        if (ids[c] == unreachable)
+            continue;
+
+        const event_id e = representatives[c];
+        pre[ids[c]] = a.get_precondition(e);
+
+        if (a.is_ontic(e)) {
+            post[ids[c]] = a.get_postconditions(e);
+            is_ontic.set(ids[c]);
+        }
+
+        for (del::agent ag = 0; ag < agents_number; ++ag)
+            for (const event_id d : classes_relations[ag][c])
+                q[ag][ids[c]].push_back(ids[d]);
+    }
+
+    for (const event_id ed : a.get_designated_events())
+        designated_events.emplace(ids[events_classes[ed]]);
+
+    return action{a.get_language(), a.get_type(), a.get_name(), events_number, std::move(q), std::move(pre),
+                  std::move(post), std::move(is_ontic), std::move(designated_events)};
+}
+
+state bisimulator::build_events_state(const action &a) {
+    // Events are labelled by a (syntactic) description of their preconditions and postconditions
+    std::map<std::string, label_id> labels_ids;
+    label_vector ls = label_vector(a.get_events_number());
+
+    for (event_id e = 0; e < a.get_events_number(); ++e) {
+        std::string e_label = printer::formula_printer::to_string(*a.get_precondition(e), a.get_language(), false);
+
+        if (a.is_ontic(e)) {
+            std::map<del::atom, std::string> e_post;
+
+            for (const auto &[p, f_post] : a.get_postconditions(e))
+                e_post.emplace(p, printer::formula_printer::to_string(*f_post, a.get_language(), false));
+
+            for (const auto &[p, f_post] : e_post)
+                e_label += ";" + std::to_string(p) + ":=" + f_post;
+        }
+
+        ls[e] = labels_ids.emplace(std::move(e_label), labels_ids.size()).first->second;
+    }
+
+    relations r = relations(a.get_language()->get_agents_number());
+
+    for (del::agent ag = 0; ag < a.get_language()->get_agents_number(); ++ag) {
+        r[ag] = agent_relation(a.get_events_number());
+
+        for (event_id e = 0; e < a.get_events_number(); ++e)
+            r[ag][e] = a.get_agent_possible_events(ag, e);
+    }
+
+    world_bitset designated = world_bitset(a.get_events_number());
+
+    for (const event_id ed : a.get_designated_events())
+        designated.push_back(ed);
+
+    return state{a.get_language(), a.get_events_number(), std::move(r), std::move(ls), std::move(designated)};
+}
 
 state bisimulator::disjoint_union(const kripke::state &s, const kripke::state &t) {
     unsigned long worlds_number = s.get_worlds_number() + t.get_worlds_number(), offset = s.get_worlds_number();
 
-    relations r = relations(s.get_language()->get_agents_number());
+    relations_rows r = relations_rows(s.get_language()->get_agents_number());
+    relations_rows_ids rows_ids = relations_rows_ids(s.get_language()->get_agents_number(), agent_rows_ids(worlds_number));
 
+    // The rows of t follow those of s. If both relations are equivalences, then the rows ids are the classes of the union
     for (del::agent ag = 0; ag < s.get_language()->get_agents_number(); ++ag) {
-        r[ag] = agent_relation(worlds_number);
+        const row_id rows_offset = s.get_agent_rows_number(ag);
 
-        for (world_id w = 0; w < s.get_worlds_number(); ++w) {
-            r[ag][w] = world_bitset(worlds_number);
+        if (not s.is_equivalence(ag) or not t.is_equivalence(ag)) {
+            r[ag] = agent_relation(rows_offset + t.get_agent_rows_number(ag), world_bitset(worlds_number));
+
+            for (row_id i = 0; i < s.get_agent_rows_number(ag); ++i)
+                for (const world_id v : s.get_agent_row(ag, i))
+                    r[ag][i].push_back(v);
 
-            for (auto v: s.get_agent_possible_worlds(ag, w))
-                r[ag][w].push_back(v);
+            for (row_id i = 0; i < t.get_agent_rows_number(ag); ++i)
+                for (const world_id v : t.get_agent_row(ag, i))
+                    r[ag][rows_offset + i].push_back(offset + v);
         }
 
-        for (world_id w = 0; w < t.get_worlds_number(); ++w) {
-            r[ag][offset + w] = world_bitset(worlds_number);
+        for (world_id w = 0; w < s.get_worlds_number(); ++w)
+            rows_ids[ag][w] = s.get_agent_row_id(ag, w);
 
-            for (auto v: t.get_agent_possible_worlds(ag, w))
-                r[ag][offset + w].push_back(offset + v);
-        }
+        for (world_id w = 0; w < t.get_worlds_number(); ++w)
+            rows_ids[ag][offset + w] = rows_offset + t.get_agent_row_id(ag, w);
     }
 
     label_vector ls = label_vector(worlds_number);
@@ -110,5 +422,5 @@ state bisimulator::disjoint_union(const kripke::state &s, const kripke::state &t
     for (auto w : t.get_designated_worlds())
         designated.push_back(offset + w);
 
-    return state{s.get_language(), worlds_number, std::move(r), std::move(ls), std::move(designated)};
+    return state{s.get_language(), worlds_number, std::move(r), std::move(rows_ids), std::move(ls), std::move(designated)};
 }
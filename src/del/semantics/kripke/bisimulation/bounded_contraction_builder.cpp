@@ -27,6 +27,10 @@
 #include "../../../../../include/utils/storage.h"
 #include "../../../../../include/del/semantics/kripke/bisimulation/bounded_identification.h"
 
+#include <algorithm>
+#include <unordered_map>
+#include <boost/functional/hash.hpp>
+
 using namespace kripke;
 
 std::pair<bool, state> bounded_contraction_builder::calculate_rooted_contraction(const state &s, unsigned long k, bool canonical,
@@ -35,64 +39,93 @@ std::pair<bool, state> bounded_contraction_builder::calculate_rooted_contraction
     return rooted_contraction_helper(s, k, is_bisim, structures, canonical, handler);
 }
 
-/*std::tuple<bool, state, bpr_structures> bounded_contraction_builder::update_rooted_contraction(const state &s, unsigned long k, bpr_structures &structures,
+std::tuple<bool, state, bpr_structures>
+bounded_contraction_builder::calculate_resumable_rooted_contraction(const state &s, unsigned long k, bool canonical,
+                                                                    del::storages_handler_ptr handler) {
+    auto [is_bisim, structures] = bounded_partition_refinement::do_refinement_steps(s, k);
+    auto [_, s_contr] = rooted_contraction_helper(s, k, is_bisim, structures, canonical, handler);
+
+    bounded_partition_refinement::compact(s, structures);
+    return {is_bisim, std::move(s_contr), std::move(structures)};
+}
+
+std::pair<bool, state> bounded_contraction_builder::update_rooted_contraction(const state &s, unsigned long k, bpr_structures &structures,
                                                                               bool canonical, del::storages_handler_ptr handler) {
+    // The levels do not depend on the bound, so the structures for bound k-1 only lack the level k+1
     bool is_bisim = bounded_partition_refinement::do_extra_refinement_step(s, structures);
-    return rooted_contraction_helper(s, k, is_bisim, structures, canonical, storages);
-}*/
+    auto result = rooted_contraction_helper(s, k, is_bisim, structures, canonical, handler);
 
-std::pair<bool, state> bounded_contraction_builder::calculate_standard_contraction(const state &s, del::storages_handler_ptr handler) {
-    bpr_structures structures = bounded_partition_refinement::do_all_refinement_steps(s);
-    return rooted_contraction_helper(s, s.get_max_depth() + 1, true, structures, true, handler);
+    bounded_partition_refinement::compact(s, structures);
+    return result;
 }
 
 std::pair<bool, state>
 bounded_contraction_builder::rooted_contraction_helper(const kripke::state &s, unsigned long k, bool is_bisim,
                                                        bpr_structures &structures, bool canonical,
                                                        del::storages_handler_ptr handler) {
-    const block_matrix &worlds_blocks = structures.worlds_blocks;
     // We first calculate the maximal representatives: worlds_max_reprs[x] is the maximal representative of x
-    auto worlds_max_reprs = calculate_max_representatives(s, k, worlds_blocks);
+    auto worlds_max_reprs = calculate_max_representatives(s, k, structures);
 
-    // We now create the set 'max_reprs_set' of maximal representatives out of the vector 'worlds_max_reprs'.
-    auto max_reprs_set = std::unordered_set<world_id>{worlds_max_reprs.begin(), worlds_max_reprs.end()};
-    world_id bounded_worlds_number = max_reprs_set.size();
-
-    std::vector<world_id> contracted_worlds_map = std::vector<world_id>(s.get_worlds_number());
+    // We now create the vector 'max_reprs' of maximal representatives out of the vector 'worlds_max_reprs', sorted by
+    // increasing id
     auto max_reprs_bitset = boost::dynamic_bitset<>(s.get_worlds_number());
 
-    for (const world_id x : max_reprs_set)      // We keep track in max_reprs_bitset of all maximal representatives x
-        max_reprs_bitset[x].flip();             // of our model (namely, all worlds x s.t. max_reprs_bitset[x] = 1)
+    for (const world_id x : worlds_max_reprs)
+        max_reprs_bitset[x] = true;
 
-    relations    quotient_r = relations(s.get_language()->get_agents_number());
-    label_vector quotient_v = label_vector(bounded_worlds_number);
+    std::vector<world_id> max_reprs;
+    max_reprs.reserve(max_reprs_bitset.count());
+
+    for (world_id x = max_reprs_bitset.find_first(); x != boost::dynamic_bitset<>::npos; x = max_reprs_bitset.find_next(x))
+        max_reprs.emplace_back(x);
+
+    world_id bounded_worlds_number = max_reprs.size();
+    std::vector<world_id> contracted_worlds_map = std::vector<world_id>(s.get_worlds_number());
+
+    const del::agent agents_number = s.get_language()->get_agents_number();
+    relations_rows     quotient_r = relations_rows(agents_number);
+    relations_rows_ids quotient_rows_ids = relations_rows_ids(agents_number, agent_rows_ids(bounded_worlds_number));
+    label_vector       quotient_v = label_vector(bounded_worlds_number);
 
     world_id count = 0;
 
-    for (const world_id w : max_reprs_set) {
+    for (const world_id w : max_reprs) {
         contracted_worlds_map[w] = count;
         quotient_v[count++] = s.get_label_id(w);
     }
 
-    for (del::agent ag = 0; ag < s.get_language()->get_agents_number(); ++ag) {
-        quotient_r[ag] = agent_relation(bounded_worlds_number);
+    // min_reprs[h][b] is the minimal maximal representative in the h-block b. We compute it only for the needed levels
+    std::vector<std::vector<world_id>> min_reprs = std::vector<std::vector<world_id>>(k+1);
 
-        for (world_id w = 0; w < bounded_worlds_number; ++w)
-            quotient_r[ag][w] = world_bitset(bounded_worlds_number);
-    }
+    // The edges of x in the contraction only depend on its row and on b(x), so we build them once for each such pair.
+    // Worlds with b(x) = 0 have no edges
+    std::vector<std::unordered_map<std::pair<row_id, unsigned long>, row_id, boost::hash<std::pair<row_id, unsigned long>>>>
+            rows_map(agents_number);
 
-    for (const world_id x : max_reprs_set) {
-        if (k > s.get_depth(x)) {
-            unsigned long b_x = k - s.get_depth(x);
+    for (const world_id x : max_reprs) {
+        const unsigned long b_x = k > s.get_depth(x) ? k - s.get_depth(x) : 0;
 
-            for (del::agent ag = 0; ag < s.get_language()->get_agents_number(); ++ag) {
-                for (const world_id y : s.get_agent_possible_worlds(ag, x))
-                    if (s.get_depth(y) <= k) {
-                        auto y_reprs = max_reprs_bitset & worlds_blocks[y][b_x-1]->get_bitset();    // We compute the maximal representatives of y in its (b(x)-1)-block
-                        world_id f_y = y_reprs.find_first();                                        // We take the minimal one, namely, its (b(x)-1)-canonical representative
-                        quotient_r[ag][contracted_worlds_map[x]].push_back(contracted_worlds_map[f_y]);
-                    }
+        if (b_x > 0 and min_reprs[b_x-1].empty())
+            min_reprs[b_x-1] = calculate_min_max_representatives(structures.get_level(b_x-1), max_reprs);
+
+        for (del::agent ag = 0; ag < agents_number; ++ag) {
+            const row_id r = b_x > 0 ? s.get_agent_row_id(ag, x) : 0;
+            const auto [it, is_new] = rows_map[ag].try_emplace({r, b_x}, quotient_r[ag].size());
+
+            if (is_new) {
+                world_bitset &row = quotient_r[ag].emplace_back(bounded_worlds_number);
+
+                if (b_x > 0) {
+                    const level_blocks &blocks = structures.get_level(b_x-1);
+
+                    for (const world_id y : s.get_agent_row(ag, r))
+                        if (s.get_depth(y) <= k) {
+                            world_id f_y = min_reprs[b_x-1][blocks[y]];     // The (b(x)-1)-canonical representative of y
+                            row.push_back(contracted_worlds_map[f_y]);
+                        }
+                }
             }
+            quotient_rows_ids[ag][contracted_worlds_map[x]] = it->second;
         }
     }
 
@@ -103,7 +136,8 @@ bounded_contraction_builder::rooted_contraction_helper(const kripke::state &s, u
 
     auto state_id = canonical ? bounded_identification::calculate_state_id(s, k, handler) : 0;
 
-    return {is_bisim, state{s.get_language(), bounded_worlds_number, std::move(quotient_r), std::move(quotient_v), std::move(designated_worlds), state_id}};
+    return {is_bisim, state{s.get_language(), bounded_worlds_number, std::move(quotient_r), std::move(quotient_rows_ids),
+                            std::move(quotient_v), std::move(designated_worlds), state_id}};
 }
 
 /*
@@ -176,30 +210,66 @@ bounded_contraction_builder::calculate_canonical_contraction(const state &s, uns
 */
 
 std::vector<world_id> bounded_contraction_builder::calculate_max_representatives(const state &s, unsigned long k,
-                                                                                 const block_matrix &worlds_blocks) {
+                                                                                 const bpr_structures &structures) {
     auto worlds_max_reprs = std::vector<world_id>(s.get_worlds_number());
     std::queue<world_id> to_visit;
-    boost::dynamic_bitset<> represented(s.get_worlds_number());
+    boost::dynamic_bitset<> represented(s.get_worlds_number()), queued(s.get_worlds_number());
+
+    // The worlds of the blocks of each level, and the blocks that were already processed. We only compute them for the
+    // levels that we visit
+    std::vector<level_members> members = std::vector<level_members>(k+1);
+    std::vector<boost::dynamic_bitset<>> processed = std::vector<boost::dynamic_bitset<>>(k+1);
 
     // We first build 'worlds_max_reprs' with a BFS visit.
     // Queue 'to_visit' contains world_ids of the preprocessed state that still have not been visited.
     // We visit worlds from higher to lower depth. Thus, we start with the designated worlds
-    for (const world_id wd : s.get_designated_worlds())
+    for (const world_id wd : s.get_designated_worlds()) {
         to_visit.push(wd);
+        queued[wd] = true;
+    }
 
     while (not to_visit.empty()) {
         world_id current = to_visit.front();
         to_visit.pop();
 
-        const block_ptr &block = worlds_blocks[current][k - s.get_depth(current)];
+        const unsigned long h = k - s.get_depth(current);
+        const block_id b = structures.get_level(h)[current];
+
+        if (members[h].offsets.empty()) {
+            members[h] = bounded_partition_refinement::calculate_members(structures.get_level(h));
+            processed[h] = boost::dynamic_bitset<>(members[h].offsets.size() - 1);
+        }
+
+        if (not processed[h][b]) {                  // All worlds of a processed block are already represented
+            processed[h][b] = true;
 
-        world_id max_representative = get_block_max_representative(s, block);                           // We calculate the maximal representative of 'current', i.e., the world in 'block' with higher bound
-        update_block_max_representative(s, block, max_representative, represented, worlds_max_reprs);   // We update the maximal representative of the worlds in block
-        update_to_visit_worlds(s, k, to_visit, current, represented);                                   // We add the next worlds to process into the to_visit queue
+            world_id max_representative = get_block_max_representative(s, members[h], b);                       // We calculate the maximal representative of 'current', i.e., the world in its block with higher bound
+            update_block_max_representative(members[h], b, max_representative, represented, worlds_max_reprs);  // We update the maximal representative of the worlds in the block
+        }
+        update_to_visit_worlds(s, k, to_visit, current, represented, queued);                                   // We add the next worlds to process into the to_visit queue
     }
     return worlds_max_reprs;
 }
 
+std::vector<world_id> bounded_contraction_builder::calculate_min_max_representatives(const level_blocks &blocks,
+                                                                                     const std::vector<world_id> &max_reprs) {
+    // Every block that we look up contains a maximal representative, so we only need the blocks of the representatives.
+    // This way, the table of each level is built in O(|max_reprs|) time, regardless of the size of the state
+    block_id blocks_number = 0;
+
+    for (const world_id x : max_reprs)
+        blocks_number = std::max(blocks_number, blocks[x] + 1);
+
+    auto min_reprs = std::vector<world_id>(blocks_number, blocks.size());
+
+    // We scan the maximal representatives by increasing id, so the first one we meet in a block is the minimal one
+    for (const world_id x : max_reprs)
+        if (min_reprs[blocks[x]] == blocks.size())
+            min_reprs[blocks[x]] = x;
+
+    return min_reprs;
+}
+
 /*std::tuple<signature_matrix, signature_vector, signature_map, std::vector<world_id>>
 bounded_contraction_builder::calculate_max_signatures(const state &s, unsigned long k, del::storages_handler_ptr handler) {
     auto worlds_max_signs = signature_vector(s.get_worlds_number());
@@ -231,20 +301,23 @@ bounded_contraction_builder::calculate_max_signatures(const state &s, unsigned l
     return {std::move(worlds_signatures), std::move(worlds_max_signs), std::move(sign_map), std::move(worlds_max_reprs)};
 }*/
 
-world_id bounded_contraction_builder::get_block_max_representative(const state &s, const block_ptr &block) {
-    world_id max_representative = *block->begin();
+world_id bounded_contraction_builder::get_block_max_representative(const state &s, const level_members &members, const block_id b) {
+    world_id max_representative = members.worlds[members.offsets[b]];
 
-    for (const world_id w : *block)
-        if (s.get_depth(w) < s.get_depth(max_representative))   // Equivalent to: b(w) >= b(max_representative)
-            max_representative = w;
+    for (world_id i = members.offsets[b]; i < members.offsets[b+1]; ++i)
+        if (s.get_depth(members.worlds[i]) < s.get_depth(max_representative))   // Equivalent to: b(w) >= b(max_representative)
+            max_representative = members.worlds[i];
 
     return max_representative;
 }
 
-void bounded_contraction_builder::update_block_max_representative(const state &s, const block_ptr &block, world_id max_representative,
-                                                                  boost::dynamic_bitset<> &represented, std::vector<world_id> &worlds_max_reprs) {
-    // If a world in 'block' is not yet represented, we set its maximal representative
-    for (const world_id w : *block) {
+void bounded_contraction_builder::update_block_max_representative(const level_members &members, const block_id b,
+                                                                  world_id max_representative, boost::dynamic_bitset<> &represented,
+                                                                  std::vector<world_id> &worlds_max_reprs) {
+    // If a world in the block is not yet represented, we set its maximal representative
+    for (world_id i = members.offsets[b]; i < members.offsets[b+1]; ++i) {
+        const world_id w = members.worlds[i];
+
         if (not represented[w]) {
             worlds_max_reprs[w] = max_representative;
             represented[w] = true;
@@ -277,11 +350,15 @@ void bounded_contraction_builder::update_block_max_representative(const state &s
 }*/
 
 void bounded_contraction_builder::update_to_visit_worlds(const state &s, unsigned long k, std::queue<world_id> &to_visit,
-                                                         world_id current, boost::dynamic_bitset<> &represented) {
+                                                         world_id current, const boost::dynamic_bitset<> &represented,
+                                                         boost::dynamic_bitset<> &queued) {
     // We visit unrepresented worlds that are directly accessible from 'current'. In this way,
-    // we implement a visit by descending depth.
+    // we implement a visit by descending depth. Each world is queued at most once: visiting it again would only queue
+    // again the worlds that are already waiting in the queue, which blows up the queue on deep states
     for (del::agent ag = 0; ag < s.get_language()->get_agents_number(); ++ag)
         for (const world_id w : s.get_agent_possible_worlds(ag, current))
-            if (s.get_depth(w) <= k and not represented[w])
+            if (s.get_depth(w) <= k and not represented[w] and not queued[w]) {
                 to_visit.push(w);
+                queued[w] = true;
+            }
 }
@@ -24,6 +24,9 @@
 #include "../../../../../include/del/semantics/kripke/bisimulation/bounded_identification.h"
 #include "../../../../../include/del/semantics/kripke/states/state.h"
 #include "../../../../../include/utils/storage.h"
+#include "../../../../../include/utils/thread_pool.h"
+#include <algorithm>
+#include <boost/dynamic_bitset.hpp>
 
 using namespace kripke;
 
@@ -42,16 +45,16 @@ bounded_identification::calculate_signatures(const state &s, unsigned long k, de
 }*/
 
 information_state_id bounded_identification::calculate_state_id(const kripke::state &s, unsigned long k, del::storages_handler_ptr &handler) {
-    auto worlds_signatures = signature_matrix(k+1);
-    information_state designated_signatures;
-
-    for (auto &h_signatures : worlds_signatures)
-        h_signatures = signature_vector(s.get_worlds_number());
+    const signature_vector worlds_signatures = calculate_signatures(s, k, handler);
+    signature_vector designated_signatures = {k};
 
     for (const world_id wd : s.get_designated_worlds())
-        designated_signatures.emplace(calculate_world_signature(s, wd, k, handler, worlds_signatures));
+        designated_signatures.emplace_back(worlds_signatures[wd]);
 
-    return handler->get_information_state_storage(k).emplace(std::move(designated_signatures));
+    // We keep the bound in the key, so that states identified with different bounds never share the same id
+    std::sort(designated_signatures.begin() + 1, designated_signatures.end());
+    designated_signatures.erase(std::unique(designated_signatures.begin() + 1, designated_signatures.end()), designated_signatures.end());
+    return handler->get_state_vector_storage().emplace(std::move(designated_signatures));
 }
 
 /*void bounded_identification::calculate_world_signature(const state &s, const unsigned long k, const world_id x,
@@ -90,34 +93,87 @@ information_state_id bounded_identification::calculate_state_id(const kripke::st
     }
 }*/
 
-signature_id bounded_identification::calculate_world_signature(const state &s, const world_id x, const unsigned long h,
-                                                               del::storages_handler_ptr &handler,
-                                                               signature_matrix &worlds_signatures) {
-//    auto xss = std::deque<agents_information_state>(h+1);
-//
-//    for (auto &xs : xss) {
-        auto xs = agents_information_state(s.get_language()->get_agents_number());
-//    signature_id empty_is = is_storage->emplace(information_state{});
+signature_vector bounded_identification::calculate_signatures(const state &s, const unsigned long k,
+                                                               del::storages_handler_ptr &handler) {
+    const auto [worlds, layers_ends] = calculate_layers(s, k);
+    const auto agents_number = s.get_language()->get_agents_number();
 
-        for (del::agent ag = 0; ag < s.get_language()->get_agents_number(); ++ag)
-            xs[ag] = 0;
-//    }
+    auto signatures = signature_vector(s.get_worlds_number()), next_signatures = signature_vector(s.get_worlds_number());
 
-    if (h > 0)
-        for (del::agent ag = 0; ag < s.get_language()->get_agents_number(); ++ag) {
-            information_state x_ag;
+    for (unsigned long i = 0; i < layers_ends[k]; ++i)
+        signatures[worlds[i]] = handler->get_signature_vector_storage(0).emplace({s.get_label_id(worlds[i])});
 
-            for (const world_id y : s.get_agent_possible_worlds(ag, x)) {
-                if (handler->get_signature_storage(h).is_null(worlds_signatures[h-1][y]))    // We check that we did not already calculate y's (h-1)-signature
-                    worlds_signatures[h-1][y] = calculate_world_signature(s, y, h-1, handler, worlds_signatures);
+    for (unsigned long h = 1; h <= k; ++h) {
+        const unsigned long worlds_number = layers_ends[k-h];   // The h-signatures are needed only up to distance k-h
+        auto keys = std::vector<std::vector<signature_id>>(worlds_number);
 
-                x_ag.emplace(worlds_signatures[h-1][y]);
+        // The key of x is [label, then for each agent the number of distinct (h-1)-signatures of the successors of x,
+        // followed by these signatures in increasing order]. Keys are independent, so we build them in parallel
+        auto calculate_keys = [&](const unsigned long first, const unsigned long last) {
+            for (unsigned long i = first; i < last; ++i) {
+                const world_id x = worlds[i];
+                std::vector<signature_id> &key = keys[i];
+                key.emplace_back(s.get_label_id(x));
+
+                for (del::agent ag = 0; ag < agents_number; ++ag) {
+                    const std::size_t count_pos = key.size();
+                    key.emplace_back(0);
+
+                    for (const world_id y : s.get_agent_possible_worlds(ag, x))
+                        key.emplace_back(signatures[y]);
+
+                    std::sort(key.begin() + count_pos + 1, key.end());
+                    key.erase(std::unique(key.begin() + count_pos + 1, key.end()), key.end());
+                    key[count_pos] = key.size() - count_pos - 1;
+                }
             }
-            xs[ag] = handler->get_information_state_storage(h).emplace(std::move(x_ag));     // xss[h][ag] is the numerical id referring to the set of
-        }                                                                                       // (h-1)-signatures of the worlds y such that x R_ag y
+        };
+
+        if (worlds_number < min_parallel_worlds_number)
+            calculate_keys(0, worlds_number);
+        else
+            thread_pool::get_instance().parallel_for(0, worlds_number, calculate_keys);
+
+        // Interning is sequential, since the storage of each level is shared by all states
+        auto &storage = handler->get_signature_vector_storage(h);
+
+        for (unsigned long i = 0; i < worlds_number; ++i)
+            next_signatures[worlds[i]] = storage.emplace(std::move(keys[i]));
+
+        std::swap(signatures, next_signatures);
+    }
+
+    return signatures;
+}
+
+std::pair<std::vector<world_id>, std::vector<unsigned long>>
+bounded_identification::calculate_layers(const state &s, const unsigned long k) {
+    std::vector<world_id> worlds;
+    auto layers_ends = std::vector<unsigned long>(k+1);
+    auto visited = boost::dynamic_bitset<>(s.get_worlds_number());
+
+    for (const world_id wd : s.get_designated_worlds()) {
+        worlds.emplace_back(wd);
+        visited[wd] = true;
+    }
+
+    unsigned long first = 0;
+
+    for (unsigned long d = 0; d <= k; ++d) {
+        const unsigned long last = worlds.size();
+        layers_ends[d] = last;
+
+        if (d < k)
+            for (unsigned long i = first; i < last; ++i)
+                for (del::agent ag = 0; ag < s.get_language()->get_agents_number(); ++ag)
+                    for (const world_id y : s.get_agent_possible_worlds(ag, worlds[i]))
+                        if (not visited[y]) {
+                            worlds.emplace_back(y);
+                            visited[y] = true;
+                        }
+
+        first = last;
+    }
 
-    auto sign_x_h = signature{s.get_language(), handler, s.get_label_id(x), std::move(xs), h, x};   // We create the h-signature of x (h being x's bound),
-    auto id = handler->get_signature_storage(h).emplace(std::move(sign_x_h));                                        // we add it to the storage, and we return it
-    assert(id != 0);
-    return id;
+    return {std::move(worlds), std::move(layers_ends)};
 }
@@ -24,6 +24,7 @@
 #include "../../../../../include/del/semantics/kripke/bisimulation/bounded_partition_refinement.h"
 #include "../../../../../include/del/semantics/kripke/states/state.h"
 #include "../../../../../include/search/search_space.h"
+#include <algorithm>
 #include <memory>
 #include <utility>
 
@@ -39,192 +40,141 @@ std::pair<bool, bpr_structures> bounded_partition_refinement::do_refinement_step
 }
 
 bool bounded_partition_refinement::do_extra_refinement_step(const state &s, bpr_structures &structures) {
-    unsigned long k = structures.Q.size();
+    const unsigned long k = structures.k + 1;
+    restore_structures(s, structures);
+    structures.levels.emplace_back();
 
-    structures.Q.emplace_back();
+    const bool is_split = do_refinement_step(s, k-1, structures);
+    save_level(k, structures);
+    structures.k = k;
 
-    for (world_id x = 0; x < s.get_worlds_number(); ++x)
-        structures.worlds_blocks[x].emplace_back();
+    return not is_split and s.get_max_depth() < k-1;
+}
 
-    do_refinement_step(s, k, k-1, structures);
+std::optional<std::pair<world_id, std::vector<world_id>>>
+bounded_partition_refinement::calculate_classes(const state &s, const unsigned long max_steps) {
+    bpr_structures structures = init_structures(s, 0);
+    bool is_split = true;
+    unsigned long h = 0;
 
-    return structures.Q[k].size() == structures.Q[k-1].size() and s.get_max_depth() < k-1;
-}
+    // We only need the current level, so each step saves it in the first (and only) slot
+    for (; is_split and h < max_steps; ++h) {
+        structures.first_level = h;
+        is_split = do_refinement_step(s, h, structures);
+    }
 
-bpr_structures bounded_partition_refinement::do_all_refinement_steps(const state &s) {
-    unsigned long k = s.get_max_depth() + 1;
-    bpr_structures structures = init_structures(s, k);
+    if (is_split)
+        return std::nullopt;
 
-    refinement_step_helper(s, k, structures);
-    return std::move(structures);
-}
+    const pt_vector &blocks = structures.Q.get_blocks();
+    return std::make_pair(structures.Q.get_blocks_number(), std::vector<world_id>(blocks.begin(), blocks.end()));
+}   // Complexity: O(L * (|W| + |R|)), where L is the number of steps needed to reach a stable partition
 
 void bounded_partition_refinement::refinement_step_helper(const state &s, unsigned long k, bpr_structures &structures) {
     unsigned long h = 0;
+    bool is_split = true;
 
-    do do_refinement_step(s, k, h, structures);
-    while (++h < k and structures.Q[h].size() != structures.Q[h-1].size());   // If no block was split, then we are done
+    for (; h < k and is_split; ++h)             // If no block was split, then we are done
+        is_split = do_refinement_step(s, h, structures);
 
-    while (h < k)
-        copy_partition(s, k, h++, structures.Q, structures.worlds_blocks, structures.count);
+    for (; h <= k; ++h)                         // The remaining levels are all equal to the last one
+        save_level(h, structures);
 }
 
-void bounded_partition_refinement::do_refinement_step(const state &s, unsigned long k, unsigned long h,
-                                                      bpr_structures &structures) {
-    copy_partition(s, k, h, structures.Q, structures.worlds_blocks, structures.count);
-
-    for (const block_ptr &B: structures.Q[h])                      // We refine Q[h] wrt. all of its blocks
-        refine(s, k, h, structures.Q, B, structures.r_1, structures.worlds_blocks, structures.count);
-}
-
-void bounded_partition_refinement::copy_partition(const state &s, const unsigned long k, const unsigned long h,
-                                                  partition &Q, block_matrix &worlds_blocks, block_id &count) {
-    // We copy Q[h] into Q[h+1] in such a way that, after the copy, Q[h+1] will contain the original pointers to the
-    // blocks of Q[h]. In this way, we guarantee that each block_ptr B = worlds_blocks[x][h+1] (and not a copy with
-    // different pointer address) is in Q[h+1]. For this reason, we first move Q[h] into Q[h+1], so to preserve the
-    // correct pointer addresses into Q[h+1].
-    Q[h+1] = std::move(Q[h]);
-    // Then, we copy the elements of Q[h+1] back into Q[h]. As a result, Q[h] will contain block_ptrs with different
-    // addresses, but with the same pointed blocks
-    for (const block_ptr &B : Q[h+1]) {
-        block_ptr B_copy = std::make_shared<block>(*B);
-        B->set_id(count++);
-
-        for (const world_id x : *B) {
-            if (h < worlds_blocks[x].size())    // We keep track of the h-block of x. A copy is necessary to avoid
-                worlds_blocks[x][h] = B_copy;   // unwanted splitting of already calculated blocks
-
-            if (k > h + s.get_depth(x))         // If x still needs to be split, we update its (h+1)-block (i.e., its
-                worlds_blocks[x][h+1] = B;      // (h+1)-bisimulation class), preparing it for further splitting
+bool bounded_partition_refinement::do_refinement_step(const state &s, const unsigned long h, bpr_structures &structures) {
+    // We compute the (h+1)-partition by refining the h-partition wrt. all of its blocks. Since the refinement is done
+    // in place, we first save the h-partition and a copy of its elements
+    save_level(h, structures);
+
+    refinable_partition &Q = structures.Q;
+    const relations_preimage &r_1 = structures.r_1;
+    const pt_id blocks_number = Q.get_blocks_number();
+    const pt_vector elements = Q.get_elements();
+    const level_blocks &blocks = structures.get_level(h);
+
+    for (pt_id first = 0, end; first < elements.size(); first = end) {
+        // [From STEP 3] The elements of B are in [first, end). We copy them into B', so that B can be split wrt. itself
+        for (end = first; end < elements.size() and blocks[elements[end]] == blocks[elements[first]]; ++end);
+
+        for (del::agent ag = 0; ag < r_1.agents_number; ++ag) {
+            // [STEP 4] Refine Q wrt. B
+            for (pt_id i = first; i < end; ++i)
+                for (pt_id e = r_1.begin(elements[i], ag); e < r_1.end(elements[i], ag); ++e)
+                    Q.mark(r_1.sources[e]);
+            Q.split();
         }
-        Q[h].push_back(std::move(B_copy));
     }
-}   // Complexity: O(|W|)
+    return Q.get_blocks_number() != blocks_number;
+}   // Complexity: O(|W| + |R|)
 
-void bounded_partition_refinement::refine(const state &s, const unsigned long k, const unsigned long h, partition &Q,
-                                          const block_ptr &B, const relations &r_1, block_matrix &worlds_blocks,
-                                          block_id &count) {
-    // [From STEP 3] Copy the elements of B into a temporary set B'. (This facilitates splitting B with respect to
-    // itself during the refinement.)
-    block B_ = *B;
+void bounded_partition_refinement::save_level(const unsigned long h, bpr_structures &structures) {
+    const pt_vector &blocks = structures.Q.get_blocks();
+    structures.levels[h - structures.first_level].assign(blocks.begin(), blocks.end());
+}   // Complexity: O(|W|)
 
-    for (del::agent ag = 0; ag < s.get_language()->get_agents_number(); ++ag) {
-        block B_preimage = calculate_preimages(s, B_, r_1, ag);
+void bounded_partition_refinement::compact(const state &s, bpr_structures &structures) {
+    // The rooted contraction wrt. bound k only looks at the levels k - d and k - d - 1 of the worlds of depth d
+    const unsigned long first_level = structures.k > s.get_max_depth() + 1 ? structures.k - s.get_max_depth() - 1 : 0;
 
-        // [STEP 4] Refine Q with respect to B
-        if (not B_preimage.empty())
-            split(s, k, h, Q, B_preimage, worlds_blocks, count);
+    if (first_level > structures.first_level) {
+        structures.levels.erase(structures.levels.begin(), structures.levels.begin() + (first_level - structures.first_level));
+        structures.first_level = first_level;
     }
+
+    structures.Q = refinable_partition{};
+    structures.r_1 = relations_preimage{};
 }
 
-block bounded_partition_refinement::calculate_preimages(const state &s, const block &B_, const relations &r_1,
-                                                        const del::agent ag) {
-//    boost::dynamic_bitset<> B_preimage(s.get_worlds_number());
-//
-//    for (const world_id y: B_)
-//        B_preimage |= s.get_agent_possible_worlds(ag, y);   // todo: this way we don't use r_1!!!!!
-//
-//    return block{B_preimage};
-    block B_preimage = block(s.get_worlds_number());
+unsigned long bounded_partition_refinement::get_memory_usage(const bpr_structures &structures) {
+    unsigned long memory = sizeof(bpr_structures) + structures.Q.get_memory_usage() + structures.r_1.get_memory_usage();
 
-    for (const world_id y: B_)
-        for (const world_id x: r_1[ag][y])
-            // [From STEP 3] Compute R^-1(B).
-            B_preimage.push_back(x);
+    for (const level_blocks &blocks : structures.levels)
+        memory += blocks.capacity() * sizeof(block_id);
 
-    return B_preimage;
+    return memory;
 }
 
-void bounded_partition_refinement::split(const state &s, const unsigned long k, const unsigned long h, partition &Q,
-                                         const block &block_preimage, block_matrix &worlds_blocks, block_id &count) {
-    split_blocks_map split_blocks;
-    // [From STEP 4] For each block D of Q containing some element of R^-1(B), split D into D_1 = D \cap R^-1(B)
-    // and D_2 = D \ D_1. Do this by scanning the elements of R^-1(B) [i.e., block_preimage].
-    // [From STEP 6] Proceed exactly as in Step 4 but scan R^-1(B) \ R^-1(S \ B) (computed in step 5) instead of R^-1(B).
-    for (const world_id x: block_preimage) {
-        if (k > h + s.get_depth(x)) {
-            // To process an element x \in R^-1(B), determine the block D of Q containing it...
-            block_ptr D = worlds_blocks[x][h+1];
-
-            // ...and create an associated block D' if one does not already exist.
-            if (split_blocks.find(D) == split_blocks.end())
-                split_blocks[D] = Q[h+1].emplace_back(std::make_shared<block>(block{s.get_worlds_number(), count++}));
-
-            // We move x from D to D'
-            block_ptr D_ = split_blocks[D];
-            D_->push_back(x);
-            D->remove(x);
-            worlds_blocks[x][h+1] = D_;
-        }
-    }
-    // After the scanning, process the list of split blocks. For each such block D with associated block D'...
-    for (auto &[D, D_]: split_blocks)
-        if (D->empty())
-            Q[h+1].erase(std::find(Q[h+1].begin(), Q[h+1].end(), D));
-//            Q[h+1].remove(D);
-}
+level_members bounded_partition_refinement::calculate_members(const level_blocks &blocks) {
+    // Counting sort of the worlds by block. Complexity: O(|W|)
+    const block_id blocks_number = blocks.empty() ? 0 : *std::max_element(blocks.begin(), blocks.end()) + 1;
+    level_members members{std::vector<world_id>(blocks_number + 1, 0), std::vector<world_id>(blocks.size())};
 
-bpr_structures bounded_partition_refinement::init_structures(const state &s, unsigned long long k) {
-    partition Q;
-    block_matrix worlds_blocks;
-    relations r_1 = init_preimage(s);
-    block_id count = 0;
-    std::map<const label_id, block_ptr> initial_partition;
+    for (const block_id b : blocks)
+        ++members.offsets[b+1];
 
-    Q = partition{k + 1};
-    worlds_blocks = block_matrix(s.get_worlds_number());
+    for (block_id b = 0; b < blocks_number; ++b)
+        members.offsets[b+1] += members.offsets[b];
 
-    for (world_id x = 0; x < s.get_worlds_number(); ++x)
-        worlds_blocks[x] = block_vector(k+1);
-//        if (k >= s.get_depth(x))                                       // If bound(x) >= 0, we create a block_vector v of
-//            worlds_blocks[x] = block_vector(k - s.get_depth(x) + 1);   // size bound(x)+1, and we let worlds_blocks[x] = v
-//        else
-//            worlds_blocks[x] = block_vector(0);
+    std::vector<world_id> positions = std::vector<world_id>(members.offsets.begin(), members.offsets.end() - 1);
 
-    // Initializing initial partition. Here we split worlds depending on their propositional valuation.
-    // In each q_block we insert worlds sharing the same valuation.
-    for (world_id x = 0; x < s.get_worlds_number(); ++x)
-        if (k >= s.get_depth(x))        // Namely, b(x) >= 0
-            init_partitions_helper(s, initial_partition, x, worlds_blocks, count);
-    // Complexity: O(|P|*|W|)
+    for (world_id x = 0; x < blocks.size(); ++x)
+        members.worlds[positions[blocks[x]]++] = x;
 
-    // Initializing Q
-    for (auto &[val, b]: initial_partition)
-        Q[0].push_back(std::move(b));
-    // Complexity: O(|W|)
-
-    return bpr_structures{std::move(Q), std::move(worlds_blocks), std::move(r_1), count};
-}   // Complexity: O(|P|*|W|)
-
-void bounded_partition_refinement::init_partitions_helper(const state &s, std::map<const label_id, block_ptr> &partition,
-                                                          world_id w, block_matrix &worlds_blocks, block_id &count) {
-    const auto it = partition.find(s.get_label_id(w));
-
-    if (it == partition.end()) {
-        block_ptr b = std::make_shared<block>(block{s.get_worlds_number(), world_set{w}, count++});
-        worlds_blocks[w][0] = b;
-        partition.emplace(s.get_label_id(w), std::move(b));
-    } else {
-        block_ptr &b = it->second;
-        b->push_back(w);
-        worlds_blocks[w][0] = b;
-    }
-}   // Complexity: O(|P|)
+    return members;
+}
 
-relations bounded_partition_refinement::init_preimage(const state &s) {
-    relations r_1 = relations(s.get_language()->get_agents_number());
+bpr_structures bounded_partition_refinement::init_structures(const state &s, unsigned long long k) {
+    // Initializing initial partition. Here we split worlds depending on their propositional valuation.
+    // Complexity: O(|P|*|W|)
+    std::map<label_id, pt_id> initial_blocks;
+    pt_vector worlds_blocks = pt_vector(s.get_worlds_number());
 
-    for (del::agent ag = 0; ag < s.get_language()->get_agents_number(); ++ag) {
-        agent_relation r_ag = agent_relation(s.get_worlds_number());
+    for (world_id x = 0; x < s.get_worlds_number(); ++x)
+        worlds_blocks[x] = initial_blocks.emplace(s.get_label_id(x), initial_blocks.size()).first->second;
 
-        for (world_id w = 0; w < s.get_worlds_number(); ++w)    // Initializing world sets
-            r_ag[w] = world_bitset(s.get_worlds_number());
+    return bpr_structures{k, refinable_partition{worlds_blocks, initial_blocks.size()}, levels_blocks(k+1),
+                          relations_preimage{s}};
+}   // Complexity: O(|P|*|W| + |R|)
 
-        for (world_id w = 0; w < s.get_worlds_number(); ++w)
-            for (const world_id v: s.get_agent_possible_worlds(ag, w))
-                r_ag[v].push_back(w);
+void bounded_partition_refinement::restore_structures(const state &s, bpr_structures &structures) {
+    // If the structures were compacted, we rebuild Q from the last level and r_1 from s. Complexity: O(|W| + |R|)
+    if (structures.Q.get_blocks_number() == 0) {
+        const level_blocks &blocks = structures.levels.back();
+        const block_id blocks_number = blocks.empty() ? 0 : *std::max_element(blocks.begin(), blocks.end()) + 1;
 
-        r_1[ag] = std::move(r_ag);
+        structures.Q = refinable_partition{pt_vector(blocks.begin(), blocks.end()), blocks_number};
     }
-    return r_1;
-}   // Complexity: O(|R|)
+
+    if (structures.r_1.empty())
+        structures.r_1 = relations_preimage{s};
+}
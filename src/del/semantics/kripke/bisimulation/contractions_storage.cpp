@@ -0,0 +1,73 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../../../../include/del/semantics/kripke/bisimulation/contractions_storage.h"
+#include "../../../../../include/del/semantics/kripke/bisimulation/bisimulator.h"
+#include "../../../../../include/del/semantics/kripke/states/state.h"
+#include "../../../../../include/utils/thread_pool.h"
+#include <algorithm>
+#include <boost/functional/hash.hpp>
+#include <memory>
+
+using namespace kripke;
+
+state_id contractions_storage::emplace(const state &s) {
+    // Isomorphic states have the same number of worlds and bisimilar states have the same fingerprints
+    std::size_t key = bisimulator::calculate_fingerprint(s, std::min(s.get_max_depth() + 1, fingerprint_bound));
+    boost::hash_combine(key, s.get_worlds_number());
+
+    const auto lock = thread_pool::lock_if_concurrent<std::unique_lock<std::mutex>>(m_mutex);
+    bucket &states = m_buckets[key];
+
+    for (const auto &[t, id] : states)
+        if (bisimulator::are_bisimilar(s, *t))
+            return id;
+
+    states.emplace_back(copy(s), ++m_count);
+    return m_count;
+}   // Complexity: O(k * (|W| + |R|) * log(|W|)), plus O((|W| + |R|) * log(|W|)) for each state in the bucket of s
+
+state_ptr contractions_storage::copy(const state &s) {
+    const world_id worlds_number = s.get_worlds_number();
+    const del::agent agents_number = s.get_language()->get_agents_number();
+
+    relations_rows rows = relations_rows(agents_number);
+    relations_rows_ids rows_ids = relations_rows_ids(agents_number, agent_rows_ids(worlds_number));
+    label_vector labels = label_vector(worlds_number);
+
+    // The classes of equivalences are passed as they are
+    for (del::agent ag = 0; ag < agents_number; ++ag) {
+        if (not s.is_equivalence(ag))
+            for (row_id r = 0; r < s.get_agent_rows_number(ag); ++r)
+                rows[ag].push_back(s.get_agent_row(ag, r).to_bitset(worlds_number));
+
+        for (world_id w = 0; w < worlds_number; ++w)
+            rows_ids[ag][w] = s.get_agent_row_id(ag, w);
+    }
+
+    for (world_id w = 0; w < worlds_number; ++w)
+        labels[w] = s.get_label_id(w);
+
+    return std::make_shared<state>(s.get_language(), worlds_number, std::move(rows), std::move(rows_ids),
+                                   std::move(labels), s.get_designated_worlds(), s.get_id());
+}
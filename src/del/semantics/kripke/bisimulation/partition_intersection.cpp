@@ -0,0 +1,91 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "../../../../../include/del/semantics/kripke/bisimulation/partition_intersection.h"
+#include "../../../../../include/del/semantics/kripke/states/state.h"
+#include <algorithm>
+#include <boost/functional/hash.hpp>
+#include <cassert>
+#include <unordered_map>
+
+using namespace kripke;
+
+std::optional<std::pair<world_id, std::vector<world_id>>>
+partition_intersection::calculate_classes(const state &s, const unsigned long max_steps) {
+    assert(s.is_partitioned());
+
+    using signatures_map = std::unordered_map<std::vector<world_id>, world_id, boost::hash<std::vector<world_id>>>;
+
+    const auto agents_number = s.get_language()->get_agents_number();
+    const world_id worlds_number = s.get_worlds_number();
+
+    std::vector<world_id> blocks(worlds_number), next_blocks(worlds_number), signature;
+    std::vector<std::vector<world_id>> classes_blocks(agents_number);
+    std::unordered_map<label_id, world_id> labels_blocks;
+    signatures_map signatures;
+
+    // The initial partition groups the worlds by their labels
+    for (world_id w = 0; w < worlds_number; ++w)
+        blocks[w] = labels_blocks.emplace(s.get_label_id(w), labels_blocks.size()).first->second;
+
+    world_id blocks_number = labels_blocks.size();
+
+    for (unsigned long step = 0; step < max_steps; ++step) {
+        // classes_blocks[ag][c] identifies the set of blocks of the worlds of class c
+        for (del::agent ag = 0; ag < agents_number; ++ag) {
+            classes_blocks[ag].resize(s.get_agent_rows_number(ag));
+            signatures.clear();
+
+            for (row_id c = 0; c < s.get_agent_rows_number(ag); ++c) {
+                signature.clear();
+
+                for (const world_id v : s.get_agent_row(ag, c))
+                    signature.push_back(blocks[v]);
+
+                std::sort(signature.begin(), signature.end());
+                signature.erase(std::unique(signature.begin(), signature.end()), signature.end());
+                classes_blocks[ag][c] = signatures.emplace(signature, signatures.size()).first->second;
+            }
+        }
+
+        signatures.clear();
+
+        for (world_id w = 0; w < worlds_number; ++w) {
+            signature.assign(1, blocks[w]);
+
+            for (del::agent ag = 0; ag < agents_number; ++ag)
+                signature.push_back(classes_blocks[ag][s.get_agent_row_id(ag, w)]);
+
+            next_blocks[w] = signatures.emplace(signature, signatures.size()).first->second;
+        }
+
+        // Every new block is contained in an old one, so the partition is stable iff no block was split
+        if (signatures.size() == blocks_number)
+            return std::make_pair(blocks_number, std::move(blocks));
+
+        blocks_number = signatures.size();
+        std::swap(blocks, next_blocks);
+    }
+    return std::nullopt;
+}
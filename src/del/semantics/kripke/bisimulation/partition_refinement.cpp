@@ -21,10 +21,13 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+
 #include "../../../../../include/del/semantics/kripke/bisimulation/partition_refinement.h"
 #include "../../../../../include/del/semantics/kripke/bisimulation/bisimulator.h"
 #include "../../../../../include/search/search_space.h"
+#include "boost/dynamic_bitset.hpp"
 #include <algorithm>
+#include <map>
 #include <memory>
 
 using namespace kripke;
@@ -41,364 +44,177 @@ bool partition_refinement::contract(search::node_ptr &n) {
 }
 
 std::pair<bool, state> partition_refinement::contraction_helper(const state &s) {
-    auto result = build_preprocessed_state(s);          // todo: try to generate the preprocessed relations on the fly
-    const agent_relation &r = result.first;
-    const agent_worlds_labels labels = result.second;
-    const world_id preprocessed_worlds_no = r.size();
-
-    q_partition Q, Q_sinks;
-    x_partition X;
-    compound_x_blocks_set C;
-    agent_relation r_preimage;                                          // Preimage of R
-    q_block_ptr_vector worlds_blocks = q_block_ptr_vector(preprocessed_worlds_no);    // Each element points to the block of Q containing it.
+    const auto [worlds_number, classes] = calculate_classes(s);
+    return {true, build_full_contraction(s, worlds_number, classes)};
+}
 
-    init_data_structures(s, r, labels, Q, Q_sinks, X, C, worlds_blocks, r_preimage, preprocessed_worlds_no);
+std::pair<world_id, std::vector<world_id>> partition_refinement::calculate_classes(const state &s) {
+    pt_structures pt = init_structures(s);
+    calculate_partition(pt);
 
-    while (not C.empty()) {
-        // [STEP 1] Remove some block S from C. (Block S is a compound block of X.)
-        x_block_ptr S = *C.begin();
-        C.erase(C.begin());
-        // [STEP 2] Examine the first two blocks in the list of blocks of Q contained in S.
-        // Let B be the smaller. (Break a tie arbitrarily.)
-        q_block_ptr B = get_smaller_block(S, C);
-
-        // [...] create a new (simple) block S' of X containing B as its only block of Q.
-        q_block_ptr_list sub_blocks;
-        sub_blocks.emplace_back(B);
-        x_block_ptr S_ = X.emplace_back(
-                std::make_shared<x_block>(std::move(sub_blocks), std::move(calculate_block_counts(r, B))));
-        B->super_block = S_;        // S' is the new super block of B
-        counts_vector &B_counts = S_->counts;
+    // We number the classes in order of first appearance of their worlds
+    world_id worlds_number = 0;
+    std::vector<world_id> classes = std::vector<world_id>(s.get_worlds_number());
+    pt_vector blocks_classes = pt_vector(pt.Q.get_blocks_number(), refinable_partition::null_id);
 
-        // [STEP 3] Copy the elements of B into a temporary set B'. (This facilitates splitting B with respect to
-        // itself during the refinement.)
-        q_block B_ = *B;
+    for (world_id w = 0; w < s.get_worlds_number(); ++w) {
+        pt_id &c = blocks_classes[pt.Q.get_block(w)];
 
-        // [STEPS 4 to 7]
-        refine(Q, X, C, S, B_, B_counts, r_preimage, worlds_blocks, preprocessed_worlds_no);
+        if (c == refinable_partition::null_id)
+            c = worlds_number++;
+        classes[w] = c;
     }
-
-    return {true, build_full_contraction(s, r, labels, Q, Q_sinks)};
+    return {worlds_number, std::move(classes)};
 }
 
-state partition_refinement::build_full_contraction(const state &s, const agent_relation &r, const agent_worlds_labels &labels,
-                                                   q_partition &Q, const q_partition &Q_sinks) {
-    // Concatenating Q and Q_sinks
-    Q.insert(Q.end(), std::make_move_iterator(Q_sinks.begin()), std::make_move_iterator(Q_sinks.end()));
-
-    world_id worlds_number = 0;
+state partition_refinement::build_full_contraction(const state &s, const world_id worlds_number,
+                                                   const std::vector<world_id> &classes) {
     relations quotient_r = relations(s.get_language()->get_agents_number());
-    std::vector<world_id> contracted_worlds_map = std::vector<world_id>(s.get_worlds_number());
-
-    for (const q_block_ptr &block: Q) {
-        const world_id w = *block->elements.begin();
-
-        if (w < s.get_worlds_number()) {                // If the current block contains worlds of the original state
-            const world_id w_ = worlds_number++;        // (i.e., worlds that were not created by the preprocessing phase)
-
-            for (const world_id v: block->elements)
-                contracted_worlds_map[v] = w_;
-        }
-    }
 
     for (del::agent ag = 0; ag < s.get_language()->get_agents_number(); ++ag) {
-        quotient_r[ag] = agent_relation(s.get_worlds_number());     // todo: shouldn't it be worlds_number?
+        quotient_r[ag] = agent_relation(worlds_number);
 
         for (world_id w_ = 0; w_ < worlds_number; ++w_)     // We make sure that the relations of worlds with
             quotient_r[ag][w_] = block{worlds_number};      // no outgoing edges are correctly computed
-    }
-
-    for (world_id w = 0; w < s.get_worlds_number(); ++w) {
-        for (const world_id w_ag: r[w]) {                       // By construction, w only sees "agent worlds"
-            del::agent ag = labels[w_ag - s.get_worlds_number()];    // ag is the label of w_ag
 
-            for (const world_id v: s.get_agent_possible_worlds(ag, w))
-                quotient_r[ag][contracted_worlds_map[w]].push_back(contracted_worlds_map[v]);
-        }
+        for (world_id w = 0; w < s.get_worlds_number(); ++w)
+            for (const world_id v : s.get_agent_possible_worlds(ag, w))
+                quotient_r[ag][classes[w]].push_back(classes[v]);
     }
 
     label_vector quotient_l = label_vector(worlds_number);
     for (world_id w = 0; w < s.get_worlds_number(); ++w)
-        quotient_l[contracted_worlds_map[w]] = s.get_label_id(w);
+        quotient_l[classes[w]] = s.get_label_id(w);
 
     world_bitset designated_worlds(worlds_number);
 
     for (world_id wd : s.get_designated_worlds())
-        designated_worlds.push_back(contracted_worlds_map[wd]);
+        designated_worlds.push_back(classes[wd]);
 
     return state{s.get_language(), worlds_number, std::move(quotient_r), std::move(quotient_l),
                  std::move(designated_worlds)};
 }
 
-q_block_ptr partition_refinement::get_smaller_block(x_block_ptr &S, compound_x_blocks_set &C) {
-// [STEP 1] Examine the first two blocks in the list of blocks of Q contained in S.
-    // Let B be the smaller. (Break a tie arbitrarily.)
-    auto first = S->sub_blocks.begin(), second = std::next(first);
+// Paige-Tarjan algorithm, generalized to multiple labelled relations: each splitter is processed once per agent
+void partition_refinement::calculate_partition(pt_structures &pt) {
+    while (pt.Q.has_compound_super_blocks()) {
+        // [STEP 1] Remove some block S from C. (Block S is a compound block of X.)
+        const pt_id S = pt.Q.pop_compound_super_block();
+        // [STEP 2] Examine the first two blocks in the list of blocks of Q contained in S. Let B be the smaller.
+        // Remove B from S and create a new (simple) block S' of X containing B as its only block of Q.
+        const pt_id B = pt.Q.extract_smaller_block(S);
 
-    if ((*first)->elements.size() > (*second)->elements.size())
-        std::swap(*first, *second);
+        // [STEP 3] Copy the elements of B into a temporary set B'. (This facilitates splitting B with respect to
+        // itself during the refinement.)
+        pt.B_.assign(pt.Q.get_elements().begin() + static_cast<long>(pt.Q.get_first(B)),
+                     pt.Q.get_elements().begin() + static_cast<long>(pt.Q.get_end(B)));
 
-    // [STEP 2] Remove B from S...
-    q_block_ptr B = std::move(*first);
-    S->sub_blocks.erase(first);
+        // [STEPS 4 to 7]
+        for (del::agent ag = 0; ag < pt.r_1.agents_number; ++ag)
+            refine(pt, ag);
+    }
+}
 
-    // If S is still compound, put S back into C.
-    if (is_compound(S))     // todo: move this as in k_paige_tarjan
-        C.emplace(S);
+void partition_refinement::refine(pt_structures &pt, const del::agent ag) {
+    pt.preimage.clear();
 
-    return B;
-}
+    // [From STEP 3] Compute R(ag)^-1(B) and, for each x in it, count(ag, x, B) = |{y \in B | x R(ag) y}|
+    for (const pt_id y : pt.B_)
+        for (pt_id e = pt.r_1.begin(y, ag); e < pt.r_1.end(y, ag); ++e)
+            if (const pt_id x = pt.r_1.sources[e]; pt.B_counts[x]++ == 0) {
+                pt.preimage.push_back(x);
+                pt.x_counts[x] = pt.edge_counts[e];     // All edges of ag from x to S share the same record
+            }
 
-counts_vector partition_refinement::calculate_block_counts(const agent_relation &r, const q_block_ptr &B) {
-    counts_vector B_counts = counts_vector(r.size());
-
-    for (world_id x = 0; x < r.size(); ++x) {
-        if (B->elements[x])
-            B_counts[x] = 0;
-        else {
-            const block &xs = r[x];
-            unsigned long count = 0;
-
-            // During the same scan, compute count(ag, x, B) = |{y \in B | x R(ag)^-1 y}|, ...
-            for (const world_id y : B->elements)   // todo: optimize by scanning B->elements and xs simultaneously exploiting the fact that they both are ordered sets
-                if (xs[y])
-                    ++count;
-            // ...store this count in a new count record and make x point to it.
-            B_counts[x] = count;
-        }
-    }
-    return B_counts;
-}
+    if (pt.preimage.empty())
+        return;
 
-void partition_refinement::refine(q_partition &Q, x_partition &X, compound_x_blocks_set &C, x_block_ptr &S,
-                                  const q_block &B_, counts_vector &B_counts, const agent_relation &r_preimage,
-                                  q_block_ptr_vector &worlds_blocks, const world_id preprocessed_worlds_no) {
-    block B_preimage = block{preprocessed_worlds_no}, B_S_preimage = block{preprocessed_worlds_no};
-
-    for (const world_id y : B_.elements) {
-        for (const world_id x : r_preimage[y]) {
-            // [From STEP 3] Compute R(ag)^-1(B).
-            B_preimage.push_back(x);
-            // [From STEP 5] To process an edge x R(ag) y, determine count(ag, x, B) and count(ag, x, S).
-            // If count(ag, x, B) == count(ag, x, S), add x to R(ag)^-1(B) \ R(ag)^-1(S \ B)
-            if (B_counts[x] == S->counts[x])
-                B_S_preimage.push_back(x);
-        }
+    // [STEP 4] Refine Q with respect to B
+    for (const pt_id x : pt.preimage)
+        pt.Q.mark(x);
+    pt.Q.split();
+
+    // [STEPS 5-6] Refine Q with respect to S \ B, i.e., split using R(ag)^-1(B) \ R(ag)^-1(S \ B), the set of the
+    // worlds x in R(ag)^-1(B) such that count(ag, x, B) == count(ag, x, S)
+    for (const pt_id x : pt.preimage)
+        if (pt.B_counts[x] == pt.counts[pt.x_counts[x]])
+            pt.Q.mark(x);
+    pt.Q.split();
+
+    // [STEP 7] Update counts: decrement count(ag, x, S) and make the edges x R(ag) y with y \in B point to count(ag, x, B)
+    for (const pt_id x : pt.preimage) {
+        const pt_id x_S = pt.x_counts[x];
+        pt.x_counts[x] = new_count(pt, pt.B_counts[x]);
+
+        if ((pt.counts[x_S] -= pt.B_counts[x]) == 0)    // If count(ag, x, S) becomes zero, we delete its record
+            pt.free_counts.push_back(x_S);
     }
 
-    // [STEP 4] Refine Q with respect to B
-    if (not B_preimage.empty())
-        refine_helper(Q, X, C, B_preimage, worlds_blocks, preprocessed_worlds_no);
-    // [STEP 6] Refine Q with respect to S \ B
-    if (not B_S_preimage.empty())
-        refine_helper(Q, X, C, B_S_preimage, worlds_blocks, preprocessed_worlds_no);
-
-    // [STEP 7] Update counts
-    update_counts(S, B_, B_counts, r_preimage);
-}
+    for (const pt_id y : pt.B_)
+        for (pt_id e = pt.r_1.begin(y, ag); e < pt.r_1.end(y, ag); ++e)
+            pt.edge_counts[e] = pt.x_counts[pt.r_1.sources[e]];
 
-void partition_refinement::refine_helper(q_partition &Q, x_partition &X, compound_x_blocks_set &C, const block &block_preimage,
-                                         q_block_ptr_vector &worlds_blocks, const world_id preprocessed_worlds_no) {
-    split_q_blocks_map split_blocks;
-    // [From STEP 4] For each block D of Q containing some element of R(ag)^-1(B), split D into D_1 = D \cap R(ag)^-1(B)
-    // and D_2 = D \ D_1. Do this by scanning the elements of R(ag)^-1(B) [i.e., block_preimage].
-    // [From STEP 6] Proceed exactly as in Step 4 but scan R(ag)^-1(B) \ R(ag)^-1(S \ B) (computed in step 5) instead of R(ag)^-1(B).
-    for (const world_id x : block_preimage) {
-        // To process an element x \in R(ag)^-1(B), determine the block D of Q containing it...
-        q_block_ptr D = worlds_blocks[x];
-
-        if (split_blocks.find(D) == split_blocks.end()) {
-            // ...and create an associated block D' if one does not already exist.
-            q_block_ptr D_ =  Q.emplace_back(std::make_shared<q_block>(block{preprocessed_worlds_no}, D->super_block));
-            D_->super_block->sub_blocks.push_back(D_);
-            split_blocks[D] = D_;       // We associate block D' to D
-        }
-
-        q_block_ptr D_ = split_blocks[D];
-        // Move x from D to D'.
-        D_->elements.push_back(x);
-        D->elements.remove(x);
-        worlds_blocks[x] = D_;
-    }
-    clean_and_update_partitions(Q, X, C, split_blocks);
+    for (const pt_id x : pt.preimage)
+        pt.B_counts[x] = 0;
 }
 
-void partition_refinement::clean_and_update_partitions(q_partition &Q, x_partition &X, compound_x_blocks_set &C,
-                                                       split_q_blocks_map &split_blocks) {
-    // After the scanning, process the list of split blocks. For each such block D with associated block D'...
-    for (const auto &[D, D_]: split_blocks) {
-        if (D->elements.empty()) {                      // ...eliminate the record for D if D is now empty;...
-            Q.erase(std::find(Q.begin(), Q.end(), D));     // todo: this has complexity O(|Q|). See if it can be lowered to O(1)
-            q_block_ptr_list &sub_blocks = D->super_block->sub_blocks;
-            sub_blocks.erase(std::find(sub_blocks.begin(), sub_blocks.end(), D));
-
-            if (sub_blocks.empty()) {       // todo: do I need this?
-                X.erase(std::find(X.begin(), X.end(), D->super_block));
-                C.erase(std::find(C.begin(), C.end(), D->super_block));
-            }
-        } else if (is_compound(D->super_block))         // ...and, if D is nonempty and the block of X containing D and
-            C.emplace(D->super_block);                  // D' has been made compound by the split, add this block to C
+pt_id partition_refinement::new_count(pt_structures &pt, const pt_id count) {
+    if (pt.free_counts.empty()) {
+        pt.counts.push_back(count);
+        return pt.counts.size() - 1;
     }
-}
 
-void partition_refinement::update_counts(x_block_ptr &S, const q_block &B_, const counts_vector &B_counts,
-                                         const agent_relation &r_preimage) {
-    // Scan the edges x R(ag) y such that y \in B.
-    for (const world_id y : B_.elements)
-        for (const world_id x : r_preimage[y])
-            // To process an edge x R(ag) y, decrement count(ag, x, S).
-            // If this count becomes zero, delete the count record and make x R(ag) y point to count(ag, x, B)
-            if (--S->counts[x] == 0)
-                S->counts[x] = B_counts[x];
+    const pt_id c = pt.free_counts.back();
+    pt.free_counts.pop_back();
+    pt.counts[c] = count;
+    return c;
 }
 
 // Paige-Tarjan data structures initialization
-std::pair<agent_relation, agent_worlds_labels> partition_refinement::build_preprocessed_state(const state &s) {
-    world_id worlds_number = s.get_worlds_number();
-
-    for (del::agent ag = 0; ag < s.get_language()->get_agents_number(); ++ag)
-        for (world_id w = 0; w < s.get_worlds_number(); ++w)
-            worlds_number += s.get_agent_possible_worlds(ag, w).size();
-
-    agent_relation r = agent_relation(worlds_number);
-
-    for (world_id w = 0; w < worlds_number; ++w)
-        r[w] = world_bitset{worlds_number};
-
-    world_id count = s.get_worlds_number() - 1;
-    agent_worlds_labels agent_labels = std::vector<del::agent>(worlds_number - s.get_worlds_number());
-
-    for (del::agent ag = 0; ag < s.get_language()->get_agents_number(); ++ag) {
-        for (world_id w = 0; w < s.get_worlds_number(); ++w) {
-            for (world_id v : s.get_agent_possible_worlds(ag, w)) {
-                world_id w_ag = ++count;
-                agent_labels[w_ag - s.get_worlds_number()] = ag;
+pt_structures partition_refinement::init_structures(const state &s) {
+    pt_structures pt;
+    pt.r_1 = relations_preimage{s};
+    pt.Q = init_partition(s);
+    init_counts(s, pt);
 
-                r[w].push_back(w_ag);
-                r[w_ag].push_back(v);
-            }
-        }
-    }
+    pt.B_counts = pt_vector(s.get_worlds_number(), 0);
+    pt.x_counts = pt_vector(s.get_worlds_number());
 
-    return std::make_pair(std::move(r), std::move(agent_labels));
+    return pt;
 }
 
-void partition_refinement::init_data_structures(const state &s, const agent_relation &r, const agent_worlds_labels &labels,
-                                                q_partition &Q, q_partition &Q_sinks, x_partition &X, compound_x_blocks_set &C,
-                                                q_block_ptr_vector &worlds_blocks, agent_relation &r_preimage,
-                                                const world_id preprocessed_worlds_no) {
-    // Complexity: O(|W| + |R|)
-    init_partitions(s, r, labels, Q, Q_sinks, X, C, worlds_blocks, preprocessed_worlds_no);
-    init_preimage(r, r_preimage, preprocessed_worlds_no);
-}
+refinable_partition partition_refinement::init_partition(const state &s) {
+    // Initial partition. Worlds are split depending on their label and on the set of agents that have some outgoing
+    // edge from them. The latter makes the initial partition stable with respect to W for all relations, which is
+    // required by the algorithm. Initially, X contains a single block with all blocks of Q.
+    // Complexity (assuming |P| and |AG| are constant): O(|W|)
+    std::map<std::pair<label_id, boost::dynamic_bitset<>>, pt_id> initial_blocks;
+    pt_vector worlds_blocks = pt_vector(s.get_worlds_number());
 
-void partition_refinement::init_partitions(const state &s, const agent_relation &r, const agent_worlds_labels &labels,
-                                           q_partition &Q, q_partition &Q_sinks, x_partition &X, compound_x_blocks_set &C,
-                                           q_block_ptr_vector &worlds_blocks, const world_id preprocessed_worlds_no) {
-    std::map<const label_id, q_block> initial_partition, initial_partition_sinks;
-    std::map<const del::agent, q_block> initial_agent_worlds_partition;      // By construction, "agent worlds" can not be sinks
-
-    worlds_blocks = q_block_ptr_vector(r.size());
-
-    // Initializing initial partition. Here we split worlds depending on their propositional valuation.
-    // In each q_block we insert worlds sharing the same valuation.
-    // We store blocks containing sink worlds in a separate partition (see (*))
-    // We do not update the 'super_block' field, as we will do it later in the X partition initialization
-    // Complexity (assuming |P| is constant): O(|W|)
-    for (world_id w = 0; w < r.size(); ++w)
-        if (w < s.get_worlds_number()) {        // If w is a world of the original state
-            if (is_sink(s, w))
-                init_partitions_helper<const label_id>(initial_partition_sinks, w, s.get_label_id(w), preprocessed_worlds_no);
-            else
-                init_partitions_helper<const label_id>(initial_partition, w, s.get_label_id(w), preprocessed_worlds_no);
-        } else
-            init_partitions_helper<const del::agent>(initial_agent_worlds_partition, w, labels[w - s.get_worlds_number()], preprocessed_worlds_no);
-
-    // (*) In an efficient implementation of the algorithm, it is useful to reduce the problem instance to one in which
-    // |R(x)| >= 1 for all x \in W. To do this we preprocess the partition P by splitting each block B \in P [where
-    // P = {V(p) | p \in Atoms}] into B' = B \cap R^-1(W) and B'' = B \ R^-1(W). The blocks B'' will never be split by
-    // the refinement algorithm; thus we can run the refinement algorithm on the partition P' consisting of the set of blocks
-    // B'. [...] The coarsest stable refinement of P' together with the blocks B'' is the coarsest stable refinement of P.
-
-    // Initializing partitions Q and Q_sinks. Complexity (assuming |P| is constant): O(1)
-    for (auto &[val, block]: initial_partition)
-        Q.emplace_back(std::make_shared<q_block>(std::move(block)));
-
-    for (auto &[ags, block] : initial_agent_worlds_partition)
-        Q.emplace_back(std::make_shared<q_block>(std::move(block)));
-
-    for (auto &[val, block] : initial_partition_sinks)
-        Q_sinks.emplace_back(std::make_shared<q_block>(std::move(block)));
-
-    // Making worlds point to their block. Complexity (assuming |AG| is constant): O(|W|)
-    for (const q_block_ptr &block : Q)
-        for (const world_id w : block->elements)
-            worlds_blocks[w] = block;
-
-    // Initializing partition X. Complexity (assuming |P| is constant): O(1)
-    q_block_ptr_list sub_blocks;
-    counts_vector counts = counts_vector(s.get_language()->get_agents_number());
-
-    for (const q_block_ptr &block : Q)
-        sub_blocks.push_back(block);
-
-    for (const q_block_ptr &block : Q_sinks)
-        sub_blocks.push_back(block);
-
-    // Initializing X and C. Complexity: O(1)
-    if (not sub_blocks.empty()) {
-        x_block_ptr x = X.emplace_back(std::make_shared<x_block>(std::move(sub_blocks), std::move(counts)));
-        // Setting pointers to relative x_blocks for each q_block. Complexity (assuming |P| is constant): O(1)
-        for (const q_block_ptr &block: Q)
-            block->super_block = x;
-
-        if (is_compound(x)) {
-            C.emplace(x);
-            init_counts(r, x);
-        }
-    }
-}
-
-bool partition_refinement::is_sink(const state &s, const world_id w) {
-    for (del::agent ag = 0; ag < s.get_language()->get_agents_number(); ++ag)
-        if (not s.get_agent_possible_worlds(ag, w).empty())
-            return false;
-    return true;
-}
+    for (world_id w = 0; w < s.get_worlds_number(); ++w) {
+        boost::dynamic_bitset<> agents(s.get_language()->get_agents_number());
 
-template<class T>
-void partition_refinement::init_partitions_helper(std::map<T, q_block> &partition, const world_id w, T key,
-                                                  const world_id preprocessed_worlds_no) {
-    const auto it = partition.find(key);
+        for (del::agent ag = 0; ag < s.get_language()->get_agents_number(); ++ag)
+            agents[ag] = not s.get_agent_possible_worlds(ag, w).empty();
 
-    if (it == partition.end())
-        partition.emplace(key, q_block{block{preprocessed_worlds_no, world_set{w}}, std::shared_ptr<x_block>(nullptr)});
-    else {
-        q_block &block = it->second;
-        block.elements.push_back(w);
+        worlds_blocks[w] = initial_blocks.emplace(std::make_pair(s.get_label_id(w), std::move(agents)), initial_blocks.size()).first->second;
     }
+    return refinable_partition{worlds_blocks, initial_blocks.size()};
 }
 
-void partition_refinement::init_preimage(const agent_relation &r, agent_relation &r_preimage, const world_id preprocessed_worlds_no) {
-    // Complexity: O(|R|)
-    r_preimage = agent_relation(r.size());
-
-    for (world_id w = 0; w < r.size(); ++w)                 // We make sure that the preimage of worlds with
-        r_preimage[w] = world_bitset{preprocessed_worlds_no};  // no incoming edges is correctly computed
-
-    for (world_id w = 0; w < r.size(); ++w)
-        for (const auto &v : r[w])
-            r_preimage[v].push_back(w);
-}
+void partition_refinement::init_counts(const state &s, pt_structures &pt) {
+    // Initially, the record of count(ag, x, W) is the number of ag-successors of x, and its id is x*|AG|+ag.
+    // Complexity (assuming |AG| is constant): O(|W| + |R|)
+    const pt_id A = pt.r_1.agents_number;
+    pt.counts = pt_vector(s.get_worlds_number() * A);
+    pt.edge_counts = pt_vector(pt.r_1.sources.size());
 
-void partition_refinement::init_counts(const agent_relation &r, x_block_ptr &x) {
-    // Complexity: O(|W|)
-    x->counts = counts_vector(r.size());
-
-    for (world_id w = 0; w < r.size(); ++w)
-        x->counts[w] = r[w].size();
-}
+    for (del::agent ag = 0; ag < A; ++ag)
+        for (world_id w = 0; w < s.get_worlds_number(); ++w)
+            pt.counts[w * A + ag] = s.get_agent_possible_worlds(ag, w).size();
 
-bool partition_refinement::is_compound(const x_block_ptr &x) {
-    return x->sub_blocks.size() > 1;
+    for (world_id y = 0; y < s.get_worlds_number(); ++y)
+        for (del::agent ag = 0; ag < A; ++ag)
+            for (pt_id e = pt.r_1.begin(y, ag); e < pt.r_1.end(y, ag); ++e)
+                pt.edge_counts[e] = pt.r_1.sources[e] * A + ag;
 }
@@ -0,0 +1,183 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "../../../../../include/del/semantics/kripke/bisimulation/refinable_partition.h"
+#include "../../../../../include/del/semantics/kripke/states/state.h"
+
+using namespace kripke;
+
+relations_preimage::relations_preimage(const state &s) :
+        agents_number{s.get_language()->get_agents_number()} {
+    // Counting sort of the edges by target and agent. Complexity (assuming |AG| is constant): O(|W| + |R|)
+    offsets = pt_vector(s.get_worlds_number() * agents_number + 1, 0);
+
+    for (del::agent ag = 0; ag < agents_number; ++ag)
+        for (world_id w = 0; w < s.get_worlds_number(); ++w)
+            for (const world_id v : s.get_agent_possible_worlds(ag, w))
+                ++offsets[v * agents_number + ag + 1];
+
+    for (pt_id i = 0; i + 1 < offsets.size(); ++i)
+        offsets[i+1] += offsets[i];
+
+    sources = pt_vector(offsets.back());
+    pt_vector positions = pt_vector(offsets.begin(), offsets.end() - 1);
+
+    for (del::agent ag = 0; ag < agents_number; ++ag)
+        for (world_id w = 0; w < s.get_worlds_number(); ++w)
+            for (const world_id v : s.get_agent_possible_worlds(ag, w))
+                sources[positions[v * agents_number + ag]++] = w;
+}
+
+refinable_partition::refinable_partition(const pt_vector &elements_blocks, const pt_id blocks_number) :
+        m_blocks{elements_blocks} {
+    // Counting sort of the elements by block. Complexity: O(n)
+    const pt_id n = elements_blocks.size();
+    m_first = pt_vector(blocks_number + 1, 0);
+
+    for (const pt_id B : elements_blocks)
+        ++m_first[B+1];
+
+    for (pt_id B = 0; B < blocks_number; ++B)
+        m_first[B+1] += m_first[B];
+
+    m_end = pt_vector(m_first.begin() + 1, m_first.end());
+    m_first.pop_back();
+    m_mid = m_first;
+
+    m_elements = pt_vector(n);
+    m_locations = pt_vector(n);
+    pt_vector positions = m_first;
+
+    for (pt_id x = 0; x < n; ++x) {
+        m_locations[x] = positions[m_blocks[x]]++;
+        m_elements[m_locations[x]] = x;
+    }
+
+    m_super_blocks = pt_vector(blocks_number, 0);
+    m_next_blocks = pt_vector(blocks_number);
+    m_prev_blocks = pt_vector(blocks_number);
+
+    for (pt_id B = 0; B < blocks_number; ++B) {
+        m_prev_blocks[B] = B == 0 ? null_id : B-1;
+        m_next_blocks[B] = B+1 == blocks_number ? null_id : B+1;
+    }
+
+    m_super_blocks_first = {blocks_number == 0 ? null_id : 0};
+    m_super_blocks_sizes = {blocks_number};
+
+    if (blocks_number > 1)
+        m_compound_super_blocks.push_back(0);
+}
+
+void refinable_partition::mark(const pt_id x) {
+    const pt_id D = m_blocks[x], loc_x = m_locations[x];
+
+    if (loc_x < m_mid[D])       // x is already marked
+        return;
+
+    if (m_mid[D] == m_first[D])
+        m_touched_blocks.push_back(D);
+
+    // We move x to the marked part of its block, i.e., we swap it with the first unmarked element y of D
+    const pt_id y = m_elements[m_mid[D]];
+
+    m_elements[loc_x] = y;
+    m_locations[y] = loc_x;
+    m_elements[m_mid[D]] = x;
+    m_locations[x] = m_mid[D]++;
+}
+
+void refinable_partition::split() {
+    for (const pt_id D : m_touched_blocks) {
+        if (m_mid[D] == m_end[D]) {         // If all elements of D are marked, then D is not split
+            m_mid[D] = m_first[D];
+            continue;
+        }
+
+        const pt_id D_ = m_first.size(), S = m_super_blocks[D];
+
+        m_first.push_back(m_first[D]);
+        m_mid.push_back(m_first[D]);
+        m_end.push_back(m_mid[D]);
+        m_super_blocks.push_back(S);
+        m_first[D] = m_mid[D];
+
+        for (pt_id i = m_first[D_]; i < m_end[D_]; ++i)
+            m_blocks[m_elements[i]] = D_;
+
+        // D' belongs to the same super block S of D. If S has been made compound by the split, we push it in the stack
+        m_prev_blocks.push_back(D);
+        m_next_blocks.push_back(m_next_blocks[D]);
+        if (m_next_blocks[D] != null_id) m_prev_blocks[m_next_blocks[D]] = D_;
+        m_next_blocks[D] = D_;
+
+        if (++m_super_blocks_sizes[S] == 2)
+            m_compound_super_blocks.push_back(S);
+    }
+    m_touched_blocks.clear();
+}
+
+pt_id refinable_partition::pop_compound_super_block() {
+    const pt_id S = m_compound_super_blocks.back();
+    m_compound_super_blocks.pop_back();
+    return S;
+}
+
+pt_id refinable_partition::extract_smaller_block(const pt_id S) {
+    const pt_id first = m_super_blocks_first[S], second = m_next_blocks[first];
+    const pt_id B = get_block_size(first) <= get_block_size(second) ? first : second;
+
+    // Remove B from S...
+    if (m_prev_blocks[B] == null_id) m_super_blocks_first[S] = m_next_blocks[B];
+    else m_next_blocks[m_prev_blocks[B]] = m_next_blocks[B];
+
+    if (m_next_blocks[B] != null_id) m_prev_blocks[m_next_blocks[B]] = m_prev_blocks[B];
+
+    // ...if S is still compound, put S back into the stack...
+    if (--m_super_blocks_sizes[S] > 1)
+        m_compound_super_blocks.push_back(S);
+
+    // ...and create a new simple super block containing B
+    m_super_blocks[B] = m_super_blocks_first.size();
+    m_next_blocks[B] = m_prev_blocks[B] = null_id;
+    m_super_blocks_first.push_back(B);
+    m_super_blocks_sizes.push_back(1);
+
+    return B;
+}
+
+unsigned long relations_preimage::get_memory_usage() const {
+    return (offsets.capacity() + sources.capacity()) * sizeof(pt_id);
+}
+
+unsigned long refinable_partition::get_memory_usage() const {
+    unsigned long capacity = 0;
+
+    for (const pt_vector *v : {&m_elements, &m_locations, &m_blocks, &m_first, &m_mid, &m_end, &m_super_blocks,
+                               &m_next_blocks, &m_prev_blocks, &m_touched_blocks, &m_super_blocks_first,
+                               &m_super_blocks_sizes, &m_compound_super_blocks})
+        capacity += v->capacity();
+
+    return capacity * sizeof(pt_id);
+}
@@ -26,6 +26,16 @@
 using namespace kripke;
 
 bool model_checker::holds_in(const state &s, world_id w, const del::formula &f, const del::label_storage &l_storage) {
+    return model_checker::holds_in(s, w, f, l_storage, nullptr);
+}
+
+bool model_checker::holds_in(const state &s, world_id w, const del::formula &f, const del::label_storage &l_storage,
+                             rows_memo &memo) {
+    return model_checker::holds_in(s, w, f, l_storage, &memo);
+}
+
+bool model_checker::holds_in(const state &s, world_id w, const del::formula &f, const del::label_storage &l_storage,
+                             rows_memo *memo) {
     switch (f.get_type()) {
         case del::formula_type::true_formula:
             return true;
@@ -34,17 +44,17 @@ bool model_checker::holds_in(const state &s, world_id w, const del::formula &f,
         case del::formula_type::atom_formula:
             return model_checker::holds_in(s, w, dynamic_cast<const del::atom_formula &>(f), l_storage);
         case del::formula_type::not_formula:
-            return model_checker::holds_in(s, w, dynamic_cast<const del::not_formula &>(f), l_storage);
+            return model_checker::holds_in(s, w, dynamic_cast<const del::not_formula &>(f), l_storage, memo);
         case del::formula_type::and_formula:
-            return model_checker::holds_in(s, w, dynamic_cast<const del::and_formula &>(f), l_storage);
+            return model_checker::holds_in(s, w, dynamic_cast<const del::and_formula &>(f), l_storage, memo);
         case del::formula_type::or_formula:
-            return model_checker::holds_in(s, w, dynamic_cast<const del::or_formula &>(f), l_storage);
+            return model_checker::holds_in(s, w, dynamic_cast<const del::or_formula &>(f), l_storage, memo);
         case del::formula_type::imply_formula:
-            return model_checker::holds_in(s, w, dynamic_cast<const del::imply_formula &>(f), l_storage);
+            return model_checker::holds_in(s, w, dynamic_cast<const del::imply_formula &>(f), l_storage, memo);
         case del::formula_type::box_formula:
-            return model_checker::holds_in(s, w, dynamic_cast<const del::box_formula &>(f), l_storage);
+            return model_checker::holds_in(s, w, dynamic_cast<const del::box_formula &>(f), l_storage, memo);
         case del::formula_type::diamond_formula:
-            return model_checker::holds_in(s, w, dynamic_cast<const del::diamond_formula &>(f), l_storage);
+            return model_checker::holds_in(s, w, dynamic_cast<const del::diamond_formula &>(f), l_storage, memo);
     }
 }
 
@@ -52,32 +62,59 @@ bool model_checker::holds_in(const state &s, world_id w, const del::atom_formula
     return (*l_storage.get(s.get_label_id(w)))[f.get_atom()];
 }
 
-bool model_checker::holds_in(const state &s, world_id w, const del::not_formula &f, const del::label_storage &l_storage) {
-    return not model_checker::holds_in(s, w, *f.get_f(), l_storage);
+bool model_checker::holds_in(const state &s, world_id w, const del::not_formula &f, const del::label_storage &l_storage,
+                             rows_memo *memo) {
+    return not model_checker::holds_in(s, w, *f.get_f(), l_storage, memo);
 }
 
-bool model_checker::holds_in(const state &s, world_id w, const del::and_formula &f, const del::label_storage &l_storage) {
-    auto check = [&](const del::formula_ptr &f) { return model_checker::holds_in(s, w, *f, l_storage); };
+bool model_checker::holds_in(const state &s, world_id w, const del::and_formula &f, const del::label_storage &l_storage,
+                             rows_memo *memo) {
+    auto check = [&](const del::formula_ptr &f) { return model_checker::holds_in(s, w, *f, l_storage, memo); };
     return std::all_of(f.get_fs().begin(), f.get_fs().end(), check);
 }
 
-bool model_checker::holds_in(const state &s, world_id w, const del::or_formula &f, const del::label_storage &l_storage) {
-    auto check = [&](const del::formula_ptr &f) { return model_checker::holds_in(s, w, *f, l_storage); };
+bool model_checker::holds_in(const state &s, world_id w, const del::or_formula &f, const del::label_storage &l_storage,
+                             rows_memo *memo) {
+    auto check = [&](const del::formula_ptr &f) { return model_checker::holds_in(s, w, *f, l_storage, memo); };
     return std::any_of(f.get_fs().begin(), f.get_fs().end(), check);
 }
 
-bool model_checker::holds_in(const state &s, world_id w, const del::imply_formula &f, const del::label_storage &l_storage) {
-    return not model_checker::holds_in(s, w, *f.get_f1(), l_storage) or model_checker::holds_in(s, w, *f.get_f2(), l_storage);
+bool model_checker::holds_in(const state &s, world_id w, const del::imply_formula &f, const del::label_storage &l_storage,
+                             rows_memo *memo) {
+    return not model_checker::holds_in(s, w, *f.get_f1(), l_storage, memo) or
+           model_checker::holds_in(s, w, *f.get_f2(), l_storage, memo);
 }
 
-bool model_checker::holds_in(const state &s, world_id w, const del::box_formula &f, const del::label_storage &l_storage) {
-    const auto &worlds = s.get_agent_possible_worlds(f.get_ag(), w);
-    return std::all_of(worlds.begin(), worlds.end(),
-                       [&](const world_id &v) { return model_checker::holds_in(s, v, *f.get_f(), l_storage); });
+bool model_checker::holds_in(const state &s, world_id w, const del::box_formula &f, const del::label_storage &l_storage,
+                             rows_memo *memo) {
+    const row_id r = s.get_agent_row_id(f.get_ag(), w);
+
+    if (memo)
+        if (const auto it = memo->find({&f, r}); it != memo->end())
+            return it->second;
+
+    const auto &worlds = s.get_agent_row(f.get_ag(), r);
+    const bool truth = std::all_of(worlds.begin(), worlds.end(),
+                                   [&](const world_id &v) { return model_checker::holds_in(s, v, *f.get_f(), l_storage, memo); });
+
+    if (memo)
+        memo->emplace(formula_row_pair{&f, r}, truth);
+    return truth;
 }
 
-bool model_checker::holds_in(const state &s, world_id w, const del::diamond_formula &f, const del::label_storage &l_storage) {
-    const auto &worlds = s.get_agent_possible_worlds(f.get_ag(), w);
-    return std::any_of(worlds.begin(), worlds.end(),
-                       [&](const world_id &v) { return model_checker::holds_in(s, v, *f.get_f(), l_storage); });
+bool model_checker::holds_in(const state &s, world_id w, const del::diamond_formula &f, const del::label_storage &l_storage,
+                             rows_memo *memo) {
+    const row_id r = s.get_agent_row_id(f.get_ag(), w);
+
+    if (memo)
+        if (const auto it = memo->find({&f, r}); it != memo->end())
+            return it->second;
+
+    const auto &worlds = s.get_agent_row(f.get_ag(), r);
+    const bool truth = std::any_of(worlds.begin(), worlds.end(),
+                                   [&](const world_id &v) { return model_checker::holds_in(s, v, *f.get_f(), l_storage, memo); });
+
+    if (memo)
+        memo->emplace(formula_row_pair{&f, r}, truth);
+    return truth;
 }
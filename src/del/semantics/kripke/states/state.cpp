@@ -24,6 +24,10 @@
 #include "../../../../../include/del/semantics/kripke/states/state.h"
 #include "../../../../../include/del/semantics/kripke/model_checker.h"
 #include "../../../../../include/del/formulas/formula_types.h"
+#include <algorithm>
+#include <climits>
+#include <numeric>
+#include <unordered_map>
 #include <queue>
 #include <string>
 #include <utility>
@@ -36,10 +40,30 @@ state::state(language_ptr language, unsigned long long worlds_number, relations
              label_vector valuation, world_bitset designated_worlds, unsigned long long state_id) :
         m_language{std::move(language)},
         m_worlds_number{worlds_number},
-        m_relations{std::move(relations)},
+        m_rows{std::move(relations)},
+        m_rows_ids{relations_rows_ids(m_rows.size(), agent_rows_ids(worlds_number))},
         m_labels{std::move(valuation)},
         m_designated_worlds{std::move(designated_worlds)},
         m_state_id{state_id} {
+    for (agent_rows_ids &ids : m_rows_ids)
+        std::iota(ids.begin(), ids.end(), 0);
+
+    share_rows();
+    build_classes();
+    calculate_worlds_depth();
+}
+
+state::state(language_ptr language, unsigned long long worlds_number, relations_rows rows, relations_rows_ids rows_ids,
+             label_vector valuation, world_bitset designated_worlds, unsigned long long state_id) :
+        m_language{std::move(language)},
+        m_worlds_number{worlds_number},
+        m_rows{std::move(rows)},
+        m_rows_ids{std::move(rows_ids)},
+        m_labels{std::move(valuation)},
+        m_designated_worlds{std::move(designated_worlds)},
+        m_state_id{state_id} {
+    share_rows();
+    build_classes();
     calculate_worlds_depth();
 }
 
@@ -47,13 +71,39 @@ unsigned long long state::get_worlds_number() const {
     return m_worlds_number;
 }
 
-const world_bitset &state::get_agent_possible_worlds(const agent ag, const world_id w) const {
-    return m_relations[ag].at(w);
+worlds_range state::get_agent_possible_worlds(const agent ag, const world_id w) const {
+    return get_agent_row(ag, m_rows_ids[ag].at(w));
 }
 
 bool state::has_edge(const agent ag, const world_id w, const world_id v) const {
-//    return std::find(m_relations[ag].at(w).begin(), m_relations[ag].at(w).end(), v) != m_relations[ag].at(w).end();
-    return (*m_relations[ag][w])[v];
+    return get_agent_possible_worlds(ag, w)[v];
+}
+
+row_id state::get_agent_row_id(const agent ag, const world_id w) const {
+    return m_rows_ids[ag][w];
+}
+
+unsigned long long state::get_agent_rows_number(const agent ag) const {
+    return has_classes(ag) ? m_classes[ag].offsets.size() - 1 : m_rows[ag].size();
+}
+
+worlds_range state::get_agent_row(const agent ag, const row_id r) const {
+    return has_classes(ag) ? worlds_range{m_classes[ag], m_rows_ids[ag], r} : worlds_range{m_rows[ag][r]};
+}
+
+bool state::has_classes(const agent ag) const {
+    return not m_classes[ag].offsets.empty();
+}
+
+bool state::is_equivalence(const agent ag) const {
+    return m_classes[ag].is_equivalence;
+}
+
+bool state::is_partitioned() const {
+    for (agent ag = 0; ag < m_classes.size(); ++ag)
+        if (not has_classes(ag))
+            return false;
+    return true;
 }
 
 const label_id &state::get_label_id(const world_id w) const {
@@ -68,6 +118,10 @@ unsigned long long state::get_id() const {
     return m_state_id;
 }
 
+void state::set_id(const unsigned long long state_id) {
+    m_state_id = state_id;
+}
+
 bool state::is_designated(const world_id w) const {
     return std::find(m_designated_worlds.begin(), m_designated_worlds.end(), w) != m_designated_worlds.end();
 }
@@ -85,12 +139,14 @@ unsigned long state::get_max_depth() const {
 }
 
 bool state::satisfies(const formula_ptr &f, const del::label_storage &l_storage) const {
+    model_checker::rows_memo memo;
     return std::all_of(m_designated_worlds.begin(), m_designated_worlds.end(),
-                       [&](const world_id wd) { return model_checker::holds_in(*this, wd, *f, l_storage); });
+                       [&](const world_id wd) { return model_checker::holds_in(*this, wd, *f, l_storage, memo); });
 }
 
 void state::calculate_worlds_depth() {
-    m_worlds_depth = std::vector<unsigned long>(m_worlds_number);
+    // Worlds that are not reachable from the designated ones have infinite depth, so that bounded contractions drop them
+    m_worlds_depth = std::vector<unsigned long>(m_worlds_number, ULONG_MAX);
     m_max_depth = 0;
 
     std::queue<world_id> to_visit;
@@ -110,8 +166,7 @@ void state::calculate_worlds_depth() {
             m_max_depth = m_worlds_depth[current];
 
         for (agent ag = 0; ag < m_language->get_agents_number(); ++ag) {
-            for (const world_id v : m_relations[ag][current]) {
-//            for (world_id v = 0; v < m_worlds_number; ++v) {
+            for (const world_id v : get_agent_possible_worlds(ag, current)) {
                 if (not assigned[v]) {      // has_edge(ag, current, v) and
                     m_worlds_depth[v] = m_worlds_depth[current] + 1;
                     assigned[v] = true;
@@ -122,6 +177,88 @@ void state::calculate_worlds_depth() {
     }
 }
 
+void state::share_rows() {
+    // Rows of the same agent with equal successors are merged, and only the rows that are used by some world are kept.
+    // Rows are bucketed by the hash of their bitsets, so that we only compare rows with the same hash
+    for (agent ag = 0; ag < m_rows.size(); ++ag) {
+        if (m_rows[ag].empty())     // The relation of ag is given by its classes
+            continue;
+
+        agent_relation rows;
+        std::vector<row_id> new_ids(m_rows[ag].size(), m_rows[ag].size());
+        std::unordered_map<std::size_t, std::vector<row_id>> buckets;
+
+        for (row_id &r : m_rows_ids[ag]) {
+            if (new_ids[r] == m_rows[ag].size()) {
+                std::vector<row_id> &bucket = buckets[std::hash<boost::dynamic_bitset<>>{}(m_rows[ag][r].get_bitset())];
+                const auto it = std::find_if(bucket.begin(), bucket.end(),
+                                             [&](const row_id r_) { return rows[r_].get_bitset() == m_rows[ag][r].get_bitset(); });
+
+                if (it == bucket.end()) {
+                    new_ids[r] = rows.size();
+                    bucket.emplace_back(rows.size());
+                    rows.emplace_back(std::move(m_rows[ag][r]));
+                } else
+                    new_ids[r] = *it;
+            }
+            r = new_ids[r];
+        }
+        m_rows[ag] = std::move(rows);
+    }
+}
+
+void state::build_classes() {
+    // The relation of ag is transitive and euclidean iff every world in a row has that same row. Then the rows are
+    // disjoint, and we replace them with the lists of their worlds. Agents without rows are given by their classes
+    m_classes = std::vector<agent_classes>(m_rows.size());
+
+    for (agent ag = 0; ag < m_rows.size(); ++ag) {
+        if (m_rows[ag].empty()) {
+            const auto max_id = std::max_element(m_rows_ids[ag].begin(), m_rows_ids[ag].end());
+            m_classes[ag].is_member = boost::dynamic_bitset<>(m_worlds_number);
+            m_classes[ag].is_member.set();
+            build_classes(ag, max_id == m_rows_ids[ag].end() ? 0 : *max_id + 1);
+            continue;
+        }
+
+        bool is_partition = true;
+
+        for (row_id r = 0; r < m_rows[ag].size() and is_partition; ++r)
+            is_partition = std::all_of(m_rows[ag][r].begin(), m_rows[ag][r].end(),
+                                       [&](const world_id v) { return m_rows_ids[ag][v] == r; });
+
+        if (is_partition) {
+            m_classes[ag].is_member = boost::dynamic_bitset<>(m_worlds_number);
+
+            for (const world_bitset &row : m_rows[ag])
+                for (const world_id v : row)
+                    m_classes[ag].is_member.set(v);
+
+            build_classes(ag, m_rows[ag].size());
+            m_rows[ag] = agent_relation{};
+        }
+    }
+}
+
+void state::build_classes(const agent ag, const unsigned long long classes_number) {
+    // Counting sort of the members by class, so that the worlds of each class are sorted
+    agent_classes &classes = m_classes[ag];
+    classes.offsets = std::vector<unsigned long long>(classes_number + 1, 0);
+
+    for (world_id w = 0; w < m_worlds_number; ++w)
+        if (classes.is_member[w])
+            ++classes.offsets[m_rows_ids[ag][w] + 1];
+
+    std::partial_sum(classes.offsets.begin(), classes.offsets.end(), classes.offsets.begin());
+    classes.is_equivalence = classes.offsets.back() == m_worlds_number;
+    classes.worlds = std::vector<world_id>(classes.offsets.back());
+    std::vector<unsigned long long> next(classes.offsets.begin(), classes.offsets.end() - 1);
+
+    for (world_id w = 0; w < m_worlds_number; ++w)
+        if (classes.is_member[w])
+            classes.worlds[next[m_rows_ids[ag][w]]++] = w;
+}
+
 bool state::operator<(const state &rhs) const {
     return m_state_id < rhs.m_state_id;
 }
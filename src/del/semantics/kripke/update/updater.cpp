@@ -32,52 +32,68 @@
 using namespace kripke;
 
 bool updater::is_applicable(const state &s, const action &a, const del::label_storage &l_storage) {
-    const auto check = [&](const world_id wd) { return is_applicable_world(s, a, wd, l_storage); };
+    model_checker::rows_memo memo;
+    const auto check = [&](const world_id wd) { return is_applicable_world(s, a, wd, l_storage, memo); };
     return std::all_of(s.get_designated_worlds().begin(), s.get_designated_worlds().end(), check);
 }
 
-bool updater::is_applicable_world(const state &s, const action &a, const world_id wd, const del::label_storage &l_storage) {
-    const auto check = [&](const event_id ed) { return model_checker::holds_in(s, wd, *a.get_precondition(ed), l_storage); };
-    return std::any_of(a.get_designated_events().begin(), a.get_designated_events().end(), check);
+bool updater::is_applicable_world(const state &s, const action &a, const world_id wd, const del::label_storage &l_storage,
+                                  model_checker::rows_memo &memo) {
+    const auto check = [&](const event_id ed) {
+        return model_checker::holds_in(s, wd, a.get_formula(a.get_precondition_id(ed)), l_storage, memo);
+    };
+    return std::any_of(a.get_sorted_designated_events().begin(), a.get_sorted_designated_events().end(), check);
 }
 
 state updater::product_update(const state &s, const action_deque &as, del::storages_handler_ptr handler,
                               bool apply_contraction, contraction_type type, const unsigned long k) {
     state s_ = product_update(s, *as.front(), handler->get_label_storage());
 
-    if (apply_contraction)
-        s_ = std::get<1>(bisimulator::contract(type, s_, k, handler));
+    for (auto a = as.begin(); a != as.end(); ++a) {
+        if (a != as.begin())
+            s_ = product_update(s_, **a, handler->get_label_storage());
 
-    action_deque as_ = as;
-    as_.pop_front();
-    return as_.empty() ? std::move(s_) : product_update(s_, as_, handler, apply_contraction, type, k);
+        if (apply_contraction)
+            s_ = std::get<1>(bisimulator::contract(type, s_, k, handler));
+    }
+    return s_;
 }
 
 state updater::product_update(const state &s, const action &a, del::label_storage &l_storage) {
     updated_worlds_map w_map;
-    updated_edges_vector r_map(s.get_language()->get_agents_number());
+    updated_rows rows(s.get_language()->get_agents_number());
+    relations_rows_ids rows_ids(s.get_language()->get_agents_number());
+    formulas_memo memo{std::vector<uint8_t>(s.get_worlds_number() * a.get_formulas_number(), 0), {}};
 
-    auto [worlds_number, designated_worlds] = calculate_worlds(s, a, w_map, r_map, l_storage);
-    relations r = calculate_relations(s, a, worlds_number, w_map, r_map);
-    label_vector labels = calculate_labels(s, a, worlds_number, w_map, l_storage);
+    auto [worlds_number, designated_worlds] = calculate_worlds(s, a, w_map, rows, rows_ids, l_storage, memo);
+    relations_rows r = calculate_relations(s, a, worlds_number, w_map, rows);
+    label_vector labels = calculate_labels(s, a, worlds_number, w_map, l_storage, memo);
 
-    return state{s.get_language(), worlds_number, std::move(r), std::move(labels), std::move(designated_worlds)};
+    return state{s.get_language(), worlds_number, std::move(r), std::move(rows_ids), std::move(labels), std::move(designated_worlds)};
+}
+
+bool updater::holds_in(const state &s, const world_id w, const action &a, const formula_id f,
+                       const del::label_storage &l_storage, formulas_memo &memo) {
+    uint8_t &truth = memo.truths[w * a.get_formulas_number() + f];
+
+    if (truth == 0)
+        truth = model_checker::holds_in(s, w, a.get_formula(f), l_storage, memo.rows) ? 2 : 1;
+    return truth == 2;
 }
 
 std::pair<world_id, world_bitset> updater::calculate_worlds(const state &s, const action &a, updated_worlds_map &w_map,
-                                                            updated_edges_vector &r_map, del::label_storage &l_storage) {
+                                                            updated_rows &rows, relations_rows_ids &rows_ids,
+                                                            del::label_storage &l_storage, formulas_memo &memo) {
     world_id worlds_number = 0;
     world_set designated_worlds;
 
     std::unordered_set<updated_world> to_expand;
     std::unordered_set<updated_world> visited;
-
-    for (del::agent ag = 0; ag < s.get_language()->get_agents_number(); ++ag)
-        r_map[ag] = updated_world_pair_deque{};
+    std::vector<updated_rows_map> rows_map(s.get_language()->get_agents_number());
 
     for (const world_id wd : s.get_designated_worlds())
-        for (const event_id ed : a.get_designated_events())
-            if (model_checker::holds_in(s, wd, *a.get_precondition(ed), l_storage))
+        for (const event_id ed : a.get_sorted_designated_events())
+            if (holds_in(s, wd, a, a.get_precondition_id(ed), l_storage, memo))
                 to_expand.emplace(wd, ed);
 
     while (not to_expand.empty()) {
@@ -90,66 +106,88 @@ std::pair<world_id, world_bitset> updater::calculate_worlds(const state &s, cons
             designated_worlds.emplace(worlds_number-1);
 
         for (del::agent ag = 0; ag < s.get_language()->get_agents_number(); ++ag) {
-            const world_bitset &ag_worlds = s.get_agent_possible_worlds(ag, w);
-            const event_bitset &ag_events = a.get_agent_possible_events(ag, e);
-
-            for (const world_id v : ag_worlds) {
-                for (const event_id f : ag_events) {
-                    if (model_checker::holds_in(s, v, *a.get_precondition(f), l_storage)) {
-                        updated_world w_ = {w, e}, v_ = {v, f};
-                        r_map[ag].emplace_back(w_, v_);
-
-                        if (visited.find(v_) == visited.end())
-                            to_expand.emplace(v_);
+            const row_id r = s.get_agent_row_id(ag, w);
+            const auto [it, is_new] = rows_map[ag].try_emplace(rows_pair{r, a.get_agent_row_id(ag, e)}, rows_map[ag].size());
+
+            // The successors of a known pair were already queued when they were first calculated
+            if (is_new) {
+                const bool is_class = s.is_equivalence(ag) and a.is_equivalence(ag);
+                updated_row *row = is_class ? nullptr : &rows[ag].emplace_back();
+
+                for (const world_id v : s.get_agent_row(ag, r)) {
+                    for (const event_id f : a.get_agent_successors(ag, e)) {
+                        if (holds_in(s, v, a, a.get_precondition_id(f), l_storage, memo)) {
+                            if (row)
+                                row->emplace_back(v, f);
+
+                            if (visited.find(updated_world{v, f}) == visited.end())
+                                to_expand.emplace(v, f);
+                        }
                     }
                 }
             }
+            rows_ids[ag].emplace_back(it->second);
         }
         to_expand.erase(first);
     }
     return {worlds_number, world_bitset{worlds_number, std::move(designated_worlds)}};
 }
 
-relations updater::calculate_relations(const state &s, const action &a, const world_id worlds_number,
-                                       const updated_worlds_map &w_map, const updated_edges_vector &r_map) {
-    relations r = relations(s.get_language()->get_agents_number());
+relations_rows updater::calculate_relations(const state &s, const action &a, const world_id worlds_number,
+                                            const updated_worlds_map &w_map, const updated_rows &rows) {
+    relations_rows r = relations_rows(s.get_language()->get_agents_number());
 
     for (del::agent ag = 0; ag < s.get_language()->get_agents_number(); ++ag) {
-        r[ag] = agent_relation(worlds_number);
+        if (s.is_equivalence(ag) and a.is_equivalence(ag))    // The ids of the pairs of classes are the classes of the product
+            continue;
 
-        for (world_id w = 0; w < worlds_number; ++w)
-            r[ag][w] = world_bitset(worlds_number);
-    }
-
-    for (del::agent ag = 0; ag < s.get_language()->get_agents_number(); ++ag) {
-        for (const auto &[w_, v_] : r_map[ag]) {
-            const auto &[w, e] = w_;
-            const auto &[v, f] = v_;
+        r[ag] = agent_relation(rows[ag].size(), world_bitset(worlds_number));
 
-            if (s.has_edge(ag, w, v) and a.has_edge(ag, e, f))
-                r[ag][w_map.at(w_)].push_back(w_map.at(v_));
-        }
+        // The updated worlds in the rows are collected from the successors of w and e, so they all belong to the product
+        for (row_id i = 0; i < rows[ag].size(); ++i)
+            for (const updated_world &v_ : rows[ag][i])
+                r[ag][i].push_back(w_map.at(v_));
     }
     return r;
 }
 
 label_vector updater::calculate_labels(const state &s, const action &a, const world_id worlds_number,
-                                       const updated_worlds_map &w_map, del::label_storage &l_storage) {
+                                       const updated_worlds_map &w_map, del::label_storage &l_storage,
+                                       formulas_memo &memo) {
     label_vector labels = label_vector(worlds_number);
 
     for (const auto &[w_, w_id] : w_map) {
         const auto &[w, e] = w_;
-        labels[w_id] = a.is_ontic(e) ? update_world(s, w, a, e, l_storage) : s.get_label_id(w);
+
+        if (not a.is_ontic(e))
+            labels[w_id] = s.get_label_id(w);
+        else if (a.has_propositional_postconditions())
+            labels[w_id] = update_label(s, w, a, e, l_storage);
+        else
+            labels[w_id] = update_world(s, w, a, e, l_storage, &memo);
     }
     return labels;
 }
 
-label_id updater::update_world(const state &s, const world_id &w, const action &a, const event_id &e,
+label_id updater::update_label(const state &s, const world_id &w, const action &a, const event_id &e,
                                del::label_storage &l_storage) {
-    auto bitset = l_storage.get(s.get_label_id(w))->get_bitset();
+    const label_id l = s.get_label_id(w);
+
+    if (const std::optional<label_id> l_ = a.get_label_transition(e, l))          // Propositional postconditions only depend on the label
+        return *l_;                                                 // of w, so we reuse the relabelling of previous updates
 
-    for (const auto &[p, post] : a.get_postconditions(e))
-        bitset[p] = model_checker::holds_in(s, w, *post, l_storage);
+    const label_id l_ = update_world(s, w, a, e, l_storage);
+    a.add_label_transition(e, l, l_);
+    return l_;
+}
+
+label_id updater::update_world(const state &s, const world_id &w, const action &a, const event_id &e,
+                               del::label_storage &l_storage, formulas_memo *memo) {
+    auto bitset = l_storage.get(s.get_label_id(w))->get_bitset();
 
+    // Modal postconditions depend on the whole state, so we can only memoize their truth values within s
+    for (const auto &[p, post] : a.get_compiled_postconditions(e))
+        bitset[p] = memo ? holds_in(s, w, a, post, l_storage, *memo)
+                         : model_checker::holds_in(s, w, a.get_formula(post), l_storage);
     return l_storage.emplace(del::label{std::move(bitset)});
 }
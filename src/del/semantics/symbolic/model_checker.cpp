@@ -0,0 +1,96 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "../../../../include/del/semantics/symbolic/model_checker.h"
+
+using namespace symbolic;
+
+bdd model_checker::calculate(const state &s, const del::formula &f) {
+    switch (f.get_type()) {
+        case del::formula_type::true_formula:
+            return s.get_worlds();
+        case del::formula_type::false_formula:
+            return bdd_manager::false_bdd;
+        case del::formula_type::atom_formula:
+            return model_checker::calculate(s, dynamic_cast<const del::atom_formula &>(f));
+        case del::formula_type::not_formula:
+            return model_checker::calculate(s, dynamic_cast<const del::not_formula &>(f));
+        case del::formula_type::and_formula:
+            return model_checker::calculate(s, dynamic_cast<const del::and_formula &>(f));
+        case del::formula_type::or_formula:
+            return model_checker::calculate(s, dynamic_cast<const del::or_formula &>(f));
+        case del::formula_type::imply_formula:
+            return model_checker::calculate(s, dynamic_cast<const del::imply_formula &>(f));
+        case del::formula_type::box_formula:
+            return model_checker::calculate(s, dynamic_cast<const del::box_formula &>(f));
+        case del::formula_type::diamond_formula:
+            return model_checker::calculate(s, dynamic_cast<const del::diamond_formula &>(f));
+    }
+    return bdd_manager::false_bdd;
+}
+
+bdd model_checker::calculate(const state &s, const del::atom_formula &f) {
+    return s.get_manager()->apply_and(s.get_worlds(), s.get_manager()->get_variable(unprimed(f.get_atom())));
+}
+
+bdd model_checker::calculate(const state &s, const del::not_formula &f) {
+    return s.get_manager()->apply_and(s.get_worlds(), s.get_manager()->apply_not(model_checker::calculate(s, *f.get_f())));
+}
+
+bdd model_checker::calculate(const state &s, const del::and_formula &f) {
+    bdd result = s.get_worlds();
+
+    for (auto it = f.get_fs().begin(); it != f.get_fs().end() and result != bdd_manager::false_bdd; ++it)
+        result = s.get_manager()->apply_and(result, model_checker::calculate(s, **it));
+    return result;
+}
+
+bdd model_checker::calculate(const state &s, const del::or_formula &f) {
+    bdd result = bdd_manager::false_bdd;
+
+    for (const del::formula_ptr &f_ : f.get_fs())
+        result = s.get_manager()->apply_or(result, model_checker::calculate(s, *f_));
+    return result;
+}
+
+bdd model_checker::calculate(const state &s, const del::imply_formula &f) {
+    const bdd premise = s.get_manager()->apply_not(model_checker::calculate(s, *f.get_f1()));
+    return s.get_manager()->apply_and(s.get_worlds(), s.get_manager()->apply_or(premise, model_checker::calculate(s, *f.get_f2())));
+}
+
+bdd model_checker::calculate(const state &s, const del::box_formula &f) {
+    // Box f holds in the worlds that have no ag-successor where f does not hold
+    const bdd counterexamples = s.get_manager()->apply_and(s.get_worlds(), s.get_manager()->apply_not(model_checker::calculate(s, *f.get_f())));
+    return s.get_manager()->apply_and(s.get_worlds(), s.get_manager()->apply_not(calculate_preimage(s, f.get_ag(), counterexamples)));
+}
+
+bdd model_checker::calculate(const state &s, const del::diamond_formula &f) {
+    return calculate_preimage(s, f.get_ag(), model_checker::calculate(s, *f.get_f()));
+}
+
+bdd model_checker::calculate_preimage(const state &s, const del::agent ag, const bdd worlds) {
+    const bdd_manager_ptr &manager = s.get_manager();
+    const bdd targets = manager->rename(worlds, get_priming(s.get_variables_number()));
+    return manager->and_exists(s.get_agent_relation(ag), targets, manager->get_cube(s.get_primed_variables()));
+}
@@ -0,0 +1,111 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "../../../../../include/del/semantics/symbolic/states/state.h"
+#include "../../../../../include/del/semantics/symbolic/model_checker.h"
+#include <utility>
+
+using namespace symbolic;
+
+state::state(del::language_ptr language, bdd_manager_ptr manager, const unsigned long variables_number, const bdd worlds,
+             relations relations, const bdd designated_worlds) :
+        m_language{std::move(language)},
+        m_manager{std::move(manager)},
+        m_variables_number{variables_number},
+        m_worlds{worlds},
+        m_relations{std::move(relations)},
+        m_designated_worlds{designated_worlds} {}
+
+state state::build_knowledge_structure(const del::language_ptr &language, const bdd_manager_ptr &manager,
+                                       const del::formula &law, const std::vector<std::vector<del::atom>> &observables,
+                                       const del::formula &designated) {
+    const unsigned long variables_number = language->get_atoms_number();
+    const relations all_relations = relations(language->get_agents_number(), bdd_manager::true_bdd);
+
+    // The law and the designated worlds are evaluated in the state with all the valuations of the atoms
+    const state all_worlds{language, manager, variables_number, bdd_manager::true_bdd, all_relations, bdd_manager::true_bdd};
+    const bdd worlds = model_checker::calculate(all_worlds, law);
+    const bdd designated_worlds = manager->apply_and(worlds, model_checker::calculate(all_worlds, designated));
+
+    const bdd pairs = manager->apply_and(worlds, manager->rename(worlds, get_priming(variables_number)));
+    relations r = relations(language->get_agents_number());
+
+    for (del::agent ag = 0; ag < language->get_agents_number(); ++ag) {
+        r[ag] = pairs;
+
+        for (const del::atom p : observables[ag])
+            r[ag] = manager->apply_and(r[ag], manager->apply_iff(manager->get_variable(unprimed(p)), manager->get_variable(primed(p))));
+    }
+    return state{language, manager, variables_number, worlds, std::move(r), designated_worlds};
+}
+
+del::language_ptr state::get_language() const {
+    return m_language;
+}
+
+const bdd_manager_ptr &state::get_manager() const {
+    return m_manager;
+}
+
+unsigned long state::get_variables_number() const {
+    return m_variables_number;
+}
+
+bdd state::get_worlds() const {
+    return m_worlds;
+}
+
+bdd state::get_agent_relation(const del::agent ag) const {
+    return m_relations[ag];
+}
+
+bdd state::get_designated_worlds() const {
+    return m_designated_worlds;
+}
+
+double state::get_worlds_number() const {
+    return m_manager->count_models(m_worlds, get_variables());
+}
+
+variables state::get_variables() const {
+    variables xs(m_variables_number);
+
+    for (variable x = 0; x < m_variables_number; ++x)
+        xs[x] = unprimed(x);
+    return xs;
+}
+
+variables state::get_primed_variables() const {
+    variables xs(m_variables_number);
+
+    for (variable x = 0; x < m_variables_number; ++x)
+        xs[x] = primed(x);
+    return xs;
+}
+
+bool state::satisfies(const del::formula_ptr &f) const {
+    // All the designated worlds must satisfy f
+    const bdd counterexamples = m_manager->apply_and(m_designated_worlds, m_manager->apply_not(model_checker::calculate(*this, *f)));
+    return counterexamples == bdd_manager::false_bdd;
+}
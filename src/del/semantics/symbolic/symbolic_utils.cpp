@@ -0,0 +1,182 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "../../../../include/del/semantics/symbolic/symbolic_utils.h"
+#include "../../../../include/utils/storage.h"
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+
+using namespace symbolic;
+
+state symbolic_utils::convert(const kripke::state &s, const del::label_storage &l_storage, const bdd_manager_ptr &manager) {
+    const del::atom atoms_number = s.get_language()->get_atoms_number();
+    std::unordered_map<kripke::label_id, unsigned long long> labels_counts;
+    std::vector<unsigned long long> indices(s.get_worlds_number());
+
+    for (kripke::world_id w = 0; w < s.get_worlds_number(); ++w)
+        indices[w] = labels_counts[s.get_label_id(w)]++;
+
+    unsigned long auxiliary_bits = 0;
+
+    for (const auto &[l, count] : labels_counts)
+        while ((1ull << auxiliary_bits) < count)
+            ++auxiliary_bits;
+
+    const unsigned long variables_number = atoms_number + auxiliary_bits;
+    variables atoms_variables(atoms_number), auxiliary_variables(auxiliary_bits);
+
+    for (del::atom p = 0; p < atoms_number; ++p)
+        atoms_variables[p] = unprimed(p);
+
+    for (unsigned long i = 0; i < auxiliary_bits; ++i)
+        auxiliary_variables[i] = unprimed(atoms_number + i);
+
+    // Each world is encoded by the minterm of its label and of its index
+    std::vector<bdd> minterms(s.get_worlds_number());
+    bdd worlds = bdd_manager::false_bdd, designated_worlds = bdd_manager::false_bdd;
+
+    for (kripke::world_id w = 0; w < s.get_worlds_number(); ++w) {
+        const auto &bitset = l_storage.get(s.get_label_id(w))->get_bitset();
+        bdd minterm = manager->get_minterm(auxiliary_variables, indices[w]);
+
+        for (del::atom p = 0; p < atoms_number; ++p) {
+            const bdd x = manager->get_variable(atoms_variables[p]);
+            minterm = manager->apply_and(minterm, bitset[p] ? x : manager->apply_not(x));
+        }
+
+        minterms[w] = minterm;
+        worlds = manager->apply_or(worlds, minterm);
+    }
+
+    for (const kripke::world_id wd : s.get_designated_worlds())
+        designated_worlds = manager->apply_or(designated_worlds, minterms[wd]);
+
+    // The relation of ag is calculated once per row: the worlds with the same row are paired with the successors in the row
+    const variables priming = get_priming(variables_number);
+    relations r = relations(s.get_language()->get_agents_number());
+
+    for (del::agent ag = 0; ag < s.get_language()->get_agents_number(); ++ag) {
+        std::vector<bdd> sources(s.get_agent_rows_number(ag), bdd_manager::false_bdd);
+
+        for (kripke::world_id w = 0; w < s.get_worlds_number(); ++w)
+            sources[s.get_agent_row_id(ag, w)] = manager->apply_or(sources[s.get_agent_row_id(ag, w)], minterms[w]);
+
+        r[ag] = bdd_manager::false_bdd;
+
+        for (kripke::row_id i = 0; i < s.get_agent_rows_number(ag); ++i) {
+            bdd targets = bdd_manager::false_bdd;
+
+            for (const kripke::world_id v : s.get_agent_row(ag, i))
+                targets = manager->apply_or(targets, minterms[v]);
+
+            r[ag] = manager->apply_or(r[ag], manager->apply_and(sources[i], manager->rename(targets, priming)));
+        }
+    }
+
+    return state{s.get_language(), manager, variables_number, worlds, std::move(r), designated_worlds};
+}
+
+state symbolic_utils::reduce(const state &s) {
+    const bdd_manager_ptr &manager = s.get_manager();
+    const del::agent agents_number = s.get_language()->get_agents_number();
+    const unsigned long n = s.get_variables_number(), atoms_number = s.get_language()->get_atoms_number();
+
+    // The image of the reachable worlds through the relations is calculated over the primed variables, and then unprimed
+    const bdd variables_cube = manager->get_cube(s.get_variables());
+    variables unpriming(2 * n);
+
+    for (variable x = 0; x < n; ++x)
+        unpriming[unprimed(x)] = unpriming[primed(x)] = unprimed(x);
+
+    bdd worlds = s.get_designated_worlds(), previous;
+
+    do {
+        previous = worlds;
+
+        for (del::agent ag = 0; ag < agents_number; ++ag)
+            worlds = manager->apply_or(worlds, manager->rename(
+                    manager->and_exists(previous, s.get_agent_relation(ag), variables_cube), unpriming));
+    } while (worlds != previous);
+
+    const bdd pairs = manager->apply_and(worlds, manager->rename(worlds, get_priming(n)));
+    bdd designated_worlds = s.get_designated_worlds();
+    relations r = relations(agents_number), projected_r = relations(agents_number);
+
+    for (del::agent ag = 0; ag < agents_number; ++ag)
+        r[ag] = manager->apply_and(s.get_agent_relation(ag), pairs);
+
+    // Quantifying the variables ys away maps each world to its values of the other variables. This map is a bisimulation
+    // iff the successors of each world, projected, are the projected successors of all the worlds with its image
+    const auto project = [&](const variables &ys) {
+        variables unprimed_ys(ys.size()), primed_ys(ys.size());
+        std::transform(ys.begin(), ys.end(), unprimed_ys.begin(), unprimed);
+        std::transform(ys.begin(), ys.end(), primed_ys.begin(), primed);
+
+        const bdd cube = manager->get_cube(unprimed_ys), primed_cube = manager->get_cube(primed_ys);
+
+        for (del::agent ag = 0; ag < agents_number; ++ag) {
+            const bdd successors = manager->exists(r[ag], primed_cube);
+            projected_r[ag] = manager->exists(successors, cube);
+
+            if (manager->apply_and(worlds, projected_r[ag]) != successors)
+                return false;
+        }
+
+        std::swap(r, projected_r);
+        worlds = manager->exists(worlds, cube);
+        designated_worlds = manager->exists(designated_worlds, cube);
+        return true;
+    };
+
+    // We first try to remove all the auxiliary variables, and otherwise we remove them one at a time
+    variables auxiliary_variables, kept_variables;
+
+    for (variable x = atoms_number; x < n; ++x)
+        auxiliary_variables.push_back(x);
+
+    if (not auxiliary_variables.empty() and not project(auxiliary_variables))
+        for (const variable y : auxiliary_variables)
+            if (not project({y}))
+                kept_variables.push_back(y);
+
+    // The kept variables are renamed to the first auxiliary variables, preserving their order
+    variables renaming(2 * n);
+
+    for (variable x = 0; x < n; ++x) {
+        renaming[unprimed(x)] = unprimed(x);
+        renaming[primed(x)] = primed(x);
+    }
+
+    for (unsigned long i = 0; i < kept_variables.size(); ++i) {
+        renaming[unprimed(kept_variables[i])] = unprimed(atoms_number + i);
+        renaming[primed(kept_variables[i])] = primed(atoms_number + i);
+    }
+
+    for (del::agent ag = 0; ag < agents_number; ++ag)
+        r[ag] = manager->rename(r[ag], renaming);
+
+    return state{s.get_language(), manager, atoms_number + kept_variables.size(), manager->rename(worlds, renaming),
+                 std::move(r), manager->rename(designated_worlds, renaming)};
+}
@@ -0,0 +1,158 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "../../../../../include/del/semantics/symbolic/update/updater.h"
+#include "../../../../../include/del/semantics/symbolic/model_checker.h"
+#include <algorithm>
+#include <set>
+#include <unordered_map>
+
+using namespace symbolic;
+
+bool updater::is_applicable(const state &s, const kripke::action &a) {
+    // Each designated world must satisfy the precondition of some designated event
+    const bdd_manager_ptr &manager = s.get_manager();
+    bdd applicable = bdd_manager::false_bdd;
+
+    for (const kripke::event_id ed : a.get_sorted_designated_events())
+        applicable = manager->apply_or(applicable, model_checker::calculate(s, a.get_formula(a.get_precondition_id(ed))));
+
+    return manager->apply_and(s.get_designated_worlds(), manager->apply_not(applicable)) == bdd_manager::false_bdd;
+}
+
+state updater::product_update(const state &s, const kripke::action &a) {
+    const bdd_manager_ptr &manager = s.get_manager();
+    const std::vector<del::atom> changed_atoms = calculate_changed_atoms(a);
+
+    const unsigned long n = s.get_variables_number(), event_bits = calculate_event_bits(a);
+    const unsigned long variables_number = n + changed_atoms.size() + event_bits;
+
+    // The old values of the changed atoms are moved to the copy variables n, ..., n + |changed_atoms| - 1
+    variables copying(2 * n);
+
+    for (variable x = 0; x < n; ++x) {
+        copying[unprimed(x)] = unprimed(x);
+        copying[primed(x)] = primed(x);
+    }
+
+    for (unsigned long i = 0; i < changed_atoms.size(); ++i) {
+        copying[unprimed(changed_atoms[i])] = unprimed(n + i);
+        copying[primed(changed_atoms[i])] = primed(n + i);
+    }
+
+    variables events_variables(event_bits), events_primed_variables(event_bits);
+
+    for (unsigned long j = 0; j < event_bits; ++j) {
+        events_variables[j] = unprimed(n + changed_atoms.size() + j);
+        events_primed_variables[j] = primed(n + changed_atoms.size() + j);
+    }
+
+    // The formulas of the action are evaluated once in s, and then moved to the vocabulary of the updated state
+    std::unordered_map<kripke::formula_id, bdd> formulas;
+
+    const auto calculate = [&](const kripke::formula_id f) {
+        const auto [it, is_new] = formulas.try_emplace(f, bdd_manager::false_bdd);
+
+        if (is_new)
+            it->second = manager->rename(model_checker::calculate(s, a.get_formula(f)), copying);
+        return it->second;
+    };
+
+    std::vector<bdd> events(a.get_events_number()), primed_events(a.get_events_number());
+    bdd worlds = bdd_manager::false_bdd;
+
+    for (kripke::event_id e = 0; e < a.get_events_number(); ++e) {
+        events[e] = manager->get_minterm(events_variables, e);
+        primed_events[e] = manager->get_minterm(events_primed_variables, e);
+
+        bdd worlds_e = manager->apply_and(events[e], calculate(a.get_precondition_id(e)));
+
+        if (worlds_e == bdd_manager::false_bdd)
+            continue;
+
+        // Each changed atom either takes the value of its postcondition, or keeps its old value
+        const kripke::postconditions_span post = a.get_compiled_postconditions(e);
+        auto it = post.begin();
+
+        for (unsigned long i = 0; i < changed_atoms.size(); ++i) {
+            while (it != post.end() and it->first < changed_atoms[i])
+                ++it;
+
+            const bool has_post = a.is_ontic(e) and it != post.end() and it->first == changed_atoms[i];
+            const bdd value = has_post ? calculate(it->second) : manager->get_variable(unprimed(n + i));
+            worlds_e = manager->apply_and(worlds_e, manager->apply_iff(manager->get_variable(unprimed(changed_atoms[i])), value));
+        }
+        worlds = manager->apply_or(worlds, worlds_e);
+    }
+
+    worlds = manager->apply_and(worlds, manager->rename(s.get_worlds(), copying));
+
+    bdd designated_events = bdd_manager::false_bdd;
+
+    for (const kripke::event_id ed : a.get_sorted_designated_events())
+        designated_events = manager->apply_or(designated_events, events[ed]);
+
+    const bdd designated_worlds = manager->apply_and(manager->apply_and(worlds, designated_events),
+                                                     manager->rename(s.get_designated_worlds(), copying));
+
+    // The relation of ag pairs the updated worlds whose worlds and events are related in s and in a
+    const bdd pairs = manager->apply_and(worlds, manager->rename(worlds, get_priming(variables_number)));
+    relations r = relations(s.get_language()->get_agents_number());
+
+    for (del::agent ag = 0; ag < s.get_language()->get_agents_number(); ++ag) {
+        bdd events_relation = bdd_manager::false_bdd;
+
+        for (kripke::event_id e = 0; e < a.get_events_number(); ++e) {
+            bdd successors = bdd_manager::false_bdd;
+
+            for (const kripke::event_id f : a.get_agent_successors(ag, e))
+                successors = manager->apply_or(successors, primed_events[f]);
+
+            events_relation = manager->apply_or(events_relation, manager->apply_and(events[e], successors));
+        }
+
+        r[ag] = manager->apply_and(manager->apply_and(manager->rename(s.get_agent_relation(ag), copying), events_relation), pairs);
+    }
+
+    return state{s.get_language(), manager, variables_number, worlds, std::move(r), designated_worlds};
+}
+
+std::vector<del::atom> updater::calculate_changed_atoms(const kripke::action &a) {
+    std::set<del::atom> changed_atoms;
+
+    for (kripke::event_id e = 0; e < a.get_events_number(); ++e)
+        if (a.is_ontic(e))
+            for (const auto &[p, post] : a.get_compiled_postconditions(e))
+                changed_atoms.emplace(p);
+
+    return {changed_atoms.begin(), changed_atoms.end()};
+}
+
+unsigned long updater::calculate_event_bits(const kripke::action &a) {
+    unsigned long bits = 0;
+
+    while ((1ull << bits) < a.get_events_number())
+        ++bits;
+    return bits;
+}
@@ -24,6 +24,7 @@
 #include "../include/utils/clipp.h"
 #include "../tests/search_tester.h"
 #include "../tests/action_tester.h"
+#include "../tests/update_tester.h"
 #include "../tests/builder/domains/consecutive_numbers.h"
 #include "../tests/printer.h"
 #include "../tests/builder/domains/collaboration_communication.h"
@@ -33,6 +34,7 @@
 #include "../tests/builder/state_builder.h"
 #include "../include/del/semantics/kripke/bisimulation/bounded_identification.h"
 #include "../include/utils/storage.h"
+#include "../include/utils/thread_pool.h"
 #include "../tests/builder/domains/tiger.h"
 #include "../tests/builder/domains/gossip.h"
 #include "../include/utils/printer/formula_printer.h"
@@ -42,6 +44,7 @@
 #include "../include/del/semantics/delphic/delphic_utils.h"
 #include "../include/del/semantics/delphic/update/union_updater.h"
 #include "../include/search/delphic/delphic_planner.h"
+#include "../include/search/symbolic/symbolic_planner.h"
 #include "../tests/builder/domains/selective_communication.h"
 #include "../tests/builder/domains/eavesdropping.h"
 #include <memory>
@@ -55,11 +58,10 @@ using namespace daedalus::tester;
 using namespace clipp;
 
 //void storage_test();
-void run(int argc, char *argv[]);
+int run(int argc, char *argv[]);
 
 int main(int argc, char *argv[]) {
-    run(argc, argv);
-    return 0;
+    return run(argc, argv);
 }
 
 /*void storage_test() {
@@ -97,20 +99,26 @@ int main(int argc, char *argv[]) {
     assert(*sign_x_h == *sign_y_h);
 }*/
 
-void run(int argc, char *argv[]) {
+int run(int argc, char *argv[]) {
     std::string semantics = "kripke", strategy = "unbounded", contraction_type = "full", bound;
+    std::string parallelism, order = "bfs", heuristic = "goal_count";
     std::string domain;
     std::vector<std::string> parameters, actions;
     bool print_results = false, print_info = false, debug = false, ma_star = false;
+    unsigned long threads_number = thread_pool::get_instance().get_threads_number();
 
     auto cli = (
             required("-d", "--domain") & value("domain", domain),
             required("-p", "--parameters") & values("parameters", parameters),
-            option("-s", "--semantics") & value("semantics", semantics).doc("Selects the preferred DEL semantics ('kripke' or 'delphic')"),
+            option("-s", "--semantics") & value("semantics", semantics).doc("Selects the preferred DEL semantics ('kripke', 'delphic' or 'symbolic', which only supports the unbounded strategy)"),
             option("-t", "--strategy" ) & value("strategy", strategy).doc("Selects the search strategy ('unbounded' or 'bounded')"),
             option("-c", "--contraction" ) & value("contraction type", contraction_type).doc("Selects the type of bisimulation contraction to perform ('full', 'rooted' or 'canonical')"),
             option("-a", "--actions" ) & values("actions", actions).doc("Actions to execute"),
             option("-b", "--bound" ) & values("bound", bound).doc("Initial bound"),
+            option("--threads") & value("threads", threads_number).doc("Number of threads used by the search (by default, all hardware threads)"),
+            option("--parallelism") & value("parallelism", parallelism).doc("Selects what the threads calculate in parallel: the children of whole search layers, of single nodes, or both ('layers', 'nodes', 'all' or 'none'). By default, 'all' with more than one thread and 'none' otherwise"),
+            option("--search") & value("search order", order).doc("Selects the order in which nodes are expanded ('bfs', 'greedy' or 'astar'). Only 'bfs' finds shortest plans: the heuristics are not admissible, so 'astar' is not optimal"),
+            option("--heuristic") & value("heuristic", heuristic).doc("Selects the heuristic of greedy and A* search ('goal_count' or 'relaxed')"),
             option("--print").set(print_results).doc("Print time results"),
             option("--info").set(print_info),
             option("--debug").set(debug),
@@ -119,9 +127,19 @@ void run(int argc, char *argv[]) {
 
     if (not parse(argc, argv, cli)) {
         std::cout << make_man_page(cli, argv[0]);
-        return;
+        return 0;
+    }
+
+    if (semantics == "symbolic" and strategy != "unbounded") {
+        std::cout << "The symbolic semantics only supports the unbounded strategy" << std::endl;
+        return 1;
     }
 
+    thread_pool::get_instance().set_threads_number(threads_number);
+
+    if (parallelism.empty())
+        parallelism = thread_pool::get_instance().get_threads_number() > 1 ? "all" : "none";
+
     search::planning_task_ptr task;
     del::label_storage l_storage;
 
@@ -156,7 +174,7 @@ void run(int argc, char *argv[]) {
         else if (domain == "tiger" or domain == "tig")
             tiger::write_ma_star_problem(std::stoul(parameters[0]), std::stoul(parameters[1]), l_storage);
 
-        return;
+        return 0;
     }
 
 //    search::delphic_planning_task task_ = delphic_utils::convert(*task);
@@ -165,6 +183,11 @@ void run(int argc, char *argv[]) {
     search::strategy t = strategy == "unbounded" ? search::strategy::unbounded_search :
             (strategy == "bounded" ? search::strategy::iterative_bounded_search : search::strategy::approx_iterative_bounded_search);
     enum contraction_type type = contraction_type == "full" ? contraction_type::full : (contraction_type == "rooted" ? contraction_type::rooted : contraction_type::canonical);
+    search::parallelism p = parallelism == "none" ? search::parallelism::none : (parallelism == "layers" ? search::parallelism::layers :
+            (parallelism == "nodes" ? search::parallelism::nodes : search::parallelism::layers_and_nodes));
+    search::search_order o = order == "greedy" ? search::search_order::greedy_best_first :
+            (order == "astar" ? search::search_order::astar : search::search_order::breadth_first);
+    search::heuristic_type h = heuristic == "relaxed" ? search::heuristic_type::relaxed_plan : search::heuristic_type::goal_count;
 
     if (debug) {
         if (actions.empty()) {
@@ -177,6 +200,14 @@ void run(int argc, char *argv[]) {
 
             if (semantics == "kripke") {
                 kripke::action_deque as = task->get_actions(actions);
+
+                // The whole sequence is also applied as a single macro-action, which must give the same state. The printer
+                // consumes the sequence, so we check this first
+                if (as.size() > 1)
+                    daedalus::tester::update_tester::test_composition(*task->get_initial_state(), as,
+                                                                      *task->get_macro_action(actions),
+                                                                      handler->get_label_storage());
+
 //                daedalus::tester::printer::print_state(*task->get_initial_state(), OUT_PATH + path, "s0");
                 state_deque ss = {task->get_initial_state()};
                 unsigned long b = bound.empty() ? task->get_goal()->get_modal_depth() : std::stoul(bound);
@@ -220,13 +251,15 @@ void run(int argc, char *argv[]) {
         if (not print_info) {
             if (semantics == "kripke") {
                 if (print_results) daedalus::tester::printer::print_time_results(*task, t, type, handler, out_file);
-                else search::planner::search(*task, t, type, handler);
+                else search::planner::search(*task, t, type, handler, nullptr, p, o, h);
             } else if (semantics == "delphic") {
 //                if (print_results) daedalus::tester::printer::print_delphic_time_results(task_, t, out_file);
 //                else search::delphic_planner::search(task_, t);
-            }
+            } else if (semantics == "symbolic")
+                search::symbolic_planner::search(*task, t, handler);
         }
 
         out_file.close();
     }
+    return 0;
 }
@@ -0,0 +1,149 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <algorithm>
+#include "../../include/search/action_index.h"
+#include "../../include/del/formulas/all_formulas.h"
+#include "../../include/utils/storage.h"
+
+using namespace search;
+
+action_index::action_index(const kripke::action_deque &actions, const del::atom atoms_number) :
+        m_atoms_number{atoms_number} {
+    m_skeletons.reserve(actions.size());
+
+    for (const kripke::action_ptr &a : actions) {
+        events_skeletons skeletons;
+
+        for (const kripke::event_id ed : a->get_sorted_designated_events())
+            if (skeleton s = calculate_skeleton(*a->get_precondition(ed), true); not s.m_is_unsatisfiable)
+                skeletons.push_back(std::move(s));
+
+        m_positions.emplace(a.get(), m_skeletons.size());
+        m_skeletons.push_back(std::move(skeletons));
+    }
+}
+
+boost::dynamic_bitset<> action_index::get_candidates(const kripke::state &s, const del::label_storage &l_storage) const {
+    if (m_memo_storage != &l_storage) {             // Label ids are only meaningful within their own storage
+        m_labels_memo.clear();
+        m_memo_storage = &l_storage;
+    }
+
+    boost::dynamic_bitset<> candidates(m_skeletons.size());
+    candidates.set();
+
+    for (const kripke::world_id wd : s.get_designated_worlds())
+        candidates &= get_label_candidates(s.get_label_id(wd), l_storage);
+
+    return candidates;
+}
+
+bool action_index::is_candidate(const boost::dynamic_bitset<> &candidates, const kripke::action &a) const {
+    const auto it = m_positions.find(&a);
+    return it == m_positions.end() or candidates[it->second];
+}
+
+const boost::dynamic_bitset<> &action_index::get_label_candidates(const kripke::label_id l, const del::label_storage &l_storage) const {
+    if (const auto it = m_labels_memo.find(l); it != m_labels_memo.end())
+        return it->second;
+
+    const boost::dynamic_bitset<> bitset = l_storage.get(l)->get_bitset();
+    boost::dynamic_bitset<> candidates(m_skeletons.size());
+
+    const auto matches = [&](const skeleton &s) {
+        return s.m_positive.is_subset_of(bitset) and not s.m_negative.intersects(bitset);
+    };
+
+    for (std::size_t i = 0; i < m_skeletons.size(); ++i)
+        candidates[i] = std::any_of(m_skeletons[i].begin(), m_skeletons[i].end(), matches);
+
+    return m_labels_memo.emplace(l, std::move(candidates)).first->second;
+}
+
+action_index::skeleton action_index::calculate_skeleton(const del::formula &f, const bool positive) const {
+    // We compute a necessary condition for f (resp. not f, if positive is false) to hold in a world. Modal subformulas
+    // are not required to hold in the world itself, so they give no condition
+    switch (f.get_type()) {
+        case del::formula_type::true_formula:
+            return make_skeleton(not positive);
+        case del::formula_type::false_formula:
+            return make_skeleton(positive);
+        case del::formula_type::atom_formula: {
+            skeleton s = make_skeleton();
+            (positive ? s.m_positive : s.m_negative).set(dynamic_cast<const del::atom_formula &>(f).get_atom());
+            return s;
+        }
+        case del::formula_type::not_formula:
+            return calculate_skeleton(*dynamic_cast<const del::not_formula &>(f).get_f(), not positive);
+        case del::formula_type::and_formula:
+        case del::formula_type::or_formula: {
+            const bool is_and = f.get_type() == del::formula_type::and_formula;
+            const del::formula_deque &fs = is_and ? dynamic_cast<const del::and_formula &>(f).get_fs()
+                                                  : dynamic_cast<const del::or_formula &>(f).get_fs();
+
+            // By De Morgan's laws, a negated conjunction is a disjunction and vice versa
+            const bool is_conjunction = is_and == positive;
+            skeleton s = make_skeleton(not is_conjunction);
+
+            for (const del::formula_ptr &g : fs)
+                is_conjunction ? conjoin(s, calculate_skeleton(*g, positive)) : disjoin(s, calculate_skeleton(*g, positive));
+            return s;
+        }
+        case del::formula_type::imply_formula: {
+            const auto &f_ = dynamic_cast<const del::imply_formula &>(f);
+            skeleton s = calculate_skeleton(*f_.get_f1(), not positive);
+
+            positive ? disjoin(s, calculate_skeleton(*f_.get_f2(), true))
+                     : conjoin(s, calculate_skeleton(*f_.get_f2(), false));
+            return s;
+        }
+        case del::formula_type::box_formula:
+        case del::formula_type::diamond_formula:
+            return make_skeleton();
+    }
+    return make_skeleton();
+}
+
+action_index::skeleton action_index::make_skeleton(const bool is_unsatisfiable) const {
+    return skeleton{boost::dynamic_bitset<>(m_atoms_number), boost::dynamic_bitset<>(m_atoms_number), is_unsatisfiable};
+}
+
+void action_index::conjoin(skeleton &s1, const skeleton &s2) {
+    s1.m_positive |= s2.m_positive;
+    s1.m_negative |= s2.m_negative;
+    s1.m_is_unsatisfiable = s1.m_is_unsatisfiable or s2.m_is_unsatisfiable or s1.m_positive.intersects(s1.m_negative);
+}
+
+void action_index::disjoin(skeleton &s1, const skeleton &s2) {
+    if (s2.m_is_unsatisfiable)
+        return;
+
+    if (s1.m_is_unsatisfiable) {
+        s1 = s2;
+        return;
+    }
+    s1.m_positive &= s2.m_positive;
+    s1.m_negative &= s2.m_negative;
+}
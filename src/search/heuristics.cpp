@@ -0,0 +1,185 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <algorithm>
+#include "../../include/search/heuristics.h"
+#include "../../include/search/planning_task.h"
+#include "../../include/del/semantics/kripke/model_checker.h"
+#include "../../include/del/formulas/all_formulas.h"
+#include "../../include/utils/storage.h"
+
+using namespace search;
+
+heuristic_ptr heuristic::build(const heuristic_type type, const planning_task &task) {
+    switch (type) {
+        case heuristic_type::goal_count:
+            return std::make_shared<goal_count_heuristic>(task.get_goal());
+        case heuristic_type::relaxed_plan:
+            return std::make_shared<relaxed_plan_heuristic>(task);
+    }
+    return nullptr;
+}
+
+goal_count_heuristic::goal_count_heuristic(const del::formula_ptr &goal) {
+    add_conjuncts(goal);
+}
+
+unsigned long goal_count_heuristic::evaluate(const kripke::state &s, const del::label_storage &l_storage) const {
+    kripke::model_checker::rows_memo memo;
+
+    return std::count_if(m_conjuncts.begin(), m_conjuncts.end(), [&](const del::formula_ptr &f) {
+        return std::any_of(s.get_designated_worlds().begin(), s.get_designated_worlds().end(),
+                           [&](const kripke::world_id wd) { return not kripke::model_checker::holds_in(s, wd, *f, l_storage, memo); });
+    });
+}
+
+void goal_count_heuristic::add_conjuncts(const del::formula_ptr &f) {
+    if (f->get_type() == del::formula_type::and_formula)
+        for (const del::formula_ptr &g : std::dynamic_pointer_cast<del::and_formula>(f)->get_fs())
+            add_conjuncts(g);
+    else if (f->get_type() != del::formula_type::true_formula)
+        m_conjuncts.push_back(f);
+}
+
+relaxed_plan_heuristic::relaxed_plan_heuristic(const planning_task &task) :
+        m_atoms_number{task.get_language()->get_atoms_number()},
+        m_goal{calculate_literals(*task.get_goal(), true)} {
+    for (const kripke::action_ptr &a : task.get_actions())
+        for (kripke::event_id e = 0; e < a->get_events_number(); ++e) {
+            relaxed_event event{calculate_literals(*a->get_precondition(e), true), make_literals()};
+
+            if (event.m_precondition.m_is_unsatisfiable or not a->is_ontic(e))
+                continue;
+
+            // Postconditions that are not constant may give both truth values, depending on the world
+            for (const auto &[p, f] : a->get_postconditions(e)) {
+                if (f->get_type() != del::formula_type::false_formula) event.m_effects.m_positive.set(p);
+                if (f->get_type() != del::formula_type::true_formula)  event.m_effects.m_negative.set(p);
+            }
+
+            if (event.m_effects.m_positive.any() or event.m_effects.m_negative.any())
+                m_events.push_back(std::move(event));
+        }
+}
+
+unsigned long relaxed_plan_heuristic::evaluate(const kripke::state &s, const del::label_storage &l_storage) const {
+    literals reached = make_literals();
+
+    for (kripke::world_id w = 0; w < s.get_worlds_number(); ++w) {
+        const boost::dynamic_bitset<> bitset = l_storage.get(s.get_label_id(w))->get_bitset();
+        reached.m_positive |= bitset;
+        reached.m_negative |= ~bitset;
+    }
+
+    boost::dynamic_bitset<> missing_positive = m_goal.m_positive - reached.m_positive,
+                            missing_negative = m_goal.m_negative - reached.m_negative;
+    unsigned long h = 0, layer = 0;
+
+    while (missing_positive.any() or missing_negative.any()) {
+        literals next = reached;
+        ++layer;
+
+        for (const relaxed_event &event : m_events)
+            if (event.m_precondition.m_positive.is_subset_of(reached.m_positive) and
+                event.m_precondition.m_negative.is_subset_of(reached.m_negative)) {
+                next.m_positive |= event.m_effects.m_positive;
+                next.m_negative |= event.m_effects.m_negative;
+            }
+
+        // Literals that can not be reached even in the relaxation are given the cost of the first layer that fails
+        if (next.m_positive == reached.m_positive and next.m_negative == reached.m_negative)
+            return h + layer * (missing_positive.count() + missing_negative.count());
+
+        h += layer * ((missing_positive & next.m_positive).count() + (missing_negative & next.m_negative).count());
+        missing_positive -= next.m_positive;
+        missing_negative -= next.m_negative;
+        reached = std::move(next);
+    }
+    return h;
+}
+
+relaxed_plan_heuristic::literals relaxed_plan_heuristic::calculate_literals(const del::formula &f, const bool positive) const {
+    switch (f.get_type()) {
+        case del::formula_type::true_formula:
+            return make_literals(not positive);
+        case del::formula_type::false_formula:
+            return make_literals(positive);
+        case del::formula_type::atom_formula: {
+            literals ls = make_literals();
+            (positive ? ls.m_positive : ls.m_negative).set(dynamic_cast<const del::atom_formula &>(f).get_atom());
+            return ls;
+        }
+        case del::formula_type::not_formula:
+            return calculate_literals(*dynamic_cast<const del::not_formula &>(f).get_f(), not positive);
+        case del::formula_type::and_formula:
+        case del::formula_type::or_formula: {
+            const bool is_and = f.get_type() == del::formula_type::and_formula;
+            const del::formula_deque &fs = is_and ? dynamic_cast<const del::and_formula &>(f).get_fs()
+                                                  : dynamic_cast<const del::or_formula &>(f).get_fs();
+            const bool is_conjunction = is_and == positive;
+            literals ls = make_literals(not is_conjunction);
+
+            for (const del::formula_ptr &g : fs)
+                is_conjunction ? conjoin(ls, calculate_literals(*g, positive)) : disjoin(ls, calculate_literals(*g, positive));
+            return ls;
+        }
+        case del::formula_type::imply_formula: {
+            const auto &f_ = dynamic_cast<const del::imply_formula &>(f);
+            literals ls = calculate_literals(*f_.get_f1(), not positive);
+
+            positive ? disjoin(ls, calculate_literals(*f_.get_f2(), true))
+                     : conjoin(ls, calculate_literals(*f_.get_f2(), false));
+            return ls;
+        }
+        // Unlike in the propositional prefilter of the actions, the literals of modal subformulas are kept: they have
+        // to be true in the worlds considered possible by the agents, which are worlds of the state as well
+        case del::formula_type::box_formula:
+            return calculate_literals(*dynamic_cast<const del::box_formula &>(f).get_f(), positive);
+        case del::formula_type::diamond_formula:
+            return calculate_literals(*dynamic_cast<const del::diamond_formula &>(f).get_f(), positive);
+    }
+    return make_literals();
+}
+
+relaxed_plan_heuristic::literals relaxed_plan_heuristic::make_literals(const bool is_unsatisfiable) const {
+    return literals{boost::dynamic_bitset<>(m_atoms_number), boost::dynamic_bitset<>(m_atoms_number), is_unsatisfiable};
+}
+
+void relaxed_plan_heuristic::conjoin(literals &ls1, const literals &ls2) {
+    ls1.m_positive |= ls2.m_positive;
+    ls1.m_negative |= ls2.m_negative;
+    ls1.m_is_unsatisfiable = ls1.m_is_unsatisfiable or ls2.m_is_unsatisfiable;
+}
+
+void relaxed_plan_heuristic::disjoin(literals &ls1, const literals &ls2) {
+    if (ls2.m_is_unsatisfiable)
+        return;
+
+    if (ls1.m_is_unsatisfiable) {
+        ls1 = ls2;
+        return;
+    }
+    ls1.m_positive &= ls2.m_positive;
+    ls1.m_negative &= ls2.m_negative;
+}
@@ -21,28 +21,43 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <memory>
 #include <ostream>
 #include <unordered_set>
 #include <utility>
 #include <iostream>
+#include <tuple>
 #include <variant>
 #include "../../include/search/planner.h"
 #include "../../include/utils/time_utils.h"
+#include "../../include/utils/thread_pool.h"
+#include "../../include/del/semantics/kripke/bisimulation/bounded_partition_refinement.h"
+#include "../../include/del/semantics/kripke/bisimulation/partition_refinement.h"
 
 using namespace search;
 
 std::pair<node_deque, statistics>
 planner::search(const planning_task &task, const strategy strategy, contraction_type contraction_type,
-                del::storages_handler_ptr handler, const daedalus::tester::printer_ptr &printer) {
-    print_info(task, strategy, contraction_type);
+                del::storages_handler_ptr handler, const daedalus::tester::printer_ptr &printer,
+                const parallelism parallelism, const search_order order, const heuristic_type heuristic_type) {
+    print_info(task, strategy, contraction_type, order, heuristic_type);
     node_deque path;
+    frontier previous_iter_frontier{order, order == search_order::breadth_first ? nullptr : heuristic::build(heuristic_type, task)};
     visited_states visited_states;
     statistics stats{};
 
-    if (contraction_type != kripke::contraction_type::rooted) visited_states = states_ids_set();
-    else visited_states = kripke::state_set();
+    init_visited_states(task, contraction_type, visited_states);
+    node::reset_max_bpr_structures_memory();
+
+    const unsigned long long paige_tarjan_contractions_no =
+        kripke::bisimulator::get_full_contractions_number(kripke::refinement_engine::paige_tarjan);
+    const unsigned long long bounded_contractions_no =
+        kripke::bisimulator::get_full_contractions_number(kripke::refinement_engine::bounded_refinement);
+    const unsigned long long partition_intersection_contractions_no =
+        kripke::bisimulator::get_full_contractions_number(kripke::refinement_engine::partition_intersection);
 
     auto start = std::chrono::high_resolution_clock::now();
 
@@ -55,11 +70,20 @@ planner::search(const planning_task &task, const strategy strategy, contraction_
         stats = statistics{0, 0, 1, n0->get_state()->get_worlds_number(), 0, 0, 0, 0};
     } else
         path = strategy == strategy::unbounded_search ?
-               unbounded_search(task, stats, visited_states, handler, printer) :
-               iterative_bounded_search(task, strategy, contraction_type, stats, visited_states, handler, printer);
+               unbounded_search(task, parallelism, stats, previous_iter_frontier, visited_states, handler, printer) :
+               iterative_bounded_search(task, strategy, contraction_type, parallelism, stats, previous_iter_frontier,
+                                        visited_states, handler, printer);
 
     stats.m_plan_length = path.size() - 1;
     stats.m_computation_time = static_cast<double>(since(start).count()) / 1000;
+    stats.m_max_bpr_structures_memory = node::get_max_bpr_structures_memory();
+    stats.m_paige_tarjan_contractions_no = kripke::bisimulator::get_full_contractions_number(kripke::refinement_engine::paige_tarjan) -
+                                           paige_tarjan_contractions_no;
+    stats.m_bounded_contractions_no = kripke::bisimulator::get_full_contractions_number(kripke::refinement_engine::bounded_refinement) -
+                                      bounded_contractions_no;
+    stats.m_partition_intersection_contractions_no =
+        kripke::bisimulator::get_full_contractions_number(kripke::refinement_engine::partition_intersection) -
+        partition_intersection_contractions_no;
 
     validate(task, path, handler);
     print_statistics(stats, strategy);
@@ -67,11 +91,11 @@ planner::search(const planning_task &task, const strategy strategy, contraction_
     return {std::move(path), stats};
 }
 
-node_deque planner::unbounded_search(const planning_task &task, statistics &stats, visited_states &visited_states,
+node_deque planner::unbounded_search(const planning_task &task, const parallelism parallelism, statistics &stats,
+                                     frontier &previous_iter_frontier, visited_states &visited_states,
                                      del::storages_handler_ptr handler, const daedalus::tester::printer_ptr &printer) {
-    frontier previous_iter_frontier;
     unsigned long long id = 0;
-    auto path = bfs(task, strategy::unbounded_search, contraction_type::full, stats, previous_iter_frontier, 0, id,
+    auto path = bfs(task, strategy::unbounded_search, contraction_type::full, parallelism, stats, previous_iter_frontier, 0, id,
                     visited_states, handler, printer);
 
 //    for (const auto &n: path)
@@ -82,10 +106,10 @@ node_deque planner::unbounded_search(const planning_task &task, statistics &stat
 
 node_deque
 planner::iterative_bounded_search(const planning_task &task, const strategy strategy, contraction_type contraction_type,
-                                  statistics &stats, visited_states &visited_states, del::storages_handler_ptr handler,
+                                  const parallelism parallelism, statistics &stats, frontier &previous_iter_frontier,
+                                  visited_states &visited_states, del::storages_handler_ptr handler,
                                   const daedalus::tester::printer_ptr &printer) {
     unsigned long b = task.get_goal()->get_modal_depth(), iterations = 0;
-    frontier previous_iter_frontier;
     unsigned long long id = 0;
 
     while (true) {
@@ -93,7 +117,7 @@ planner::iterative_bounded_search(const planning_task &task, const strategy stra
         stats.m_iterations_no = iterations++;
         handler->expand_storages();
         // If iteration 'b' produces a valid result, we return it. Otherwise, we move to the next iteration
-        if (node_deque result = bounded_search(task, strategy, contraction_type, stats, previous_iter_frontier, b++, id,
+        if (node_deque result = bounded_search(task, strategy, contraction_type, parallelism, stats, previous_iter_frontier, b++, id,
                                                visited_states, handler, printer); not result.empty())
             return result;
         std::cout << "- No plan found, going to next iteration." << std::endl;
@@ -102,25 +126,24 @@ planner::iterative_bounded_search(const planning_task &task, const strategy stra
 
 node_deque
 planner::bounded_search(const planning_task &task, const strategy strategy, contraction_type contraction_type,
-                        statistics &stats, frontier &previous_iter_frontier, const unsigned long b,
+                        const parallelism parallelism, statistics &stats, frontier &previous_iter_frontier, const unsigned long b,
                         unsigned long long &id,
                         visited_states &visited_states, del::storages_handler_ptr handler,
                         const daedalus::tester::printer_ptr &printer) {
-    return bfs(task, strategy, contraction_type, stats, previous_iter_frontier, b, id, visited_states, handler, printer);
+    return bfs(task, strategy, contraction_type, parallelism, stats, previous_iter_frontier, b, id, visited_states, handler,
+               printer);
 }
 
 node_deque
-planner::bfs(const planning_task &task, const strategy strategy, contraction_type contraction_type, statistics &stats,
-             frontier &previous_iter_frontier, const unsigned long b, unsigned long long &id,
+planner::bfs(const planning_task &task, const strategy strategy, contraction_type contraction_type,
+             const parallelism parallelism, statistics &stats, frontier &previous_iter_frontier, const unsigned long b, unsigned long long &id,
              visited_states &visited_states, del::storages_handler_ptr handler,
              const daedalus::tester::printer_ptr &printer) {
     kripke::state_ptr s0 = task.get_initial_state();
     frontier frontier = init_frontier(s0, strategy, contraction_type, b, previous_iter_frontier, stats, visited_states, handler);
 
-    if (strategy == strategy::approx_iterative_bounded_search) {
-        if (contraction_type != kripke::contraction_type::rooted) visited_states = states_ids_set();
-        else visited_states = kripke::state_set();
-    }
+    if (strategy == strategy::approx_iterative_bounded_search)
+        init_visited_states(task, contraction_type, visited_states);
 
     unsigned long goal_depth = task.get_goal()->get_modal_depth();
     unsigned long long max_graph_depth = 0, is_bisim_graph_depth = 0;     // is_bisim_graph_depth: deepest level of the search graph such that all nodes in the previous levels have is_bisim = true
@@ -133,9 +156,30 @@ planner::bfs(const planning_task &task, const strategy strategy, contraction_typ
 
     if (printer) print_max_graph_depth(printer, max_graph_depth);
 
+    thread_pool &pool = thread_pool::get_instance();
+    std::deque<std::vector<child_update>> layer_updates;
+
     while (not frontier.empty()) {
         node_ptr n = frontier.front();
 
+        // With more than one thread, the children of each layer are calculated in parallel when the layer begins. Layers
+        // that are too small to be split among the threads are left to node parallelism, if any. In best-first orders,
+        // children may be expanded before the rest of the layer of their parent, so only node parallelism is used
+        if ((parallelism == parallelism::layers or parallelism == parallelism::layers_and_nodes) and
+            frontier.get_order() == search_order::breadth_first and pool.get_threads_number() > 1 and
+            layer_updates.empty() and frontier.front_layer().size() >= pool.get_threads_number())
+            layer_updates = calculate_layer(task, strategy, contraction_type, frontier.front_layer(), nullptr, handler);
+
+        frontier.pop_front();
+        ++stats.m_expanded_nodes_no;
+
+        std::vector<child_update> updates;
+
+        if (not layer_updates.empty()) {
+            updates = std::move(layer_updates.front());
+            layer_updates.pop_front();
+        }
+
         if (previous_iter_frontier.empty())
             is_bisim_graph_depth = n->get_graph_depth();
 
@@ -152,8 +196,8 @@ planner::bfs(const planning_task &task, const strategy strategy, contraction_typ
         //      member 'm_to_apply_actions' of the class 'node'.
         //   2. Otherwise, we reached n for the first time. We then expand it wrt the entire set of actions of our task.
         const auto &actions = n->get_to_apply_actions().empty() ? task.get_actions() : n->get_to_apply_actions();
-        node_deque path = expand_node(task, strategy, contraction_type, stats, n, actions, frontier, goal_depth, id,
-                                      visited_states, handler, printer);
+        node_deque path = expand_node(task, strategy, contraction_type, parallelism, stats, n, actions, frontier, goal_depth, id,
+                                      visited_states, handler, printer, std::move(updates));
 
         if (not path.empty()) return path;
 
@@ -161,29 +205,70 @@ planner::bfs(const planning_task &task, const strategy strategy, contraction_typ
             not n->get_to_apply_actions().empty())    // If there exists a node n_ calculated above such that n_.is_bisim
 //            and n->get_graph_depth() == is_bisim_graph_depth)
             previous_iter_frontier.push(n);     // is false, then we need to expand it in the next iteration
-
-        frontier.pop_front();
     }
     return {};
 }
 
+std::deque<std::vector<planner::child_update>>
+planner::calculate_layer(const planning_task &task, const strategy strategy, contraction_type contraction_type,
+                         const node_deque &layer, const heuristic_ptr &heuristic, del::storages_handler_ptr handler) {
+    // The action index memoizes the candidates of the labels it meets, so we query it before going parallel
+    std::vector<boost::dynamic_bitset<>> candidates;
+    std::vector<unsigned long> offsets = {0};       // The updates of the i-th node are the tasks in [offsets[i], offsets[i+1])
+    std::deque<std::vector<child_update>> updates;
+
+    for (const node_ptr &n : layer) {
+        const auto &actions = n->get_to_apply_actions().empty() ? task.get_actions() : n->get_to_apply_actions();
+
+        candidates.push_back(task.get_action_index().get_candidates(*n->get_state(), handler->get_label_storage()));
+        offsets.push_back(offsets.back() + actions.size());
+        updates.emplace_back(actions.size());
+    }
+
+    // Tasks are taken in increasing order within the range of each thread, so we can skip the tasks that come after the
+    // first goal state found so far. The sequential pass calculates them anyway if the goal state was already visited
+    std::atomic<unsigned long> first_goal_task = offsets.back();
+
+    thread_pool::get_instance().run(offsets.back(), [&](const unsigned long t) {
+        if (t > first_goal_task.load(std::memory_order_relaxed))
+            return;
+
+        const auto i = static_cast<std::size_t>(std::upper_bound(offsets.begin(), offsets.end(), t) - offsets.begin() - 1);
+        const node_ptr &n = layer[i];
+        const auto &actions = n->get_to_apply_actions().empty() ? task.get_actions() : n->get_to_apply_actions();
+        child_update &update = updates[i][t - offsets[i]];
+
+        update = calculate_child(task, strategy, contraction_type, n, actions[t - offsets[i]], candidates[i], heuristic, handler,
+                                 true);
+
+        if (update.m_satisfies_goal)
+            for (unsigned long first = first_goal_task.load(); t < first and not first_goal_task.compare_exchange_weak(first, t); ) {}
+    });
+
+    return updates;
+}
+
 frontier planner::init_frontier(kripke::state_ptr &s0, const strategy strategy, contraction_type contraction_type,
                                   const unsigned long b, frontier &previous_iter_frontier, statistics &stats,
                                   visited_states &visited_states, del::storages_handler_ptr handler) {
-    frontier frontier;
+    frontier frontier = previous_iter_frontier.make_empty();
     bool fresh_frontier = previous_iter_frontier.empty() or strategy == strategy::approx_iterative_bounded_search;
 
     if (fresh_frontier) {       // If this is the first iteration or if we are using approximated search
-        node_ptr n0 = init_node(contraction_type, s0, nullptr, true, nullptr, 0, visited_states, handler, b);
+        node_ptr n0 = init_node(contraction_type, s0, nullptr, true, nullptr, 0, visited_states, handler, b,
+                                strategy == strategy::iterative_bounded_search);
 
         if (n0) {
-            update_visited_states(n0->get_state(), visited_states);
+            if (frontier.get_heuristic())
+                n0->set_heuristic_value(frontier.get_heuristic()->evaluate(*n0->get_state(), handler->get_label_storage()));
+
+            update_visited_states(n0->get_state(), n0->get_bound(), visited_states, handler);
             update_statistics(stats, n0);
             frontier.push(n0);
         }
     } else {
         frontier = std::move(previous_iter_frontier);
-        previous_iter_frontier = {};
+        previous_iter_frontier = frontier.make_empty();
 
         for (auto &[_, deq] : frontier.get())
             for (node_ptr &n: deq)    // The nodes in previous_iter_frontier have to be refreshed
@@ -193,17 +278,32 @@ frontier planner::init_frontier(kripke::state_ptr &s0, const strategy strategy,
 }
 
 node_deque planner::expand_node(const planning_task &task, const strategy strategy, contraction_type contraction_type,
-                                statistics &stats, node_ptr &n, const kripke::action_deque &actions,
+                                const parallelism parallelism, statistics &stats, node_ptr &n, const kripke::action_deque &actions,
                                 frontier &frontier, const unsigned long goal_depth, unsigned long long &id,
                                 visited_states &visited_states, del::storages_handler_ptr handler,
-                                const daedalus::tester::printer_ptr &printer) {
+                                const daedalus::tester::printer_ptr &printer, std::vector<child_update> updates) {
     kripke::action_deque to_reapply_actions;
     bool is_dead_node = true;
 
-    for (const kripke::action_ptr &a: actions) {
-        if (strategy == strategy::unbounded_search or n->get_bound() >= a->get_maximum_depth() + task.get_goal()->get_modal_depth()) {
-            if (kripke::updater::is_applicable(*n->get_state(), *a, handler->get_label_storage())) {
-                node_ptr n_ = update_node(strategy, contraction_type, n, a, id, visited_states, handler, goal_depth);
+    // Cheap propositional prefilter: we only model check the preconditions of the actions that survive it
+    const boost::dynamic_bitset<> candidates = task.get_action_index().get_candidates(*n->get_state(), handler->get_label_storage());
+
+    // If the layer of n was not calculated in parallel, we calculate the children of n in parallel as a layer on its own
+    if ((parallelism == parallelism::nodes or parallelism == parallelism::layers_and_nodes) and updates.empty() and
+        actions.size() > 1 and thread_pool::get_instance().get_threads_number() > 1)
+        updates = std::move(calculate_layer(task, strategy, contraction_type, node_deque{n}, frontier.get_heuristic(),
+                                            handler).front());
+
+    for (std::size_t i = 0; i < actions.size(); ++i) {
+        const kripke::action_ptr &a = actions[i];
+        child_update update = i < updates.size() and updates[i].m_is_calculated ? std::move(updates[i]) :
+                              calculate_child(task, strategy, contraction_type, n, a, candidates, frontier.get_heuristic(),
+                                              handler, false);
+
+        if (update.m_is_within_bound) {
+            if (update.m_is_applicable) {
+                const bool is_goal_checked = update.m_is_goal_checked, satisfies_goal = update.m_satisfies_goal;
+                node_ptr n_ = init_node(std::move(update), a, n, ++id, visited_states, handler);
                 is_dead_node = false;
 
                 if (printer) print_applied_action(printer, a, n_, strategy);
@@ -211,10 +311,10 @@ node_deque planner::expand_node(const planning_task &task, const strategy strate
 
                 if (not n_->is_already_visited()) {     // If the update is successful and n_'s state was not
                     n->add_child(n_);                   // previously visited, we add n_ to the children of n
-                    update_visited_states(n_->get_state(), visited_states);
+                    update_visited_states(n_->get_state(), n_->get_bound(), visited_states, handler);
 
                     // If n_'s state satisfies the goal, we return the path from the root of the search tree to n_
-                    if (n_->get_state()->satisfies(task.get_goal(), handler->get_label_storage())) {
+                    if (is_goal_checked ? satisfies_goal : n_->get_state()->satisfies(task.get_goal(), handler->get_label_storage())) {
                         if (printer) print_goal_found(printer, n_);
                         return extract_path(n_, stats);
                     }
@@ -271,10 +371,12 @@ bool planner::validate(const search::planning_task &task, const search::node_deq
             ++count;
             valid = updater::is_applicable(*s, *(*n)->get_action(), handler->get_label_storage());
 
-            if (valid)
-                s = std::make_shared<kripke::state>(
-                        updater::product_update(*s, *(*n)->get_action(), handler->get_label_storage()));
-            else
+            if (valid) {
+                // Product update is a congruence for bisimulation, so we can replay the plan on the contractions of
+                // the intermediate states, which keeps them from growing at each step
+                kripke::state s_ = updater::product_update(*s, *(*n)->get_action(), handler->get_label_storage());
+                s = std::make_shared<kripke::state>(std::get<1>(kripke::partition_refinement::contract(s_)));
+            } else
                 std::cout << "\n\nWARNING! Action '" << count << ". " << (*n)->get_action()->get_name()
                           << "' is not applicable.\n\n";
         } while (valid and count < path.size() - 1);
@@ -289,30 +391,42 @@ bool planner::validate(const search::planning_task &task, const search::node_deq
     return valid;
 }
 
-node_ptr planner::update_node(const strategy strategy, contraction_type contraction_type, const node_ptr &n,
-                              const kripke::action_ptr &a,
-                              unsigned long long &id, const visited_states &visited_states,
-                              del::storages_handler_ptr handler, unsigned long goal_depth) {
+planner::child_update
+planner::calculate_child(const planning_task &task, const strategy strategy, contraction_type contraction_type,
+                         const node_ptr &n, const kripke::action_ptr &a, const boost::dynamic_bitset<> &candidates,
+                         const heuristic_ptr &heuristic, del::storages_handler_ptr handler, const bool check_goal) {
+    child_update update;
+    update.m_is_calculated = true;
+    update.m_is_within_bound = strategy == strategy::unbounded_search or
+                               n->get_bound() >= a->get_maximum_depth() + task.get_goal()->get_modal_depth();
+    update.m_is_applicable = update.m_is_within_bound and task.get_action_index().is_candidate(candidates, *a) and
+                             kripke::updater::is_applicable(*n->get_state(), *a, handler->get_label_storage());
+
+    if (not update.m_is_applicable)
+        return update;
+
+    // Both the state of n and a are contracted, so the worlds of s_ are already the pairs (class of w, class of e)
     kripke::state_ptr s_ = std::make_shared<kripke::state>(
             kripke::updater::product_update(*n->get_state(), *a, handler->get_label_storage()));
 
     if (strategy == strategy::unbounded_search)
-        return init_node(contraction_type, s_, a, true, n, ++id, visited_states, handler);
+        contract(contraction_type, s_, true, 0, false, update, handler);
     else if (strategy == strategy::approx_iterative_bounded_search)
-        return init_node(contraction_type, s_, a, false, n, ++id, visited_states, handler,
-                         n->get_bound() - a->get_maximum_depth());
+        contract(contraction_type, s_, false, n->get_bound() - a->get_maximum_depth(), false, update, handler);
     else {
-        assert(n->is_bisim() or n->get_bound() >= a->get_maximum_depth() + goal_depth);
-        return n->is_bisim() ?
-               init_node(contraction_type, s_, a, true, n, ++id, visited_states, handler, n->get_bound()) :
-               init_node(contraction_type, s_, a, false, n, ++id, visited_states, handler,
-                         n->get_bound() - a->get_maximum_depth());
+        assert(n->is_bisim() or n->get_bound() >= a->get_maximum_depth() + task.get_goal()->get_modal_depth());
+        contract(contraction_type, s_, n->is_bisim(), n->is_bisim() ? n->get_bound() : n->get_bound() - a->get_maximum_depth(),
+                 true, update, handler);
+    }
+
+    if (check_goal) {
+        update.m_is_goal_checked = true;
+        update.m_satisfies_goal = update.m_state->satisfies(task.get_goal(), handler->get_label_storage());
     }
-//        if (n->is_bisim() or n->get_bound() >= a->get_maximum_depth() + goal_depth) {
-//            kripke::state_ptr s_ = std::make_shared<kripke::state>(kripke::updater::product_update(*n->get_state(), *a, handler->get_label_storage()));
-    // if (n->get_bound() >= a->get_maximum_depth() + goal_depth)
-//        }
-//        return nullptr;
+
+    if (heuristic)
+        update.m_heuristic_value = heuristic->evaluate(*update.m_state, handler->get_label_storage());
+    return update;
 }
 
 void planner::refresh_node(node_ptr &n, contraction_type contraction_type, statistics &stats,
@@ -323,40 +437,91 @@ void planner::refresh_node(node_ptr &n, contraction_type contraction_type, stati
     if (not n->is_bisim()) {                                        // If we can still do some refinement steps
         stats.m_visited_worlds_no -= n->get_state()->get_worlds_number();
 
-//        auto [is_bisim, s_contr, structures] = kripke::bisimulator::resume_contraction(contraction_type, *n->get_original_state(), n->get_bound(), n->get_bpr_structures(), handler);    // We do another refinement step
-        auto [is_bisim, s_contr] = kripke::bisimulator::contract(contraction_type, *n->get_original_state(), n->get_bound(), handler);    // We do another refinement step
+        // If n kept its refinement structures, we only do another refinement step. Otherwise, we start from scratch
+        auto [is_bisim, s_contr] = n->has_bpr_structures() ?
+            kripke::bisimulator::resume_contraction(contraction_type, *n->get_original_state(), n->get_bound(), n->get_bpr_structures(), handler) :
+            kripke::bisimulator::contract(contraction_type, *n->get_original_state(), n->get_bound(), handler);
 
         n->set_is_bisim(is_bisim);                                  // And we update the value of is_bisim
         n->set_state(std::make_shared<kripke::state>(std::move(s_contr)));
-        update_visited_states(n->get_state(), visited_states);
+        update_visited_states(n->get_state(), n->get_bound(), visited_states, handler);
         update_statistics(stats, n);
 
-        if (is_bisim) n->clear_original_state();
-//            n->clear_bpr_structures();
+        if (is_bisim) {
+            n->clear_original_state();
+            n->clear_bpr_structures();
+        } else if (n->has_bpr_structures()) {                       // The structures grew by one level, so we account
+            kripke::bpr_structures structures = std::move(n->get_bpr_structures());    // for them again
+            n->clear_bpr_structures();
+            retain_bpr_structures(n, std::move(structures));
+        }
     }
 }
 
 node_ptr planner::init_node(contraction_type contraction_type, const state_ptr &s, const action_ptr &a, bool was_bisim,
                             const node_ptr &parent, unsigned long long id, const visited_states &visited_states,
-                            del::storages_handler_ptr handler, unsigned long b) {
-    auto [is_bisim, s_contr] = kripke::bisimulator::contract(contraction_type, *s, b, handler);
-    bool already_visited = is_already_visited(s_contr, b, visited_states, handler);
+                            del::storages_handler_ptr handler, unsigned long b, bool resumable) {
+    child_update update;
+    contract(contraction_type, s, was_bisim, b, resumable, update, handler);
 
-    node_ptr n = std::make_shared<node>(id, std::make_shared<kripke::state>(std::move(s_contr)), a, b,
-                                        is_bisim and was_bisim, already_visited, parent);
+    return init_node(std::move(update), a, parent, id, visited_states, handler);
+}
+
+node_ptr planner::init_node(child_update &&update, const action_ptr &a, const node_ptr &parent, unsigned long long id,
+                            const visited_states &visited_states, del::storages_handler_ptr handler) {
+    bool already_visited = is_already_visited(*update.m_state, update.m_bound, visited_states, handler);
+
+    node_ptr n = std::make_shared<node>(id, update.m_state, a, update.m_bound, update.m_is_bisim, already_visited, parent);
+    n->set_heuristic_value(update.m_heuristic_value);
 
-    if (not n->is_bisim()) n->set_original_state(s);
-//        n->set_bpr_structures(std::move(structures));
+    if (not n->is_bisim()) {
+        n->set_original_state(update.m_original_state);
+        if (update.m_is_resumable) retain_bpr_structures(n, std::move(update.m_structures));
+    }
 
     return n;
 }
 
-void planner::update_visited_states(const kripke::state_ptr &s, visited_states &visited_states) {
+void planner::contract(contraction_type contraction_type, const state_ptr &s, bool was_bisim, unsigned long b,
+                       bool resumable, child_update &update, del::storages_handler_ptr handler) {
+    resumable = resumable and contraction_type != contraction_type::full;
+
+    auto [is_bisim, s_contr, structures] = resumable ?
+        kripke::bisimulator::resumable_contract(contraction_type, *s, b, handler) :
+        std::tuple_cat(kripke::bisimulator::contract(contraction_type, *s, b, handler), std::make_tuple(kripke::bpr_structures{}));
+
+    update.m_is_bisim = is_bisim and was_bisim;
+    update.m_is_resumable = resumable;
+    update.m_bound = b;
+    update.m_original_state = s;
+    update.m_state = std::make_shared<kripke::state>(std::move(s_contr));
+    update.m_structures = std::move(structures);
+}
+
+void planner::retain_bpr_structures(node_ptr &n, kripke::bpr_structures structures) {
+    // If the structures do not fit into the memory budget, n will be contracted from scratch in the next iteration
+    const unsigned long long memory = kripke::bounded_partition_refinement::get_memory_usage(structures);
+
+    if (node::get_bpr_structures_memory() + memory <= max_bpr_structures_memory)
+        n->set_bpr_structures(std::move(structures), memory);
+}
+
+void planner::init_visited_states(const planning_task &task, contraction_type contraction_type,
+                                  visited_states &visited_states) {
+    if (not task.get_symmetry_analysis().is_trivial())
+        visited_states = symmetric_states_set{task.get_symmetry_analysis(), contraction_type};
+    else if (contraction_type != kripke::contraction_type::rooted) visited_states = states_ids_set();
+    else visited_states = rooted_states_set();
+}
+
+void planner::update_visited_states(const kripke::state_ptr &s, unsigned long b, visited_states &visited_states,
+                                    del::storages_handler_ptr handler) {
     std::visit([&](auto &&arg) {
         using arg_type = std::remove_reference_t<decltype(arg)>;
 
         if constexpr (std::is_same_v<arg_type, states_ids_set>) arg.emplace(s->get_id());
-        else if constexpr (std::is_same_v<arg_type, kripke::state_set>) arg.emplace(s);
+        else if constexpr (std::is_same_v<arg_type, rooted_states_set>) arg.emplace(s);
+        else if constexpr (std::is_same_v<arg_type, symmetric_states_set>) arg.emplace(s, b, handler);
     }, visited_states);
 }
 
@@ -366,11 +531,10 @@ bool planner::is_already_visited(const kripke::state &s, unsigned long b, const
 
         if constexpr (std::is_same_v<arg_type, const states_ids_set>)
             return arg.find(s.get_id()) != arg.end();
-        else if constexpr (std::is_same_v<arg_type, const kripke::state_set>)
-            return std::any_of(arg.begin(), arg.end(),
-                       [&](const state_ptr &t) {
-                           return bisimulator::are_bisimilar(s, *t, b, handler);
-                       });
+        else if constexpr (std::is_same_v<arg_type, const rooted_states_set>)
+            return arg.contains(s, b, handler);
+        else if constexpr (std::is_same_v<arg_type, const symmetric_states_set>)
+            return arg.contains(s, b, handler);
         else return false;
     }, visited_states);
 }
@@ -378,7 +542,7 @@ bool planner::is_already_visited(const kripke::state &s, unsigned long b, const
 
 // Print utilities
 void planner::print_info(const search::planning_task &task, search::strategy strategy,
-                         kripke::contraction_type contraction_type) {
+                         kripke::contraction_type contraction_type, search_order order, heuristic_type heuristic_type) {
 //    std::string strategy_str =
 //            strategy == strategy::unbounded_search ? "BFS" :
 //            (strategy == strategy::iterative_bounded_search ? "IBDS" : "Approx-IBDS");
@@ -389,6 +553,23 @@ void planner::print_info(const search::planning_task &task, search::strategy str
 
     std::cout << "DAEDALUS" << std::endl;
 
+    if (const relevance_analysis &relevance = task.get_relevance_analysis(); not relevance.is_trivial())
+        std::cout << "Relevant atoms: " << relevance.get_relevant_atoms().count() << "/" << relevance.get_relevant_atoms().size()
+                  << "   Relevant agents: " << relevance.get_relevant_agents().count() << "/"
+                  << relevance.get_relevant_agents().size() << std::endl;
+
+    if (const symmetry_analysis &symmetries = task.get_symmetry_analysis(); not symmetries.is_trivial())
+        std::cout << "Symmetries: " << symmetries.get_symmetries().size() << std::endl;
+
+    if (task.get_events_number() < task.get_original_events_number())
+        std::cout << "Minimized event models: " << task.get_original_events_number() << " -> "
+                  << task.get_events_number() << " events" << std::endl;
+
+    if (order != search_order::breadth_first)
+        std::cout << "Search order: " << (order == search_order::greedy_best_first ? "greedy best-first" : "A* (not optimal)")
+                  << "   Heuristic: " << (heuristic_type == heuristic_type::goal_count ? "goal count" : "relaxed plan")
+                  << std::endl;
+
 //    std::cout << "Domain: " << task.get_domain_name()
 //              << "   Problem: " << task.get_problem_id()
 //              << "   Goal: " << printer::formula_printer::to_string(*task.get_goal(), task.get_language(), false)
@@ -413,6 +594,13 @@ void planner::print_statistics(search::statistics &stats, search::strategy strat
     std::cout << "Visited states:         " << stats.m_visited_states_no       << std::endl;
     std::cout << "Total number of worlds: " << stats.m_visited_worlds_no       << std::endl;
     std::cout << "Non revisited states:   " << stats.m_non_revisited_states_no << std::endl;
+    std::cout << "Expanded nodes:         " << stats.m_expanded_nodes_no       << std::endl;
+    if (strategy == strategy::iterative_bounded_search)
+        std::cout << "Refinement memory:      " << stats.m_max_bpr_structures_memory / 1024 << " KB (peak)" << std::endl;
+    if (stats.m_paige_tarjan_contractions_no + stats.m_bounded_contractions_no + stats.m_partition_intersection_contractions_no > 0)
+        std::cout << "Full contractions:      " << stats.m_paige_tarjan_contractions_no << " (Paige-Tarjan), "
+                  << stats.m_bounded_contractions_no << " (bounded refinement), "
+                  << stats.m_partition_intersection_contractions_no << " (partition intersection)" << std::endl;
 //    std::cout << "Depth of search graph:  " << stats.m_graph_depth             << std::endl;
     std::cout << "--------------------------------------------------";
 }
@@ -22,19 +22,26 @@
 // SOFTWARE.
 
 #include "../../include/search/planning_task.h"
+#include "../../include/del/semantics/kripke/actions/action_composer.h"
+#include "../../include/del/semantics/kripke/bisimulation/bisimulator.h"
 #include <memory>
 #include <utility>
 
 using namespace search;
 
 planning_task::planning_task(std::string domain_name, std::string problem_id, del::language_ptr language,
-                             kripke::state initial_state, kripke::action_deque actions, del::formula_ptr goal) :
+                             kripke::state initial_state, kripke::action_deque actions, del::formula_ptr goal,
+                             del::label_storage &l_storage) :
          m_domain_name{std::move(domain_name)},
          m_problem_id{std::move(problem_id)},
          m_language{std::move(language)},
          m_initial_state{std::make_shared<kripke::state>(std::move(initial_state))},
          m_actions{std::move(actions)},
          m_goal{std::move(goal)} {
+    init_relevant_task(l_storage);
+    init_minimal_actions();
+    init_symmetry_analysis(l_storage);
+    init_action_index();
     init_actions_map();
     init_maximum_depth();
 }
@@ -47,6 +54,44 @@ void planning_task::init_maximum_depth() {
             m_maximum_depth = a->get_maximum_depth();
 }
 
+void planning_task::init_relevant_task(del::label_storage &l_storage) {
+    // Atoms and agents that can not affect the goal nor the applicability of actions are dropped before the search, so
+    // that all contractions of the search states are coarser. Plans of the projected task are plans of the original one
+    m_relevance_analysis = relevance_analysis{m_language, m_actions, m_goal};
+
+    if (m_relevance_analysis.is_trivial())
+        return;
+
+    m_initial_state = std::make_shared<kripke::state>(m_relevance_analysis.project(*m_initial_state, l_storage));
+
+    for (kripke::action_ptr &a : m_actions)
+        a = std::make_shared<kripke::action>(m_relevance_analysis.project(*a));
+}
+
+void planning_task::init_minimal_actions() {
+    m_original_events_number = 0;
+    m_events_number = 0;
+
+    // Contracting event models does not change the result of product updates (up to bisimulation), but it reduces the
+    // size of the updated states
+    for (kripke::action_ptr &a : m_actions) {
+        m_original_events_number += a->get_events_number();
+        a = std::make_shared<kripke::action>(kripke::bisimulator::contract(*a));
+        m_events_number += a->get_events_number();
+    }
+}
+
+void planning_task::init_symmetry_analysis(del::label_storage &l_storage) {
+    // Symmetries are looked for in the projected task, with minimal actions, so that bisimilar actions are isomorphic
+    m_symmetry_analysis = symmetry_analysis{m_language, *m_initial_state, m_actions, m_goal,
+                                            m_relevance_analysis.get_relevant_atoms(),
+                                            m_relevance_analysis.get_relevant_agents(), l_storage};
+}
+
+void planning_task::init_action_index() {
+    m_action_index = action_index{m_actions, m_language->get_atoms_number()};
+}
+
 void planning_task::init_actions_map() {
     for (const kripke::action_ptr &a : m_actions)
         m_actions_map[a->get_name()] = a;
@@ -65,6 +110,16 @@ kripke::action_deque planning_task::get_actions(const std::vector<std::string> &
     return as;
 }
 
+const kripke::action_ptr &planning_task::get_macro_action(const std::vector<std::string> &names) const {
+    auto it = m_macro_actions_map.find(names);
+
+    if (it == m_macro_actions_map.end())
+        it = m_macro_actions_map.emplace(names, std::make_shared<kripke::action>(
+                kripke::action_composer::compose(get_actions(names)))).first;
+
+    return it->second;
+}
+
 std::string planning_task::get_domain_name() const {
     return m_domain_name;
 }
@@ -77,10 +132,30 @@ unsigned long planning_task::get_maximum_depth() const {
     return m_maximum_depth;
 }
 
+unsigned long long planning_task::get_original_events_number() const {
+    return m_original_events_number;
+}
+
+unsigned long long planning_task::get_events_number() const {
+    return m_events_number;
+}
+
 del::language_ptr planning_task::get_language() const {
     return m_language;
 }
 
+const action_index &planning_task::get_action_index() const {
+    return m_action_index;
+}
+
+const relevance_analysis &planning_task::get_relevance_analysis() const {
+    return m_relevance_analysis;
+}
+
+const symmetry_analysis &planning_task::get_symmetry_analysis() const {
+    return m_symmetry_analysis;
+}
+
 kripke::state_ptr planning_task::get_initial_state() const {
     return m_initial_state;
 }
@@ -0,0 +1,172 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <unordered_map>
+#include "../../include/search/relevance_analysis.h"
+#include "../../include/del/formulas/all_formulas.h"
+#include "../../include/utils/storage.h"
+
+using namespace search;
+
+relevance_analysis::relevance_analysis(const del::language_ptr &language, const kripke::action_deque &actions,
+                                       const del::formula_ptr &goal) :
+        m_relevant_atoms{boost::dynamic_bitset<>(language->get_atoms_number())},
+        m_relevant_agents{boost::dynamic_bitset<>(language->get_agents_number())} {
+    std::queue<del::atom> to_visit;
+    add_formula(*goal, to_visit);
+
+    for (const kripke::action_ptr &a : actions)
+        for (kripke::event_id e = 0; e < a->get_events_number(); ++e)
+            add_formula(*a->get_precondition(e), to_visit);
+
+    // The new value of a relevant atom depends on the atoms and agents of the postconditions that assign it
+    while (not to_visit.empty()) {
+        const del::atom p = to_visit.front();
+        to_visit.pop();
+
+        for (const kripke::action_ptr &a : actions)
+            for (kripke::event_id e = 0; e < a->get_events_number(); ++e)
+                if (a->is_ontic(e))
+                    if (const auto it = a->get_postconditions(e).find(p); it != a->get_postconditions(e).end())
+                        add_formula(*it->second, to_visit);
+    }
+}
+
+void relevance_analysis::add_formula(const del::formula &f, std::queue<del::atom> &to_visit) {
+    switch (f.get_type()) {
+        case del::formula_type::true_formula:
+        case del::formula_type::false_formula:
+            break;
+        case del::formula_type::atom_formula: {
+            const del::atom p = dynamic_cast<const del::atom_formula &>(f).get_atom();
+
+            if (not m_relevant_atoms[p]) {
+                m_relevant_atoms.set(p);
+                to_visit.push(p);
+            }
+            break;
+        }
+        case del::formula_type::not_formula:
+            add_formula(*dynamic_cast<const del::not_formula &>(f).get_f(), to_visit);
+            break;
+        case del::formula_type::and_formula:
+            for (const del::formula_ptr &f_ : dynamic_cast<const del::and_formula &>(f).get_fs())
+                add_formula(*f_, to_visit);
+            break;
+        case del::formula_type::or_formula:
+            for (const del::formula_ptr &f_ : dynamic_cast<const del::or_formula &>(f).get_fs())
+                add_formula(*f_, to_visit);
+            break;
+        case del::formula_type::imply_formula: {
+            const auto &f_ = dynamic_cast<const del::imply_formula &>(f);
+            add_formula(*f_.get_f1(), to_visit);
+            add_formula(*f_.get_f2(), to_visit);
+            break;
+        }
+        case del::formula_type::box_formula: {
+            const auto &f_ = dynamic_cast<const del::box_formula &>(f);
+            m_relevant_agents.set(f_.get_ag());
+            add_formula(*f_.get_f(), to_visit);
+            break;
+        }
+        case del::formula_type::diamond_formula: {
+            const auto &f_ = dynamic_cast<const del::diamond_formula &>(f);
+            m_relevant_agents.set(f_.get_ag());
+            add_formula(*f_.get_f(), to_visit);
+            break;
+        }
+    }
+}
+
+const boost::dynamic_bitset<> &relevance_analysis::get_relevant_atoms() const {
+    return m_relevant_atoms;
+}
+
+const boost::dynamic_bitset<> &relevance_analysis::get_relevant_agents() const {
+    return m_relevant_agents;
+}
+
+bool relevance_analysis::is_trivial() const {
+    return m_relevant_atoms.all() and m_relevant_agents.all();
+}
+
+kripke::state relevance_analysis::project(const kripke::state &s, del::label_storage &l_storage) const {
+    const kripke::world_id worlds_number = s.get_worlds_number();
+    const del::agent agents_number = s.get_language()->get_agents_number();
+
+    kripke::relations r = kripke::relations(agents_number);
+    kripke::label_vector v = kripke::label_vector(worlds_number);
+    std::unordered_map<kripke::label_id, kripke::label_id> projected_labels;
+
+    for (del::agent ag = 0; ag < agents_number; ++ag) {
+        r[ag] = kripke::agent_relation(worlds_number);
+
+        for (kripke::world_id w = 0; w < worlds_number; ++w)
+            r[ag][w] = m_relevant_agents[ag] ? s.get_agent_possible_worlds(ag, w).to_bitset(worlds_number) : kripke::world_bitset(worlds_number);
+    }
+
+    for (kripke::world_id w = 0; w < worlds_number; ++w) {
+        const kripke::label_id l = s.get_label_id(w);
+        auto it = projected_labels.find(l);
+
+        if (it == projected_labels.end())
+            it = projected_labels.emplace(l, l_storage.emplace(del::label{l_storage.get(l)->get_bitset() & m_relevant_atoms})).first;
+
+        v[w] = it->second;
+    }
+
+    return kripke::state{s.get_language(), worlds_number, std::move(r), std::move(v), s.get_designated_worlds()};
+}
+
+kripke::action relevance_analysis::project(const kripke::action &a) const {
+    const kripke::event_id events_number = a.get_events_number();
+    const del::agent agents_number = a.get_language()->get_agents_number();
+
+    kripke::action_relations q = kripke::action_relations(agents_number);
+    kripke::preconditions pre = kripke::preconditions(events_number);
+    kripke::postconditions post = kripke::postconditions(events_number);
+    boost::dynamic_bitset<> is_ontic(events_number);
+    kripke::event_set designated_events = a.get_designated_events();
+
+    for (del::agent ag = 0; ag < agents_number; ++ag) {
+        q[ag] = kripke::action_agent_relations(events_number);
+
+        for (kripke::event_id e = 0; e < events_number; ++e)
+            q[ag][e] = m_relevant_agents[ag] ? a.get_agent_possible_events(ag, e) : kripke::event_bitset(events_number);
+    }
+
+    for (kripke::event_id e = 0; e < events_number; ++e) {
+        pre[e] = a.get_precondition(e);
+
+        if (a.is_ontic(e))
+            for (const auto &[p, f] : a.get_postconditions(e))
+                if (m_relevant_atoms[p])
+                    post[e].emplace(p, f);
+
+        is_ontic[e] = not post[e].empty();
+    }
+
+    return kripke::action{a.get_language(), a.get_type(), a.get_name(), events_number, std::move(q), std::move(pre),
+                          std::move(post), std::move(is_ontic), std::move(designated_events)};
+}
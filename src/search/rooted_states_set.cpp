@@ -0,0 +1,52 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <algorithm>
+#include "../../include/search/rooted_states_set.h"
+#include "../../include/del/semantics/kripke/bisimulation/bisimulator.h"
+
+using namespace search;
+
+void rooted_states_set::emplace(const kripke::state_ptr &s) {
+    m_states.emplace_back(s);
+
+    for (auto &[k, k_buckets] : m_buckets)
+        k_buckets[kripke::bisimulator::calculate_fingerprint(*s, k)].emplace_back(s);
+}
+
+bool rooted_states_set::contains(const kripke::state &s, const unsigned long k, const del::storages_handler_ptr &handler) const {
+    auto [it, is_new] = m_buckets.try_emplace(k);
+    buckets &k_buckets = it->second;
+
+    if (is_new)
+        for (const kripke::state_ptr &t : m_states)
+            k_buckets[kripke::bisimulator::calculate_fingerprint(*t, k)].emplace_back(t);
+
+    const auto bucket = k_buckets.find(kripke::bisimulator::calculate_fingerprint(s, k));
+
+    // States with different k-fingerprints are not k-bisimilar, so we only check the states in the same bucket
+    return bucket != k_buckets.end() and
+           std::any_of(bucket->second.begin(), bucket->second.end(),
+                       [&](const kripke::state_ptr &t) { return kripke::bisimulator::are_bisimilar(s, *t, k, handler); });
+}
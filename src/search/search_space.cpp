@@ -21,6 +21,7 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <algorithm>
 #include <optional>
 #include <utility>
 
@@ -28,6 +29,9 @@
 
 using namespace search;
 
+std::atomic<unsigned long long> node::m_bpr_structures_memory = 0;
+std::atomic<unsigned long long> node::m_max_bpr_structures_memory = 0;
+
 node::node(unsigned long long id, kripke::state_ptr state, kripke::action_ptr action, unsigned long bound, bool is_bisim,
            bool already_visited, node_ptr parent) :
         m_id{id},
@@ -72,6 +76,10 @@ bool node::is_already_visited() const {
     return m_already_visited;
 }
 
+unsigned long node::get_heuristic_value() const {
+    return m_heuristic_value;
+}
+
 node_ptr node::get_parent() const {
     return m_parent;
 }
@@ -84,14 +92,34 @@ const kripke::action_deque &node::get_to_apply_actions() const {
     return m_to_apply_actions;
 }
 
-/*kripke::bpr_structures &node::get_bpr_structures() {
+bool node::has_bpr_structures() const {
+    return m_structures != nullptr;
+}
+
+kripke::bpr_structures &node::get_bpr_structures() {
     return *m_structures;
-}*/
+}
+
+unsigned long long node::get_bpr_structures_memory() {
+    return m_bpr_structures_memory;
+}
+
+unsigned long long node::get_max_bpr_structures_memory() {
+    return m_max_bpr_structures_memory;
+}
+
+void node::reset_max_bpr_structures_memory() {
+    m_max_bpr_structures_memory = m_bpr_structures_memory.load();
+}
 
 void node::set_state(kripke::state_ptr s) {
     m_state = std::move(s);
 }
 
+void node::set_heuristic_value(const unsigned long h) {
+    m_heuristic_value = h;
+}
+
 void node::increment_bound() {
     ++m_bound;
 }
@@ -123,10 +151,20 @@ void node::clear_original_state() {
     m_original_state = nullptr;
 }
 
-/*void node::set_bpr_structures(kripke::bpr_structures structures) {
-    m_structures = std::make_shared<kripke::bpr_structures>(std::move(structures));
+void node::set_bpr_structures(kripke::bpr_structures structures, const unsigned long long memory) {
+    // The memory of the structures is accounted for as long as they are alive
+    const unsigned long long current = m_bpr_structures_memory += memory;
+
+    for (unsigned long long max = m_max_bpr_structures_memory;
+         max < current and not m_max_bpr_structures_memory.compare_exchange_weak(max, current); ) {}
+
+    m_structures = kripke::bpr_structures_ptr(new kripke::bpr_structures{std::move(structures)},
+                                              [memory](kripke::bpr_structures *structures) {
+                                                  m_bpr_structures_memory -= memory;
+                                                  delete structures;
+                                              });
 }
 
 void node::clear_bpr_structures() {
     m_structures = nullptr;
-}*/
+}
@@ -0,0 +1,160 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "../../../include/search/symbolic/symbolic_planner.h"
+
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <utility>
+#include "../../../include/del/semantics/symbolic/symbolic_utils.h"
+#include "../../../include/del/semantics/symbolic/update/updater.h"
+#include "../../../include/utils/time_utils.h"
+
+using namespace search;
+
+std::pair<symbolic_node_deque, statistics>
+symbolic_planner::search(const planning_task &task, [[maybe_unused]] const strategy strategy, del::storages_handler_ptr handler) {
+    std::cout << "DAEDALUS" << std::endl;
+    std::cout << "Semantics: symbolic" << std::endl;
+    std::cout << "Solving..." << std::endl;
+
+    assert(strategy == strategy::unbounded_search);     // Bounded strategies are rejected when parsing the options
+    statistics stats{};
+
+    const bdd_manager_ptr manager = std::make_shared<bdd_manager>();
+    auto start = std::chrono::high_resolution_clock::now();
+
+    symbolic::state_ptr s0 = std::make_shared<symbolic::state>(symbolic::symbolic_utils::reduce(
+            symbolic::symbolic_utils::convert(*task.get_initial_state(), handler->get_label_storage(), manager)));
+    symbolic_node_deque path;
+
+    // If the initial state satisfies the goal, we immediately terminate
+    if (s0->satisfies(task.get_goal())) {
+        symbolic_node_ptr n0 = std::make_shared<symbolic_node>(0, s0, nullptr);
+        update_statistics(stats, n0);
+        path = extract_path(n0);
+    } else
+        path = bfs(task, s0, stats);
+
+    stats.m_plan_length = path.size() - 1;
+    stats.m_computation_time = static_cast<double>(since(start).count()) / 1000;
+
+    print_statistics(stats, manager->get_nodes_number());
+    return {std::move(path), stats};
+}
+
+symbolic_node_deque symbolic_planner::bfs(const planning_task &task, const symbolic::state_ptr &s0, statistics &stats) {
+    symbolic_node_deque frontier;
+    encodings_set visited_states;
+    unsigned long long id = 0;
+
+    frontier.push_back(std::make_shared<symbolic_node>(id, s0, nullptr));
+    update_visited_states(*s0, visited_states);
+    update_statistics(stats, frontier.back());
+
+    while (not frontier.empty()) {
+        symbolic_node_ptr n = std::move(frontier.front());
+        frontier.pop_front();
+
+        for (const kripke::action_ptr &a : task.get_actions()) {
+            if (not symbolic::updater::is_applicable(*n->get_state(), *a))
+                continue;
+
+            symbolic::state_ptr s_ = std::make_shared<symbolic::state>(
+                    symbolic::symbolic_utils::reduce(symbolic::updater::product_update(*n->get_state(), *a)));
+
+            if (not update_visited_states(*s_, visited_states)) {
+                ++stats.m_non_revisited_states_no;
+                continue;
+            }
+
+            symbolic_node_ptr n_ = std::make_shared<symbolic_node>(++id, std::move(s_), a, n);
+            update_statistics(stats, n_);
+
+            if (n_->get_state()->satisfies(task.get_goal()))
+                return extract_path(n_);
+
+            frontier.push_back(std::move(n_));
+        }
+    }
+
+    return extract_path(nullptr);
+}
+
+bool symbolic_planner::update_visited_states(const symbolic::state &s, encodings_set &visited_states) {
+    // The nodes of a manager are unique, so states with the same BDDs (over the same vocabulary) are the same state.
+    // Reduced states that only use the atoms are the same iff they are bisimilar
+    std::vector<symbolic::bdd> encoding = {s.get_variables_number(), s.get_worlds(), s.get_designated_worlds()};
+
+    for (del::agent ag = 0; ag < s.get_language()->get_agents_number(); ++ag)
+        encoding.push_back(s.get_agent_relation(ag));
+
+    return visited_states.emplace(std::move(encoding)).second;
+}
+
+void symbolic_planner::update_statistics(statistics &stats, const symbolic_node_ptr &n) {
+    ++stats.m_visited_states_no;
+    stats.m_visited_worlds_no += static_cast<unsigned long long>(n->get_state()->get_worlds_number());
+}
+
+symbolic_node_deque symbolic_planner::extract_path(symbolic_node_ptr n) {
+    symbolic_node_deque path;
+
+    while (n) {
+        path.push_front(n);
+        n = n->get_parent();
+    }
+    print_plan(path);
+    return path;
+}
+
+void symbolic_planner::print_plan(const symbolic_node_deque &path) {
+    if (path.empty())
+        std::cout << std::endl << std::endl << "No plan was found" << std::endl;
+    else if (path.size() == 1)
+        std::cout << "Goal found in initial state!" << std::endl;
+    else {
+        std::cout << "- Found plan of length " << (path.size() - 1) << "!" << std::endl << std::endl;
+        unsigned long count = 0;
+
+        for (const auto &node : path)
+            if (node->get_action())
+                std::cout << ++count << ". " << node->get_action()->get_name() << "  ";
+        std::cout << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+void symbolic_planner::print_statistics(const statistics &stats, const unsigned long bdd_nodes_number) {
+    std::cout << "--------------------------------------------------"          << std::endl;
+    std::cout << "Computation time:       " << stats.m_computation_time        << "s." << std::endl;
+    std::cout << "Bound:                  " << "\u221E"                    << std::endl;
+    std::cout << "Visited states:         " << stats.m_visited_states_no       << std::endl;
+    std::cout << "Total number of worlds: " << stats.m_visited_worlds_no       << std::endl;
+    std::cout << "Non revisited states:   " << stats.m_non_revisited_states_no << std::endl;
+    std::cout << "BDD nodes:              " << bdd_nodes_number                << std::endl;
+    std::cout << "--------------------------------------------------";
+}
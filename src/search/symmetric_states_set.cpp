@@ -0,0 +1,178 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "../../include/search/symmetric_states_set.h"
+#include "../../include/del/semantics/kripke/bisimulation/bounded_identification.h"
+#include "../../include/utils/storage.h"
+#include <algorithm>
+#include <boost/functional/hash.hpp>
+
+using namespace search;
+
+symmetric_states_set::symmetric_states_set(const symmetry_analysis &symmetries, const kripke::contraction_type type) :
+        m_symmetries{&symmetries},
+        m_type{type},
+        m_permuted_labels(symmetries.get_generators().size()) {
+    const std::vector<unsigned long> &agents_orbits = m_symmetries->get_agents_orbits();
+    m_agents_orbits_number = agents_orbits.empty() ? 0 : *std::max_element(agents_orbits.begin(), agents_orbits.end()) + 1;
+}
+
+void symmetric_states_set::emplace(const kripke::state_ptr &s, const unsigned long k, const del::storages_handler_ptr &handler) {
+    if (m_type == kripke::contraction_type::rooted)
+        m_rooted_states.emplace(s);
+    else
+        m_states_ids.emplace(calculate_state_id(*s, k, handler));
+
+    m_buckets[calculate_symmetric_fingerprint(*s, k, handler->get_label_storage())].push_back({s, k, false});
+}
+
+bool symmetric_states_set::contains(const kripke::state &s, const unsigned long k, const del::storages_handler_ptr &handler) const {
+    if (contains_exactly(s, k, handler))
+        return true;
+
+    const auto bucket = m_buckets.find(calculate_symmetric_fingerprint(s, k, handler->get_label_storage()));
+
+    if (bucket == m_buckets.end())
+        return false;
+
+    bool is_expanded = false;
+
+    // Only the stored states with the same fingerprint of s can have an image equivalent to s
+    for (stored_state &t : bucket->second)
+        if (not t.m_is_expanded) {
+            expand(t, handler);
+            t.m_is_expanded = true;
+            is_expanded = true;
+        }
+
+    return is_expanded and contains_exactly(s, k, handler);
+}
+
+void symmetric_states_set::expand(const stored_state &t, const del::storages_handler_ptr &handler) const {
+    std::vector<kripke::state_ptr> to_permute = {t.m_state};
+
+    while (not to_permute.empty()) {
+        const kripke::state_ptr u = std::move(to_permute.back());
+        to_permute.pop_back();
+
+        for (std::size_t i = 0; i < m_symmetries->get_generators().size(); ++i) {
+            const kripke::state_ptr v = std::make_shared<kripke::state>(symmetry_analysis::permute(
+                    *u, m_symmetries->get_generators()[i], handler->get_label_storage(), m_permuted_labels[i]));
+
+            if (m_type == kripke::contraction_type::rooted) {
+                if (m_rooted_states.contains(*v, t.m_k, handler))
+                    continue;
+
+                m_rooted_states.emplace(v);
+            } else if (not m_states_ids.emplace(calculate_state_id(*v, t.m_k, handler)).second)
+                continue;
+
+            to_permute.push_back(v);
+        }
+    }
+}
+
+bool symmetric_states_set::contains_exactly(const kripke::state &s, const unsigned long k,
+                                            const del::storages_handler_ptr &handler) const {
+    return m_type == kripke::contraction_type::rooted ?
+           m_rooted_states.contains(s, k, handler) :
+           m_states_ids.find(calculate_state_id(s, k, handler)) != m_states_ids.end();
+}
+
+kripke::state_id symmetric_states_set::calculate_state_id(const kripke::state &s, const unsigned long k,
+                                                          del::storages_handler_ptr handler) const {
+    // Full contractions are identified when they are built, but their images are not. Permutations preserve
+    // minimality, so the images are identified among the full contractions
+    if (m_type == kripke::contraction_type::full)
+        return s.get_id() != 0 ? s.get_id() : handler->get_contractions_storage().emplace(s);
+
+    return kripke::bounded_identification::calculate_state_id(s, k, handler);
+}
+
+std::size_t symmetric_states_set::calculate_symmetric_fingerprint(const kripke::state &s, const unsigned long k,
+                                                                  del::label_storage &l_storage) const {
+    // States that are equivalent wrt. the bound of their identification are fingerprint_bound-bisimilar (or k-bisimilar,
+    // if k is smaller), so they have the same fingerprint
+    const unsigned long bound = m_type == kripke::contraction_type::full ?
+                                std::min(fingerprint_bound, s.get_max_depth() + 1) : std::min(fingerprint_bound, k);
+    const std::vector<unsigned long> &agents_orbits = m_symmetries->get_agents_orbits();
+    const std::vector<unsigned long> &atoms_orbits = m_symmetries->get_atoms_orbits();
+
+    std::vector<std::size_t> signatures = std::vector<std::size_t>(s.get_worlds_number());
+    std::vector<std::size_t> next_signatures = std::vector<std::size_t>(s.get_worlds_number()), successors;
+    std::vector<std::vector<std::size_t>> orbits_successors = std::vector<std::vector<std::size_t>>(m_agents_orbits_number);
+    std::unordered_map<kripke::label_id, std::size_t> labels_signatures;
+
+    for (kripke::world_id w = 0; w < s.get_worlds_number(); ++w) {
+        auto it = labels_signatures.find(s.get_label_id(w));
+
+        if (it == labels_signatures.end()) {
+            const boost::dynamic_bitset<> &bitset = l_storage.get(s.get_label_id(w))->get_bitset();
+            std::vector<unsigned long> counts = std::vector<unsigned long>(atoms_orbits.size());
+
+            for (del::atom p = 0; p < bitset.size(); ++p)
+                if (bitset[p])
+                    ++counts[atoms_orbits[p]];
+
+            it = labels_signatures.emplace(s.get_label_id(w), boost::hash_range(counts.begin(), counts.end())).first;
+        }
+        signatures[w] = it->second;
+    }
+
+    for (unsigned long h = 0; h < bound; ++h) {
+        for (kripke::world_id w = 0; w < s.get_worlds_number(); ++w) {
+            std::size_t signature = signatures[w];
+
+            for (auto &orbit_successors : orbits_successors)
+                orbit_successors.clear();
+
+            for (del::agent ag = 0; ag < s.get_language()->get_agents_number(); ++ag) {
+                successors.clear();
+
+                for (const kripke::world_id v : s.get_agent_possible_worlds(ag, w))
+                    successors.push_back(signatures[v]);
+
+                std::sort(successors.begin(), successors.end());
+                successors.erase(std::unique(successors.begin(), successors.end()), successors.end());
+                orbits_successors[agents_orbits[ag]].push_back(boost::hash_range(successors.begin(), successors.end()));
+            }
+
+            for (auto &orbit_successors : orbits_successors) {
+                std::sort(orbit_successors.begin(), orbit_successors.end());
+                boost::hash_combine(signature, boost::hash_range(orbit_successors.begin(), orbit_successors.end()));
+            }
+            next_signatures[w] = signature;
+        }
+        std::swap(signatures, next_signatures);
+    }
+
+    successors.clear();
+
+    for (const kripke::world_id wd : s.get_designated_worlds())
+        successors.push_back(signatures[wd]);
+
+    std::sort(successors.begin(), successors.end());
+    successors.erase(std::unique(successors.begin(), successors.end()), successors.end());
+    return boost::hash_range(successors.begin(), successors.end());
+}
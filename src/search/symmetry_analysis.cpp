@@ -0,0 +1,516 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <algorithm>
+#include <set>
+#include <unordered_map>
+#include "../../include/search/symmetry_analysis.h"
+#include "../../include/del/formulas/all_formulas.h"
+#include "../../include/del/semantics/kripke/bisimulation/bisimulator.h"
+#include "../../include/utils/storage.h"
+
+using namespace search;
+
+symmetry_analysis::symmetry_analysis(const del::language_ptr &language, const kripke::state &s0,
+                                     const kripke::action_deque &actions, const del::formula_ptr &goal,
+                                     const boost::dynamic_bitset<> &relevant_atoms,
+                                     const boost::dynamic_bitset<> &relevant_agents, del::label_storage &l_storage) {
+    const del::agent agents_number = language->get_agents_number();
+    const del::atom atoms_number = language->get_atoms_number();
+    symmetry identity{std::vector<del::agent>(agents_number), std::vector<del::atom>(atoms_number)};
+
+    for (del::agent ag = 0; ag < agents_number; ++ag)
+        identity.m_agents[ag] = ag;
+
+    for (del::atom p = 0; p < atoms_number; ++p)
+        identity.m_atoms[p] = p;
+
+    m_symmetries.push_back(identity);
+
+    // Actions are compared by the bisimilarity of their event models, so we group them by their (multisets of) labels:
+    // bisimilar minimal event models are isomorphic, so they have the same labels
+    const std::string goal_string = to_canonical_string(*goal, identity);
+    std::map<std::string, kripke::label_id> labels_ids;
+    std::vector<kripke::state> events_states;
+    std::map<kripke::label_vector, std::vector<std::size_t>> actions_by_labels;
+
+    auto get_labels = [](const kripke::state &s) {
+        kripke::label_vector labels(s.get_worlds_number());
+
+        for (kripke::world_id w = 0; w < s.get_worlds_number(); ++w)
+            labels[w] = s.get_label_id(w);
+
+        std::sort(labels.begin(), labels.end());
+        return labels;
+    };
+
+    for (std::size_t i = 0; i < actions.size(); ++i) {
+        events_states.push_back(build_events_state(*actions[i], identity, labels_ids));
+        actions_by_labels[get_labels(events_states.back())].push_back(i);
+    }
+
+    // We check the cheapest conditions first
+    auto verify = [&](const symmetry &sym) {
+        if (to_canonical_string(*goal, sym) != goal_string)
+            return false;
+
+        for (const kripke::action_ptr &a : actions) {
+            const kripke::state e = build_events_state(*a, sym, labels_ids);
+            const auto it = actions_by_labels.find(get_labels(e));
+
+            if (it == actions_by_labels.end() or
+                std::none_of(it->second.begin(), it->second.end(),
+                             [&](const std::size_t i) { return kripke::bisimulator::are_bisimilar(e, events_states[i]); }))
+                return false;
+        }
+        std::unordered_map<kripke::label_id, kripke::label_id> permuted_labels;
+        return kripke::bisimulator::are_bisimilar(permute(s0, sym, l_storage, permuted_labels), s0);
+    };
+
+    candidates_search search{calculate_incidence(s0, actions, *goal, l_storage), relevant_agents, relevant_atoms,
+                             boost::dynamic_bitset<>(agents_number), boost::dynamic_bitset<>(atoms_number), {}, {},
+                             verify, 0, {{identity.m_agents, identity.m_atoms}}};
+
+    // Irrelevant agents and atoms have their own colors, so that they are never renamed
+    std::map<std::vector<unsigned long>, unsigned long> colors_ids;
+
+    for (del::agent ag = 0; ag < agents_number; ++ag) {
+        std::vector<unsigned long> color = search.m_incidence[ag];
+        std::sort(color.begin(), color.end());
+        color.push_back(relevant_agents[ag] ? agents_number : ag);
+
+        search.m_agents_colors.push_back(colors_ids.emplace(std::move(color), colors_ids.size()).first->second);
+    }
+
+    colors_ids.clear();
+
+    for (del::atom p = 0; p < atoms_number; ++p) {
+        std::vector<unsigned long> color(agents_number);
+
+        for (del::agent ag = 0; ag < agents_number; ++ag)
+            color[ag] = search.m_incidence[ag][p];
+
+        std::sort(color.begin(), color.end());
+        unsigned long worlds_number = 0, designated_number = 0;
+
+        for (kripke::world_id w = 0; w < s0.get_worlds_number(); ++w)
+            if ((*l_storage.get(s0.get_label_id(w)))[p]) {
+                ++worlds_number;
+                designated_number += s0.is_designated(w);
+            }
+
+        color.insert(color.end(), {worlds_number, designated_number, relevant_atoms[p] ? atoms_number : p});
+        search.m_atoms_colors.push_back(colors_ids.emplace(std::move(color), colors_ids.size()).first->second);
+    }
+
+    symmetry sym = identity;
+    enumerate_agents(sym, 0, search);
+
+    calculate_generators(search.m_group.size());
+
+    m_agents_orbits = calculate_orbits(agents_number, [](const symmetry &sym_) -> const auto & { return sym_.m_agents; });
+    m_atoms_orbits  = calculate_orbits(atoms_number,  [](const symmetry &sym_) -> const auto & { return sym_.m_atoms; });
+}
+
+const std::vector<symmetry> &symmetry_analysis::get_symmetries() const {
+    return m_symmetries;
+}
+
+const std::vector<symmetry> &symmetry_analysis::get_generators() const {
+    return m_generators;
+}
+
+bool symmetry_analysis::is_trivial() const {
+    return m_symmetries.size() <= 1;
+}
+
+const std::vector<unsigned long> &symmetry_analysis::get_agents_orbits() const {
+    return m_agents_orbits;
+}
+
+const std::vector<unsigned long> &symmetry_analysis::get_atoms_orbits() const {
+    return m_atoms_orbits;
+}
+
+void symmetry_analysis::calculate_generators(const std::size_t group_size) {
+    // Since the images of a state are found by applying the generators, we replace the generators found during the
+    // enumeration by greedily choosing the symmetry that generates the largest group together with the previous ones
+    std::set<permutations> group = {{m_symmetries.front().m_agents, m_symmetries.front().m_atoms}};
+    std::vector<symmetry> generators;
+
+    while (group.size() < group_size) {
+        const symmetry *best_sym = nullptr;
+        std::set<permutations> best_group;
+
+        for (const symmetry &sym : m_symmetries)
+            if (best_group.size() < group_size and group.find({sym.m_agents, sym.m_atoms}) == group.end()) {
+                generators.push_back(sym);
+                std::set<permutations> sym_group = close(group, generators);
+                generators.pop_back();
+
+                if (sym_group.size() > best_group.size()) {
+                    best_sym = &sym;
+                    best_group = std::move(sym_group);
+                }
+            }
+
+        if (not best_sym)
+            break;
+
+        generators.push_back(*best_sym);
+        group = std::move(best_group);
+    }
+    m_generators = std::move(generators);
+}
+
+std::set<symmetry_analysis::permutations> symmetry_analysis::close(const std::set<permutations> &group,
+                                                                   const std::vector<symmetry> &generators) {
+    // We stop when the group is larger than the bound to the number of symmetries. In that case we might later add some
+    // redundant generators, which is harmless
+    std::set<permutations> closure = group;
+    std::vector<permutations> to_compose = std::vector<permutations>(group.begin(), group.end());
+
+    while (not to_compose.empty() and closure.size() <= max_symmetries_number) {
+        const permutations elem = std::move(to_compose.back());
+        to_compose.pop_back();
+
+        for (const symmetry &gen : generators) {
+            permutations composition = elem;
+
+            for (del::agent &ag : composition.first)
+                ag = gen.m_agents[ag];
+
+            for (del::atom &p : composition.second)
+                p = gen.m_atoms[p];
+
+            if (closure.insert(composition).second)
+                to_compose.push_back(std::move(composition));
+        }
+    }
+    return closure;
+}
+
+std::vector<unsigned long> symmetry_analysis::calculate_orbits(const unsigned long n,
+                                                               const std::function<const std::vector<unsigned long> &(const symmetry &)> &images) const {
+    // Union-find over the pairs (i, image of i)
+    std::vector<unsigned long> parents(n), orbits(n);
+
+    for (unsigned long i = 0; i < n; ++i)
+        parents[i] = i;
+
+    auto find = [&](unsigned long i) {
+        while (parents[i] != i)
+            i = parents[i] = parents[parents[i]];
+        return i;
+    };
+
+    for (const symmetry &sym : m_symmetries)
+        for (unsigned long i = 0; i < n; ++i)
+            parents[find(i)] = find(images(sym)[i]);
+
+    std::map<unsigned long, unsigned long> orbits_ids;
+
+    for (unsigned long i = 0; i < n; ++i)
+        orbits[i] = orbits_ids.emplace(find(i), orbits_ids.size()).first->second;
+
+    return orbits;
+}
+
+kripke::state symmetry_analysis::permute(const kripke::state &s, const symmetry &sym, del::label_storage &l_storage,
+                                         std::unordered_map<kripke::label_id, kripke::label_id> &permuted_labels) {
+    const kripke::world_id worlds_number = s.get_worlds_number();
+    const del::agent agents_number = s.get_language()->get_agents_number();
+
+    kripke::relations_rows rows = kripke::relations_rows(agents_number);
+    kripke::relations_rows_ids rows_ids = kripke::relations_rows_ids(agents_number);
+    kripke::label_vector v = kripke::label_vector(worlds_number);
+
+    // The rows of ag become the rows of its image. The classes of equivalences are passed as they are
+    for (del::agent ag = 0; ag < agents_number; ++ag) {
+        kripke::agent_relation &ag_rows = rows[sym.m_agents[ag]];
+        kripke::agent_rows_ids &ag_rows_ids = rows_ids[sym.m_agents[ag]];
+
+        if (not s.is_equivalence(ag))
+            for (kripke::row_id r = 0; r < s.get_agent_rows_number(ag); ++r)
+                ag_rows.push_back(s.get_agent_row(ag, r).to_bitset(worlds_number));
+
+        ag_rows_ids.resize(worlds_number);
+
+        for (kripke::world_id w = 0; w < worlds_number; ++w)
+            ag_rows_ids[w] = s.get_agent_row_id(ag, w);
+    }
+
+    for (kripke::world_id w = 0; w < worlds_number; ++w) {
+        const kripke::label_id l = s.get_label_id(w);
+        auto it = permuted_labels.find(l);
+
+        if (it == permuted_labels.end()) {
+            const boost::dynamic_bitset<> bitset = l_storage.get(l)->get_bitset();
+            boost::dynamic_bitset<> permuted_bitset(bitset.size());
+
+            for (del::atom p = 0; p < bitset.size(); ++p)
+                permuted_bitset[sym.m_atoms[p]] = bitset[p];
+
+            it = permuted_labels.emplace(l, l_storage.emplace(del::label{std::move(permuted_bitset)})).first;
+        }
+        v[w] = it->second;
+    }
+
+    return kripke::state{s.get_language(), worlds_number, std::move(rows), std::move(rows_ids), std::move(v),
+                         s.get_designated_worlds()};
+}
+
+std::string symmetry_analysis::to_canonical_string(const del::formula &f, const symmetry &sym) {
+    switch (f.get_type()) {
+        case del::formula_type::true_formula:
+            return "T";
+        case del::formula_type::false_formula:
+            return "F";
+        case del::formula_type::atom_formula:
+            return "p" + std::to_string(sym.m_atoms[dynamic_cast<const del::atom_formula &>(f).get_atom()]);
+        case del::formula_type::not_formula:
+            return "~" + to_canonical_string(*dynamic_cast<const del::not_formula &>(f).get_f(), sym);
+        case del::formula_type::and_formula:
+        case del::formula_type::or_formula: {
+            const bool is_and = f.get_type() == del::formula_type::and_formula;
+            const del::formula_deque &fs = is_and ? dynamic_cast<const del::and_formula &>(f).get_fs() :
+                                                    dynamic_cast<const del::or_formula &>(f).get_fs();
+            std::vector<std::string> fs_strings;
+
+            for (const del::formula_ptr &f_ : fs)
+                fs_strings.push_back(to_canonical_string(*f_, sym));
+
+            std::sort(fs_strings.begin(), fs_strings.end());
+            std::string f_string = "(";
+
+            for (std::size_t i = 0; i < fs_strings.size(); ++i)
+                f_string += (i == 0 ? "" : (is_and ? "&" : "|")) + fs_strings[i];
+
+            return f_string + ")";
+        }
+        case del::formula_type::imply_formula: {
+            const auto &f_ = dynamic_cast<const del::imply_formula &>(f);
+            return "(" + to_canonical_string(*f_.get_f1(), sym) + ">" + to_canonical_string(*f_.get_f2(), sym) + ")";
+        }
+        case del::formula_type::box_formula: {
+            const auto &f_ = dynamic_cast<const del::box_formula &>(f);
+            return "[" + std::to_string(sym.m_agents[f_.get_ag()]) + "]" + to_canonical_string(*f_.get_f(), sym);
+        }
+        case del::formula_type::diamond_formula: {
+            const auto &f_ = dynamic_cast<const del::diamond_formula &>(f);
+            return "<" + std::to_string(sym.m_agents[f_.get_ag()]) + ">" + to_canonical_string(*f_.get_f(), sym);
+        }
+    }
+    return "";
+}
+
+kripke::state symmetry_analysis::build_events_state(const kripke::action &a, const symmetry &sym,
+                                                    std::map<std::string, kripke::label_id> &labels_ids) {
+    const kripke::event_id events_number = a.get_events_number();
+    const del::agent agents_number = a.get_language()->get_agents_number();
+    kripke::label_vector ls = kripke::label_vector(events_number);
+
+    for (kripke::event_id e = 0; e < events_number; ++e) {
+        std::string e_label = to_canonical_string(*a.get_precondition(e), sym);
+
+        if (a.is_ontic(e)) {
+            std::map<del::atom, std::string> e_post;
+
+            for (const auto &[p, f_post] : a.get_postconditions(e))
+                e_post.emplace(sym.m_atoms[p], to_canonical_string(*f_post, sym));
+
+            for (const auto &[p, f_post] : e_post)
+                e_label += ";" + std::to_string(p) + ":=" + f_post;
+        }
+
+        ls[e] = labels_ids.emplace(std::move(e_label), labels_ids.size()).first->second;
+    }
+
+    kripke::relations r = kripke::relations(agents_number);
+
+    for (del::agent ag = 0; ag < agents_number; ++ag) {
+        kripke::agent_relation &r_ag = r[sym.m_agents[ag]];
+        r_ag = kripke::agent_relation(events_number);
+
+        for (kripke::event_id e = 0; e < events_number; ++e)
+            r_ag[e] = a.get_agent_possible_events(ag, e);
+    }
+
+    kripke::world_bitset designated = kripke::world_bitset(events_number);
+
+    for (const kripke::event_id ed : a.get_designated_events())
+        designated.push_back(ed);
+
+    return kripke::state{a.get_language(), events_number, std::move(r), std::move(ls), std::move(designated)};
+}
+
+symmetry_analysis::incidence symmetry_analysis::calculate_incidence(const kripke::state &s0, const kripke::action_deque &actions,
+                                                                    const del::formula &goal, const del::label_storage &l_storage) {
+    const del::agent agents_number = s0.get_language()->get_agents_number();
+    const del::atom atoms_number = s0.get_language()->get_atoms_number();
+    incidence inc = incidence(agents_number, std::vector<unsigned long>(atoms_number, 0));
+    std::vector<del::agent> scope;
+
+    add_formula(goal, scope, inc);
+
+    for (const kripke::action_ptr &a : actions)
+        for (kripke::event_id e = 0; e < a->get_events_number(); ++e) {
+            add_formula(*a->get_precondition(e), scope, inc);
+
+            if (a->is_ontic(e))
+                for (const auto &[_, f] : a->get_postconditions(e))
+                    add_formula(*f, scope, inc);
+        }
+
+    // Agent ag observes p if p has the same value in all worlds that ag considers possible. It suffices to check one
+    // world per row, together with the successors in the row
+    for (del::agent ag = 0; ag < agents_number; ++ag) {
+        boost::dynamic_bitset<> observed(atoms_number), checked_rows(s0.get_agent_rows_number(ag));
+        observed.set();
+
+        for (kripke::world_id w = 0; w < s0.get_worlds_number(); ++w) {
+            const kripke::row_id r = s0.get_agent_row_id(ag, w);
+
+            if (checked_rows[r])
+                continue;
+
+            checked_rows.set(r);
+            const auto &row = s0.get_agent_row(ag, r);
+
+            if (row.empty())
+                continue;
+
+            const boost::dynamic_bitset<> first = l_storage.get(s0.get_label_id(*row.begin()))->get_bitset();
+
+            for (const kripke::world_id v : row)
+                observed &= ~(first ^ l_storage.get(s0.get_label_id(v))->get_bitset());
+        }
+
+        for (del::atom p = 0; p < atoms_number; ++p)
+            inc[ag][p] += observed[p];
+    }
+
+    return inc;
+}
+
+void symmetry_analysis::add_formula(const del::formula &f, std::vector<del::agent> &scope, incidence &inc) {
+    switch (f.get_type()) {
+        case del::formula_type::true_formula:
+        case del::formula_type::false_formula:
+            break;
+        case del::formula_type::atom_formula:
+            for (const del::agent ag : scope)
+                inc[ag][dynamic_cast<const del::atom_formula &>(f).get_atom()] += 2;
+            break;
+        case del::formula_type::not_formula:
+            add_formula(*dynamic_cast<const del::not_formula &>(f).get_f(), scope, inc);
+            break;
+        case del::formula_type::and_formula:
+            for (const del::formula_ptr &f_ : dynamic_cast<const del::and_formula &>(f).get_fs())
+                add_formula(*f_, scope, inc);
+            break;
+        case del::formula_type::or_formula:
+            for (const del::formula_ptr &f_ : dynamic_cast<const del::or_formula &>(f).get_fs())
+                add_formula(*f_, scope, inc);
+            break;
+        case del::formula_type::imply_formula: {
+            const auto &f_ = dynamic_cast<const del::imply_formula &>(f);
+            add_formula(*f_.get_f1(), scope, inc);
+            add_formula(*f_.get_f2(), scope, inc);
+            break;
+        }
+        case del::formula_type::box_formula: {
+            const auto &f_ = dynamic_cast<const del::box_formula &>(f);
+            scope.push_back(f_.get_ag());
+            add_formula(*f_.get_f(), scope, inc);
+            scope.pop_back();
+            break;
+        }
+        case del::formula_type::diamond_formula: {
+            const auto &f_ = dynamic_cast<const del::diamond_formula &>(f);
+            scope.push_back(f_.get_ag());
+            add_formula(*f_.get_f(), scope, inc);
+            scope.pop_back();
+            break;
+        }
+    }
+}
+
+void symmetry_analysis::enumerate_agents(symmetry &sym, const del::agent ag, candidates_search &search) {
+    if (m_symmetries.size() >= max_symmetries_number or search.m_candidates_number >= max_candidates_number)
+        return;
+
+    if (ag == sym.m_agents.size()) {
+        enumerate_atoms(sym, 0, search);
+        return;
+    }
+
+    for (del::agent ag_ = 0; ag_ < sym.m_agents.size(); ++ag_)
+        if (not search.m_used_agents[ag_] and search.m_agents_colors[ag_] == search.m_agents_colors[ag]) {
+            sym.m_agents[ag] = ag_;
+            search.m_used_agents.set(ag_);
+            enumerate_agents(sym, ag + 1, search);
+            search.m_used_agents.reset(ag_);
+        }
+}
+
+void symmetry_analysis::enumerate_atoms(symmetry &sym, const del::atom p, candidates_search &search) {
+    if (m_symmetries.size() >= max_symmetries_number or search.m_candidates_number >= max_candidates_number)
+        return;
+
+    if (p == sym.m_atoms.size()) {
+        ++search.m_candidates_number;
+        const symmetry &identity = m_symmetries.front();
+
+        if (sym.m_agents == identity.m_agents and sym.m_atoms == identity.m_atoms)
+            return;
+
+        // Compositions of symmetries are symmetries, so we only verify the candidates that are not generated by the
+        // previous ones
+        if (search.m_group.find({sym.m_agents, sym.m_atoms}) != search.m_group.end())
+            m_symmetries.push_back(sym);
+        else if (search.m_verify(sym)) {
+            m_symmetries.push_back(sym);
+            m_generators.push_back(sym);
+            search.m_group = close(search.m_group, m_generators);
+        }
+        return;
+    }
+
+    // The image of p must have the same incidences wrt. the images of the agents
+    auto preserves_incidence = [&](const del::atom q) {
+        for (del::agent ag = 0; ag < sym.m_agents.size(); ++ag)
+            if (search.m_incidence[ag][p] != search.m_incidence[sym.m_agents[ag]][q])
+                return false;
+        return true;
+    };
+
+    for (del::atom q = 0; q < sym.m_atoms.size(); ++q)
+        if (not search.m_used_atoms[q] and search.m_atoms_colors[q] == search.m_atoms_colors[p] and preserves_incidence(q)) {
+            sym.m_atoms[p] = q;
+            search.m_used_atoms.set(q);
+            enumerate_atoms(sym, p + 1, search);
+            search.m_used_atoms.reset(q);
+        }
+}
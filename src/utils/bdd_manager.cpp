@@ -0,0 +1,265 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "../../include/utils/bdd_manager.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace {
+    uint64_t mix(uint64_t h) {
+        // Finalizer of SplitMix64
+        h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+        return h ^ (h >> 31);
+    }
+}
+
+std::size_t bdd_manager::triple_hash::operator()(const std::tuple<bdd, bdd, bdd> &t) const noexcept {
+    return mix(mix(mix(std::get<0>(t)) ^ std::get<1>(t)) ^ std::get<2>(t));
+}
+
+bdd_manager::bdd_manager() {
+    // The terminals come after all variables in the order
+    m_nodes.push_back(node{terminal_var, false_bdd, false_bdd});
+    m_nodes.push_back(node{terminal_var, true_bdd, true_bdd});
+}
+
+bdd_manager::bdd bdd_manager::get_variable(const variable x) {
+    return make_node(x, false_bdd, true_bdd);
+}
+
+bdd_manager::bdd bdd_manager::get_cube(const std::vector<variable> &xs) {
+    bdd cube = true_bdd;
+
+    for (const variable x : xs)
+        cube = apply_and(cube, get_variable(x));
+    return cube;
+}
+
+bdd_manager::bdd bdd_manager::get_minterm(const std::vector<variable> &xs, const unsigned long long bits) {
+    bdd minterm = true_bdd;
+
+    for (unsigned long i = 0; i < xs.size(); ++i) {
+        const bdd x = get_variable(xs[i]);
+        minterm = apply_and(minterm, (bits >> i) & 1 ? x : apply_not(x));
+    }
+    return minterm;
+}
+
+bdd_manager::bdd bdd_manager::apply_not(const bdd f) {
+    return apply_ite(f, false_bdd, true_bdd);
+}
+
+bdd_manager::bdd bdd_manager::apply_and(const bdd f, const bdd g) {
+    return apply_ite(f, g, false_bdd);
+}
+
+bdd_manager::bdd bdd_manager::apply_or(const bdd f, const bdd g) {
+    return apply_ite(f, true_bdd, g);
+}
+
+bdd_manager::bdd bdd_manager::apply_iff(const bdd f, const bdd g) {
+    return apply_ite(f, g, apply_not(g));
+}
+
+bdd_manager::bdd bdd_manager::apply_ite(const bdd f, const bdd g, const bdd h) {
+    check_caches();
+    return ite_helper(f, g, h);
+}
+
+bdd_manager::bdd bdd_manager::exists(const bdd f, const bdd cube) {
+    check_caches();
+    return exists_helper(f, cube);
+}
+
+bdd_manager::bdd bdd_manager::and_exists(const bdd f, const bdd g, const bdd cube) {
+    check_caches();
+    return and_exists_helper(f, g, cube);
+}
+
+bdd_manager::bdd bdd_manager::rename(const bdd f, const std::vector<variable> &renaming) {
+    check_caches();
+    std::unordered_map<bdd, bdd> memo;
+    return rename_helper(f, renaming, memo);
+}
+
+double bdd_manager::count_models(const bdd f, const std::vector<variable> &xs) const {
+    // counts[f] is the number of models of f over the variables of xs from the position of the variable of f onwards
+    std::unordered_map<bdd, double> counts;
+    std::unordered_map<variable, unsigned long> positions;
+
+    for (unsigned long i = 0; i < xs.size(); ++i)
+        positions[xs[i]] = i;
+
+    const auto get_position = [&](const bdd g) { return g <= true_bdd ? xs.size() : positions.at(get_var(g)); };
+
+    std::function<double(bdd)> count = [&](const bdd g) -> double {
+        if (g <= true_bdd)
+            return g == true_bdd ? 1 : 0;
+
+        if (const auto it = counts.find(g); it != counts.end())
+            return it->second;
+
+        const unsigned long p = get_position(g);
+        const bdd low = m_nodes[g].m_low, high = m_nodes[g].m_high;
+        const double c = std::ldexp(count(low), static_cast<int>(get_position(low) - p - 1)) +
+                         std::ldexp(count(high), static_cast<int>(get_position(high) - p - 1));
+        return counts[g] = c;
+    };
+
+    return std::ldexp(count(f), static_cast<int>(get_position(f)));
+}
+
+unsigned long bdd_manager::get_size(const bdd f) const {
+    std::vector<bdd> to_visit = {f};
+    std::unordered_map<bdd, bool> visited = {{f, true}};
+
+    while (not to_visit.empty()) {
+        const bdd g = to_visit.back();
+        to_visit.pop_back();
+
+        if (g > true_bdd)
+            for (const bdd h : {m_nodes[g].m_low, m_nodes[g].m_high})
+                if (visited.emplace(h, true).second)
+                    to_visit.push_back(h);
+    }
+    return visited.size();
+}
+
+unsigned long bdd_manager::get_nodes_number() const {
+    return m_nodes.size();
+}
+
+bdd_manager::bdd bdd_manager::make_node(const variable x, const bdd low, const bdd high) {
+    if (low == high)
+        return low;
+
+    const auto [it, is_new] = m_unique.try_emplace({x, low, high}, m_nodes.size());
+
+    if (is_new)
+        m_nodes.push_back(node{x, low, high});
+    return it->second;
+}
+
+bdd_manager::bdd bdd_manager::ite_helper(const bdd f, const bdd g, const bdd h) {
+    if (f == true_bdd or g == h)
+        return g;
+    if (f == false_bdd)
+        return h;
+    if (g == true_bdd and h == false_bdd)
+        return f;
+
+    if (const auto it = m_ite_cache.find({f, g, h}); it != m_ite_cache.end())
+        return it->second;
+
+    const variable x = std::min({get_var(f), get_var(g), get_var(h)});
+    const bdd low  = ite_helper(get_low(f, x),  get_low(g, x),  get_low(h, x));
+    const bdd high = ite_helper(get_high(f, x), get_high(g, x), get_high(h, x));
+
+    return m_ite_cache[{f, g, h}] = make_node(x, low, high);
+}
+
+bdd_manager::bdd bdd_manager::exists_helper(const bdd f, bdd cube) {
+    // We skip the variables of the cube that come before the one of f, since f does not depend on them
+    while (cube != true_bdd and get_var(cube) < get_var(f))
+        cube = m_nodes[cube].m_high;
+
+    if (f <= true_bdd or cube == true_bdd)
+        return f;
+
+    if (const auto it = m_exists_cache.find({f, cube, 0}); it != m_exists_cache.end())
+        return it->second;
+
+    const variable x = get_var(f);
+    bdd result;
+
+    if (get_var(cube) == x)
+        result = ite_helper(exists_helper(m_nodes[f].m_low, m_nodes[cube].m_high), true_bdd,
+                            exists_helper(m_nodes[f].m_high, m_nodes[cube].m_high));
+    else
+        result = make_node(x, exists_helper(m_nodes[f].m_low, cube), exists_helper(m_nodes[f].m_high, cube));
+
+    return m_exists_cache[{f, cube, 0}] = result;
+}
+
+bdd_manager::bdd bdd_manager::and_exists_helper(const bdd f, const bdd g, bdd cube) {
+    if (f == false_bdd or g == false_bdd)
+        return false_bdd;
+    if (f == true_bdd)
+        return exists_helper(g, cube);
+    if (g == true_bdd or f == g)
+        return exists_helper(f, cube);
+
+    const variable x = std::min(get_var(f), get_var(g));
+
+    while (cube != true_bdd and get_var(cube) < x)
+        cube = m_nodes[cube].m_high;
+
+    if (cube == true_bdd)
+        return ite_helper(f, g, false_bdd);
+
+    const auto key = std::make_tuple(std::min(f, g), std::max(f, g), cube);
+
+    if (const auto it = m_and_exists_cache.find(key); it != m_and_exists_cache.end())
+        return it->second;
+
+    bdd result;
+
+    if (get_var(cube) == x) {
+        const bdd next = m_nodes[cube].m_high;
+        const bdd low = and_exists_helper(get_low(f, x), get_low(g, x), next);
+
+        // If the first cofactor is already true, then so is their disjunction
+        result = low == true_bdd ? true_bdd : ite_helper(low, true_bdd, and_exists_helper(get_high(f, x), get_high(g, x), next));
+    } else
+        result = make_node(x, and_exists_helper(get_low(f, x), get_low(g, x), cube),
+                              and_exists_helper(get_high(f, x), get_high(g, x), cube));
+
+    return m_and_exists_cache[key] = result;
+}
+
+bdd_manager::bdd bdd_manager::rename_helper(const bdd f, const std::vector<variable> &renaming,
+                                            std::unordered_map<bdd, bdd> &memo) {
+    if (f <= true_bdd)
+        return f;
+
+    if (const auto it = memo.find(f); it != memo.end())
+        return it->second;
+
+    const variable x = get_var(f), y = x < renaming.size() ? renaming[x] : x;
+    const bdd low  = rename_helper(m_nodes[f].m_low,  renaming, memo);
+    const bdd high = rename_helper(m_nodes[f].m_high, renaming, memo);
+
+    // Since the renaming may not preserve the order, we rebuild the node with an if-then-else
+    return memo[f] = ite_helper(make_node(y, false_bdd, true_bdd), high, low);
+}
+
+void bdd_manager::check_caches() {
+    if (m_ite_cache.size() + m_exists_cache.size() + m_and_exists_cache.size() > max_cache_size) {
+        m_ite_cache.clear();
+        m_exists_cache.clear();
+        m_and_exists_cache.clear();
+    }
+}
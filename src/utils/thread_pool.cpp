@@ -0,0 +1,178 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "../../include/utils/thread_pool.h"
+
+namespace {
+    constexpr uint64_t pack(const uint64_t lo, const uint64_t hi) { return lo << 32 | hi; }
+    constexpr uint64_t get_lo(const uint64_t range) { return range >> 32; }
+    constexpr uint64_t get_hi(const uint64_t range) { return range & 0xFFFFFFFF; }
+}
+
+thread_pool &thread_pool::get_instance() {
+    static thread_pool pool{std::max(std::thread::hardware_concurrency(), 1u)};
+    return pool;
+}
+
+thread_pool::thread_pool(const unsigned long threads_number) :
+        m_generation{0},
+        m_running{0},
+        m_stop{false},
+        m_busy{false},
+        m_done{0},
+        m_task{nullptr} {
+    start(threads_number);
+}
+
+thread_pool::~thread_pool() {
+    stop();
+}
+
+void thread_pool::set_threads_number(const unsigned long threads_number) {
+    if (threads_number == get_threads_number())
+        return;
+
+    stop();
+    start(threads_number);
+}
+
+void thread_pool::start(const unsigned long threads_number) {
+    const unsigned long n = std::max(threads_number, 1ul);
+    m_ranges = std::make_unique<std::atomic<uint64_t>[]>(n);
+
+    for (unsigned long t = 0; t < n; ++t)
+        m_ranges[t].store(pack(0, 0));
+
+    m_stop = false;
+
+    for (unsigned long t = 1; t < n; ++t)
+        m_workers.emplace_back(&thread_pool::work, this, t);
+}
+
+void thread_pool::stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_start.notify_all();
+
+    for (std::thread &worker : m_workers)
+        worker.join();
+
+    m_workers.clear();
+}
+
+void thread_pool::run(const unsigned long tasks_number, const std::function<void(unsigned long)> &task) {
+    if (m_workers.empty() or tasks_number <= 1 or m_busy.exchange(true)) {
+        for (unsigned long i = 0; i < tasks_number; ++i)
+            task(i);
+        return;
+    }
+
+    const unsigned long threads_number = get_threads_number();
+    m_task = &task;
+    m_done.store(0);
+
+    for (unsigned long t = 0; t < threads_number; ++t)
+        m_ranges[t].store(pack(tasks_number * t / threads_number, tasks_number * (t + 1) / threads_number));
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_generation;
+    }
+    m_start.notify_all();
+
+    execute(0);
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_finish.wait(lock, [&] { return m_running == 0 and m_done.load() == tasks_number; });
+    }
+    m_busy.store(false);
+}
+
+void thread_pool::work(const unsigned long t) {
+    for (unsigned long generation = 0;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_start.wait(lock, [&] { return m_stop or m_generation != generation; });
+
+            if (m_stop)
+                return;
+
+            generation = m_generation;
+            ++m_running;
+        }
+
+        execute(t);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_running;
+        }
+        m_finish.notify_all();
+    }
+}
+
+void thread_pool::execute(const unsigned long t) {
+    unsigned long task;
+
+    while (pop(t, task) or steal(t, task)) {
+        (*m_task)(task);
+        ++m_done;
+    }
+}
+
+bool thread_pool::pop(const unsigned long t, unsigned long &task) {
+    uint64_t range = m_ranges[t].load();
+
+    while (get_lo(range) < get_hi(range))
+        if (m_ranges[t].compare_exchange_weak(range, pack(get_lo(range) + 1, get_hi(range)))) {
+            task = get_lo(range);
+            return true;
+        }
+
+    return false;
+}
+
+bool thread_pool::steal(const unsigned long t, unsigned long &task) {
+    const unsigned long threads_number = get_threads_number();
+
+    for (unsigned long i = 1; i < threads_number; ++i) {
+        const unsigned long victim = (t + i) % threads_number;
+        uint64_t range = m_ranges[victim].load();
+
+        while (get_lo(range) < get_hi(range)) {
+            const uint64_t lo = get_lo(range), hi = get_hi(range), mid = lo + (hi - lo) / 2;
+
+            if (m_ranges[victim].compare_exchange_weak(range, pack(lo, mid))) {
+                // We take the back half [mid, hi) of the range of the victim: we run 'mid' and keep the rest
+                m_ranges[t].store(pack(mid + 1, hi));
+                task = mid;
+                return true;
+            }
+        }
+    }
+    return false;
+}
@@ -0,0 +1,101 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "../../include/utils/clipp.h"
+#include "bisimulation_benchmark.h"
+#include "semantics_benchmark.h"
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace daedalus::tester;
+using namespace clipp;
+
+int main(int argc, char *argv[]) {
+    std::vector<std::string> models, sizes, domains, domain_sizes;
+    std::string suite = "bisimulation", bound = "2", warmup = "1", repetitions = "5", seed = "0", memory_limit = "4096", output;
+    bool json = false;
+
+    auto cli = (
+            option("-s", "--suite") & value("suite", suite).doc("Benchmark suite ('bisimulation' or 'semantics', default: 'bisimulation')"),
+            option("-m", "--models") & values("models", models).doc("Models to generate ('chain', 'k_tree', 's5', 'kd45' or 'hypercube')"),
+            option("-w", "--worlds") & values("worlds", sizes).doc("Number of worlds of the generated models (default: 1000 and 10000)"),
+            option("-d", "--domains") & values("domains", domains).doc("Domains of the semantics suite ('gossip' or 'muddy_children')"),
+            option("-n", "--sizes") & values("sizes", domain_sizes).doc("Number of agents of the domains of the semantics suite (default: 4 and 8)"),
+            option("-b", "--bound") & value("bound", bound).doc("Bound of rooted and canonical contractions, of are_bisimilar and of state ids"),
+            option("--warmup") & value("warmup", warmup).doc("Number of unmeasured runs of each operation"),
+            option("-r", "--repetitions") & value("repetitions", repetitions).doc("Number of measured runs of each operation"),
+            option("--seed") & value("seed", seed).doc("Seed of the random models"),
+            option("--memory-limit") & value("MB", memory_limit).doc("Skips the models whose relations would take more memory"),
+            option("-o", "--output") & value("file", output).doc("Output file (default: standard output)"),
+            option("--json").set(json).doc("Prints one JSON object per line rather than CSV")
+    );
+
+    if (not parse(argc, argv, cli)) {
+        std::cout << make_man_page(cli, argv[0]);
+        return 1;
+    }
+
+    // Values given on the command line are appended, so defaults are only set afterwards
+    if (domains.empty())
+        domains = semantics_benchmark::domains;
+
+    if (domain_sizes.empty())
+        domain_sizes = {"4", "8"};
+
+    if (models.empty())
+        models = bisimulation_benchmark::models;
+
+    if (sizes.empty())
+        sizes = {"1000", "10000"};
+
+    // Peak memory is a process-wide high watermark: run one model and size per process to measure them separately
+    std::ofstream out_file;
+
+    if (not output.empty())
+        out_file.open(output);
+
+    std::ostream &out = output.empty() ? std::cout : out_file;
+    const benchmark_format format = json ? benchmark_format::json : benchmark_format::csv;
+
+    if (suite == "semantics") {
+        semantics_benchmark::print_header(format, out);
+
+        for (const auto &domain : domains)
+            for (const auto &size : domain_sizes)
+                semantics_benchmark::run(domain, std::stoul(size), std::stoul(warmup), std::stoul(repetitions), format, out);
+
+        return 0;
+    }
+
+    bisimulation_benchmark::print_header(format, out);
+
+    for (const auto &model : models)
+        for (const auto &size : sizes)
+            bisimulation_benchmark::run(model, std::stoul(size), std::stoul(bound), std::stoul(warmup), std::stoul(repetitions),
+                                        std::stoul(seed), std::stoull(memory_limit) * 1024 * 1024, format, out);
+
+    return 0;
+}
@@ -0,0 +1,158 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "bisimulation_benchmark.h"
+#include "../builder/state_builder.h"
+#include "../../include/del/semantics/kripke/bisimulation/bisimulator.h"
+#include "../../include/del/semantics/kripke/bisimulation/bounded_identification.h"
+#include "../../include/utils/storages_handler.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <sys/resource.h>
+
+using namespace daedalus::tester;
+using namespace kripke;
+
+const std::vector<std::string> bisimulation_benchmark::models = {"chain", "k_tree", "s5", "kd45", "hypercube"};
+
+void bisimulation_benchmark::print_header(benchmark_format format, std::ostream &out) {
+    if (format == benchmark_format::csv)
+        out << "model,worlds,agents,edges,operation,bound,repetitions,median_ms,min_ms,max_ms,peak_memory_kb,result" << std::endl;
+}
+
+void bisimulation_benchmark::run(const std::string &model, unsigned long worlds_number, unsigned long k, unsigned long warmup,
+                                 unsigned long repetitions, unsigned long seed, unsigned long long memory_limit,
+                                 benchmark_format format, std::ostream &out) {
+    if (unsigned long long memory = estimate_memory(model, worlds_number); memory > memory_limit) {
+        std::cerr << "Skipping model '" << model << "' with " << worlds_number << " worlds: its relations would take about "
+                  << memory / (1024 * 1024) << " MB" << std::endl;
+        return;
+    }
+
+    del::label_storage l_storage;
+    const state s = build_model(model, worlds_number, seed, l_storage);
+    const state t = state_builder::build_permutation(s, seed);
+
+    const std::vector<std::pair<std::string, operation>> operations = {
+        {"full_contraction", [&](del::storages_handler_ptr &handler) {
+            return bisimulator::contract(contraction_type::full, s, k, handler).second.get_worlds_number(); }},
+        {"rooted_contraction", [&](del::storages_handler_ptr &handler) {
+            return bisimulator::contract(contraction_type::rooted, s, k, handler).second.get_worlds_number(); }},
+        {"canonical_contraction", [&](del::storages_handler_ptr &handler) {
+            return bisimulator::contract(contraction_type::canonical, s, k, handler).second.get_worlds_number(); }},
+        {"are_bisimilar", [&](del::storages_handler_ptr &handler) {
+            return static_cast<unsigned long long>(bisimulator::are_bisimilar(s, t, k, handler)); }},
+        {"state_id", [&](del::storages_handler_ptr &handler) {
+            return static_cast<unsigned long long>(bounded_identification::calculate_state_id(s, k, handler)); }}
+    };
+
+    for (const auto &[op_name, op] : operations) {
+        auto [result, times] = measure(op, k, warmup, repetitions, l_storage);
+        print_row(model, s, op_name, k, repetitions, times, result, format, out);
+    }
+}
+
+state bisimulation_benchmark::build_model(const std::string &model, unsigned long worlds_number, unsigned long seed,
+                                          del::label_storage &l_storage) {
+    const auto log_worlds_number = static_cast<unsigned long>(std::log2(std::max(worlds_number, 2UL)));
+    const unsigned long groups_number = std::max(worlds_number / random_class_size, 1UL);
+
+    if (model == "chain")
+        return state_builder::build_chain(worlds_number - 1, l_storage, true);
+    else if (model == "k_tree")
+        return state_builder::build_k_tree(log_worlds_number, l_storage);
+    else if (model == "s5")
+        return state_builder::build_random_s5(worlds_number, random_agents_number, groups_number, random_atoms_number, seed, l_storage);
+    else if (model == "kd45")
+        return state_builder::build_random_kd45(worlds_number, random_agents_number, groups_number, random_atoms_number, seed, l_storage);
+    else if (model == "hypercube")
+        return state_builder::build_hypercube(log_worlds_number, l_storage);
+
+    throw std::invalid_argument("Unknown model '" + model + "'");
+}
+
+unsigned long long bisimulation_benchmark::estimate_memory(const std::string &model, unsigned long worlds_number) {
+    // Every row of a relation is a bitset over all worlds. The disjoint union has twice as many worlds and rows
+    const unsigned long long agents_number =
+            model == "chain" ? 2 : (model == "k_tree" ? 1 : (model == "hypercube" ? std::log2(std::max(worlds_number, 2UL)) : random_agents_number));
+    const unsigned long long row_bytes = (worlds_number + 63) / 64 * 8;
+
+    return 6 * agents_number * worlds_number * row_bytes;
+}
+
+std::pair<unsigned long long, std::vector<double>>
+bisimulation_benchmark::measure(const operation &op, unsigned long k, unsigned long warmup, unsigned long repetitions,
+                                const del::label_storage &l_storage) {
+    std::vector<double> times;
+    unsigned long long result = 0;
+
+    for (unsigned long i = 0; i < warmup + repetitions; ++i) {
+        // Storages are not shared among runs, so that later runs do not find the signatures of earlier ones
+        del::storages_handler_ptr handler = std::make_shared<del::storages_handler>(k, l_storage);
+
+        auto start = std::chrono::steady_clock::now();
+        result = op(handler);
+        auto end = std::chrono::steady_clock::now();
+
+        if (i >= warmup)
+            times.emplace_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+
+    return {result, std::move(times)};
+}
+
+long bisimulation_benchmark::get_peak_memory() {
+    struct rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+void bisimulation_benchmark::print_row(const std::string &model, const state &s, const std::string &op_name, unsigned long k,
+                                       unsigned long repetitions, std::vector<double> &times, unsigned long long result,
+                                       benchmark_format format, std::ostream &out) {
+    const del::agent agents_number = s.get_language()->get_agents_number();
+    unsigned long long edges_number = 0;
+
+    for (del::agent ag = 0; ag < agents_number; ++ag)
+        for (world_id w = 0; w < s.get_worlds_number(); ++w)
+            edges_number += s.get_agent_possible_worlds(ag, w).size();
+
+    std::sort(times.begin(), times.end());
+    const double median = times.empty() ? 0 :
+            (times.size() % 2 == 1 ? times[times.size() / 2] : (times[times.size() / 2 - 1] + times[times.size() / 2]) / 2);
+    const double min = times.empty() ? 0 : times.front(), max = times.empty() ? 0 : times.back();
+
+    if (format == benchmark_format::csv)
+        out << model << "," << s.get_worlds_number() << "," << agents_number << "," << edges_number << "," << op_name << ","
+            << k << "," << repetitions << "," << median << "," << min << "," << max << "," << get_peak_memory() << ","
+            << result << std::endl;
+    else
+        out << "{\"model\": \"" << model << "\", \"worlds\": " << s.get_worlds_number() << ", \"agents\": " << agents_number
+            << ", \"edges\": " << edges_number << ", \"operation\": \"" << op_name << "\", \"bound\": " << k
+            << ", \"repetitions\": " << repetitions << ", \"median_ms\": " << median << ", \"min_ms\": " << min
+            << ", \"max_ms\": " << max << ", \"peak_memory_kb\": " << get_peak_memory() << ", \"result\": " << result
+            << "}" << std::endl;
+}
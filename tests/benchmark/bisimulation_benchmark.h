@@ -0,0 +1,85 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef DAEDALUS_BISIMULATION_BENCHMARK_H
+#define DAEDALUS_BISIMULATION_BENCHMARK_H
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "../../include/del/semantics/kripke/states/state.h"
+#include "../../include/utils/storage_types.h"
+
+namespace daedalus::tester {
+    enum class benchmark_format : uint8_t {
+        csv,
+        json
+    };
+
+    class bisimulation_benchmark {
+    public:
+        // Names of the synthetic models: 'chain', 'k_tree', 's5', 'kd45' and 'hypercube'
+        static const std::vector<std::string> models;
+
+        static void print_header(benchmark_format format, std::ostream &out);
+
+        // Builds the given model with (about) worlds_number worlds and times full, rooted and canonical contractions,
+        // are_bisimilar and calculate_state_id on it. Each operation is run warmup times without being measured, and then
+        // repetitions times. Models whose relations would take more than memory_limit bytes are skipped
+        static void run(const std::string &model, unsigned long worlds_number, unsigned long k, unsigned long warmup,
+                        unsigned long repetitions, unsigned long seed, unsigned long long memory_limit,
+                        benchmark_format format, std::ostream &out);
+
+        // Peak resident set size of the process so far, in kilobytes
+        [[nodiscard]] static long get_peak_memory();
+
+    private:
+        // Number of agents and atoms of the random models
+        static constexpr unsigned long random_agents_number = 3, random_atoms_number = 2;
+
+        // Average size of the classes (resp. clusters) of the random S5 (resp. KD45) models
+        static constexpr unsigned long random_class_size = 8;
+
+        // Benchmarked operation: it runs on a fresh storages handler and returns a number that summarizes its result
+        using operation = std::function<unsigned long long(del::storages_handler_ptr &)>;
+
+        static kripke::state build_model(const std::string &model, unsigned long worlds_number, unsigned long seed,
+                                         del::label_storage &l_storage);
+
+        // Upper bound to the bytes taken by the relations of a model, its permuted copy and their disjoint union
+        [[nodiscard]] static unsigned long long estimate_memory(const std::string &model, unsigned long worlds_number);
+
+        // Milliseconds taken by each measured run of op, together with the result of the last run
+        static std::pair<unsigned long long, std::vector<double>>
+        measure(const operation &op, unsigned long k, unsigned long warmup, unsigned long repetitions,
+                const del::label_storage &l_storage);
+
+        static void print_row(const std::string &model, const kripke::state &s, const std::string &op_name, unsigned long k,
+                              unsigned long repetitions, std::vector<double> &times, unsigned long long result,
+                              benchmark_format format, std::ostream &out);
+    };
+}
+
+#endif //DAEDALUS_BISIMULATION_BENCHMARK_H
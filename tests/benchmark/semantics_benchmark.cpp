@@ -0,0 +1,167 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "semantics_benchmark.h"
+#include "../builder/domains/active_muddy_children.h"
+#include "../builder/domains/gossip.h"
+#include "../../include/del/semantics/kripke/update/updater.h"
+#include "../../include/del/semantics/symbolic/update/updater.h"
+#include <algorithm>
+#include <chrono>
+#include <memory>
+
+using namespace daedalus::tester;
+
+const std::vector<std::string> semantics_benchmark::domains = {"gossip", "muddy_children"};
+
+void semantics_benchmark::print_header(benchmark_format format, std::ostream &out) {
+    if (format == benchmark_format::csv)
+        out << "domain,size,semantics,worlds,operation,repetitions,median_ms,min_ms,max_ms,bdd_nodes,peak_memory_kb,result" << std::endl;
+}
+
+void semantics_benchmark::run(const std::string &domain, unsigned long size, unsigned long warmup, unsigned long repetitions,
+                              benchmark_format format, std::ostream &out) {
+    if (std::find(domains.begin(), domains.end(), domain) == domains.end())
+        throw std::invalid_argument("Unknown domain '" + domain + "'");
+
+    run_explicit(domain, size, warmup, repetitions, format, out);
+    run_symbolic(domain, size, warmup, repetitions, format, out);
+}
+
+void semantics_benchmark::run_explicit(const std::string &domain, unsigned long size, unsigned long warmup,
+                                       unsigned long repetitions, benchmark_format format, std::ostream &out) {
+    del::label_storage l_storage;
+    const search::planning_task task = build_task(domain, size, l_storage);
+    const kripke::state &s = *task.get_initial_state();
+    const auto worlds_number = static_cast<double>(s.get_worlds_number());
+
+    const setup no_setup = [] {};
+    const auto no_nodes = [] { return 0UL; };
+
+    measure(domain, size, "explicit", worlds_number, "initial_state", no_setup, [&] {
+        // Labels are stored in a fresh storage, so that later runs do not find the labels of earlier ones
+        del::label_storage run_l_storage;
+        return build_task(domain, size, run_l_storage).get_initial_state()->get_worlds_number();
+    }, no_nodes, warmup, repetitions, format, out);
+
+    measure(domain, size, "explicit", worlds_number, "goal_check", no_setup, [&] {
+        return static_cast<unsigned long long>(s.satisfies(task.get_goal(), l_storage));
+    }, no_nodes, warmup, repetitions, format, out);
+
+    measure(domain, size, "explicit", worlds_number, "update", no_setup, [&] {
+        unsigned long long updated_worlds_number = 0;
+
+        for (const auto &a : task.get_actions())
+            if (kripke::updater::is_applicable(s, *a, l_storage))
+                updated_worlds_number += kripke::updater::product_update(s, *a, l_storage).get_worlds_number();
+        return updated_worlds_number;
+    }, no_nodes, warmup, repetitions, format, out);
+}
+
+void semantics_benchmark::run_symbolic(const std::string &domain, unsigned long size, unsigned long warmup,
+                                       unsigned long repetitions, benchmark_format format, std::ostream &out) {
+    // Actions and goals stay explicit: only the states are symbolic
+    del::label_storage l_storage;
+    const search::planning_task task = build_task(domain, size, l_storage);
+
+    bdd_manager_ptr manager;
+    std::unique_ptr<symbolic::state> s;
+
+    const auto build_state = [&] {
+        manager = std::make_shared<bdd_manager>();
+
+        if (domain == "gossip")
+            return gossip::build_symbolic_initial_state(size, size, manager);
+        else
+            return active_muddy_children::build_symbolic_initial_state(size, std::max(size / 2, 1UL), true, manager);
+    };
+
+    const setup set_up = [&] { s = std::make_unique<symbolic::state>(build_state()); };
+    const auto nodes_number = [&] { return manager->get_nodes_number(); };
+
+    set_up();
+    const double worlds_number = s->get_worlds_number();
+
+    measure(domain, size, "symbolic", worlds_number, "initial_state", [] {}, [&] {
+        return static_cast<unsigned long long>(build_state().get_worlds_number());
+    }, nodes_number, warmup, repetitions, format, out);
+
+    measure(domain, size, "symbolic", worlds_number, "goal_check", set_up, [&] {
+        return static_cast<unsigned long long>(s->satisfies(task.get_goal()));
+    }, nodes_number, warmup, repetitions, format, out);
+
+    measure(domain, size, "symbolic", worlds_number, "update", set_up, [&] {
+        unsigned long long updated_worlds_number = 0;
+
+        for (const auto &a : task.get_actions())
+            if (symbolic::updater::is_applicable(*s, *a))
+                updated_worlds_number += static_cast<unsigned long long>(symbolic::updater::product_update(*s, *a).get_worlds_number());
+        return updated_worlds_number;
+    }, nodes_number, warmup, repetitions, format, out);
+}
+
+search::planning_task semantics_benchmark::build_task(const std::string &domain, unsigned long size, del::label_storage &l_storage) {
+    // Gossip instances have as many secrets as agents and muddy children instances have half of the children muddy
+    if (domain == "gossip")
+        return gossip::build_task(size, size, 1, l_storage);
+    else
+        return active_muddy_children::build_task(size, std::max(size / 2, 1UL), true, l_storage);
+}
+
+void semantics_benchmark::measure(const std::string &domain, unsigned long size, const std::string &semantics,
+                                  double worlds_number, const std::string &op_name, const setup &set_up,
+                                  const operation &op, const std::function<unsigned long()> &nodes_number,
+                                  unsigned long warmup, unsigned long repetitions, benchmark_format format,
+                                  std::ostream &out) {
+    std::vector<double> times;
+    unsigned long long result = 0;
+
+    for (unsigned long i = 0; i < warmup + repetitions; ++i) {
+        set_up();
+
+        auto start = std::chrono::steady_clock::now();
+        result = op();
+        auto end = std::chrono::steady_clock::now();
+
+        if (i >= warmup)
+            times.emplace_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+
+    std::sort(times.begin(), times.end());
+    const double median = times.empty() ? 0 :
+            (times.size() % 2 == 1 ? times[times.size() / 2] : (times[times.size() / 2 - 1] + times[times.size() / 2]) / 2);
+    const double min = times.empty() ? 0 : times.front(), max = times.empty() ? 0 : times.back();
+    const long peak_memory = bisimulation_benchmark::get_peak_memory();
+
+    if (format == benchmark_format::csv)
+        out << domain << "," << size << "," << semantics << "," << worlds_number << "," << op_name << "," << repetitions
+            << "," << median << "," << min << "," << max << "," << nodes_number() << "," << peak_memory << "," << result
+            << std::endl;
+    else
+        out << "{\"domain\": \"" << domain << "\", \"size\": " << size << ", \"semantics\": \"" << semantics
+            << "\", \"worlds\": " << worlds_number << ", \"operation\": \"" << op_name << "\", \"repetitions\": "
+            << repetitions << ", \"median_ms\": " << median << ", \"min_ms\": " << min << ", \"max_ms\": " << max
+            << ", \"bdd_nodes\": " << nodes_number() << ", \"peak_memory_kb\": " << peak_memory << ", \"result\": "
+            << result << "}" << std::endl;
+}
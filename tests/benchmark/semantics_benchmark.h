@@ -0,0 +1,71 @@
+//
+// DAEDALUS - DynAmic Epistemic and DoxAstic Logic Universal Solver (MIT License)
+//
+// Copyright (c) 2023-2024 Alessandro Burigana
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef DAEDALUS_SEMANTICS_BENCHMARK_H
+#define DAEDALUS_SEMANTICS_BENCHMARK_H
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "bisimulation_benchmark.h"
+#include "../../include/search/planning_task.h"
+
+namespace daedalus::tester {
+    class semantics_benchmark {
+    public:
+        // Names of the benchmarked domains: 'gossip' and 'muddy_children'
+        static const std::vector<std::string> domains;
+
+        static void print_header(benchmark_format format, std::ostream &out);
+
+        // Builds the initial state of the given domain instance with the explicit and with the symbolic semantics, and
+        // times building it, checking the goal on it and updating it with every applicable action. Each operation is
+        // run warmup times without being measured, and then repetitions times
+        static void run(const std::string &domain, unsigned long size, unsigned long warmup, unsigned long repetitions,
+                        benchmark_format format, std::ostream &out);
+
+    private:
+        // Benchmarked operation: it returns a number that summarizes its result. Its setup is run before each run of
+        // the operation without being measured, so that no run finds the BDDs cached by the previous ones
+        using operation = std::function<unsigned long long()>;
+        using setup = std::function<void()>;
+
+        static void run_explicit(const std::string &domain, unsigned long size, unsigned long warmup,
+                                 unsigned long repetitions, benchmark_format format, std::ostream &out);
+
+        static void run_symbolic(const std::string &domain, unsigned long size, unsigned long warmup,
+                                 unsigned long repetitions, benchmark_format format, std::ostream &out);
+
+        static search::planning_task build_task(const std::string &domain, unsigned long size, del::label_storage &l_storage);
+
+        // Measures op and prints its row. The number of BDD nodes is taken from the manager after the last run
+        static void measure(const std::string &domain, unsigned long size, const std::string &semantics, double worlds_number,
+                            const std::string &op_name, const setup &set_up, const operation &op,
+                            const std::function<unsigned long()> &nodes_number, unsigned long warmup,
+                            unsigned long repetitions, benchmark_format format, std::ostream &out);
+    };
+}
+
+#endif //DAEDALUS_SEMANTICS_BENCHMARK_H
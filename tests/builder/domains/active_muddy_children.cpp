@@ -28,6 +28,7 @@
 #include "../../../include/del/formulas/modal/box_formula.h"
 #include "../../../include/del/formulas/propositional/not_formula.h"
 #include "../../../include/del/formulas/propositional/or_formula.h"
+#include "../../../include/del/formulas/propositional/and_formula.h"
 #include "../../../include/del/formulas/propositional/true_formula.h"
 #include "ma_star_utils.h"
 #include <filesystem>
@@ -111,6 +112,31 @@ active_muddy_children::build_initial_state(unsigned long children_no, unsigned l
     return state{language, worlds_number, std::move(r), std::move(ls), std::move(designated_worlds)};
 }
 
+symbolic::state active_muddy_children::build_symbolic_initial_state(unsigned long children_no, unsigned long muddy_no, bool is_0_muddy,
+                                                                    const bdd_manager_ptr &manager) {
+    assert(children_no >= muddy_no and muddy_no > 0);
+
+    language_ptr language = active_muddy_children::build_language(children_no, muddy_no);
+    unsigned long min_child = is_0_muddy ? 0 : children_no - muddy_no, max_child = is_0_muddy ? muddy_no : children_no;
+
+    // At least one child is muddy, and every child observes the foreheads of all the other children
+    std::vector<std::vector<atom>> observables(children_no);
+    formula_deque muddy_fs, actual_fs;
+
+    for (agent ag = 0; ag < children_no; ++ag) {
+        for (atom p = 0; p < children_no; ++p)
+            if (p != ag)
+                observables[ag].push_back(p);
+
+        formula_ptr muddy = std::make_shared<atom_formula>(ag);
+        muddy_fs.push_back(muddy);
+        actual_fs.push_back(min_child <= ag and ag < max_child ? muddy : std::make_shared<not_formula>(muddy));
+    }
+
+    return symbolic::state::build_knowledge_structure(language, manager, or_formula{std::move(muddy_fs)}, observables,
+                                                      and_formula{std::move(actual_fs)});
+}
+
 kripke::action_deque active_muddy_children::build_actions(unsigned long children_no, unsigned long muddy_no) {
     action_deque actions;
 
@@ -137,7 +163,7 @@ search::planning_task active_muddy_children::build_task(unsigned long children_n
     formula_deque fs  = {std::move(K_0_muddy_0), std::move(K_0_not_muddy_0)};
     formula_ptr goal = std::make_shared<or_formula>(std::move(fs));
 
-    return search::planning_task{std::move(name), std::move(id), language, std::move(s0), std::move(actions), std::move(goal)};
+    return search::planning_task{std::move(name), std::move(id), language, std::move(s0), std::move(actions), std::move(goal), l_storage};
 }
 
 std::vector<search::planning_task> active_muddy_children::build_tasks(label_storage &l_storage) {
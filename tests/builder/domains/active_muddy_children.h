@@ -26,6 +26,7 @@
 
 #include "../../../include/del/language/language.h"
 #include "../../../include/del/semantics/kripke/states/state.h"
+#include "../../../include/del/semantics/symbolic/states/state.h"
 #include "../../../include/search/planning_task.h"
 
 namespace daedalus::tester {
@@ -35,6 +36,7 @@ namespace daedalus::tester {
 
         static del::language_ptr build_language(unsigned long children_no, unsigned long muddy_no);
         static kripke::state build_initial_state(unsigned long children_no, unsigned long muddy_no, bool is_0_muddy, del::label_storage &l_storage);
+        static symbolic::state build_symbolic_initial_state(unsigned long children_no, unsigned long muddy_no, bool is_0_muddy, const bdd_manager_ptr &manager);
 
         static kripke::action_deque build_actions(unsigned long children_no, unsigned long muddy_no);
         static search::planning_task build_task(unsigned long children_no, unsigned long muddy_no, bool is_0_muddy, del::label_storage &l_storage);
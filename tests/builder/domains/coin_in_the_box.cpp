@@ -149,7 +149,7 @@ search::planning_task coin_in_the_box::build_task_1(label_storage &l_storage) {
     formula_ptr heads = std::make_shared<atom_formula>(language->get_atom_id("heads"));
     formula_ptr B_a_heads = std::make_shared<box_formula>(language->get_agent_id("a"), heads);
 
-    return search::planning_task{std::move(domain_name), "cb_" + std::to_string(problem_id), language, std::move(s0), std::move(actions), std::move(B_a_heads)};
+    return search::planning_task{std::move(domain_name), "cb_" + std::to_string(problem_id), language, std::move(s0), std::move(actions), std::move(B_a_heads), l_storage};
 }
 
 search::planning_task coin_in_the_box::build_task_2(label_storage &l_storage) {
@@ -163,7 +163,7 @@ search::planning_task coin_in_the_box::build_task_2(label_storage &l_storage) {
     formula_ptr heads = std::make_shared<atom_formula>(language->get_atom_id("heads"));
     formula_ptr B_b_heads = std::make_shared<box_formula>(language->get_agent_id("b"), heads);
 
-    return search::planning_task{std::move(domain_name), "cb_" + std::to_string(problem_id), language, std::move(s0), std::move(actions), std::move(B_b_heads)};
+    return search::planning_task{std::move(domain_name), "cb_" + std::to_string(problem_id), language, std::move(s0), std::move(actions), std::move(B_b_heads), l_storage};
 }
 
 search::planning_task coin_in_the_box::build_task_3(label_storage &l_storage) {
@@ -182,7 +182,7 @@ search::planning_task coin_in_the_box::build_task_3(label_storage &l_storage) {
 
     formula_ptr goal = std::make_shared<and_formula>(std::move(fs));
 
-    return search::planning_task{std::move(domain_name), "cb_" + std::to_string(problem_id), language, std::move(s0), std::move(actions), std::move(goal)};
+    return search::planning_task{std::move(domain_name), "cb_" + std::to_string(problem_id), language, std::move(s0), std::move(actions), std::move(goal), l_storage};
 }
 
 search::planning_task coin_in_the_box::build_task_4(label_storage &l_storage) {
@@ -215,7 +215,7 @@ search::planning_task coin_in_the_box::build_task_4(label_storage &l_storage) {
     formula_deque fs = {goal_1, goal_2, B_b_heads, B_c_heads};
     formula_ptr goal = std::make_shared<and_formula>(std::move(fs));
 
-    return search::planning_task{std::move(domain_name), "cb_" + std::to_string(problem_id), language, std::move(s0), std::move(actions), std::move(goal)};
+    return search::planning_task{std::move(domain_name), "cb_" + std::to_string(problem_id), language, std::move(s0), std::move(actions), std::move(goal), l_storage};
 }
 
 search::planning_task coin_in_the_box::build_task_5(label_storage &l_storage) {
@@ -246,7 +246,7 @@ search::planning_task coin_in_the_box::build_task_5(label_storage &l_storage) {
     formula_deque fs = {goal_1, goal_2, B_b_heads, B_c_heads};
     formula_ptr goal = std::make_shared<and_formula>(std::move(fs));
 
-    return search::planning_task{std::move(domain_name), "cb_" + std::to_string(problem_id), language, std::move(s0), std::move(actions), std::move(goal)};
+    return search::planning_task{std::move(domain_name), "cb_" + std::to_string(problem_id), language, std::move(s0), std::move(actions), std::move(goal), l_storage};
 }
 
 search::planning_task coin_in_the_box::build_task_6(label_storage &l_storage) {
@@ -285,7 +285,7 @@ search::planning_task coin_in_the_box::build_task_6(label_storage &l_storage) {
 //    formula_deque fs = {goal_1, goal_2, B_b_heads, B_c_heads};
     formula_ptr goal = std::make_shared<and_formula>(std::move(fs));
 
-    return search::planning_task{std::move(domain_name), "cb_" + std::to_string(problem_id), language, std::move(s0), std::move(actions), std::move(goal)};
+    return search::planning_task{std::move(domain_name), "cb_" + std::to_string(problem_id), language, std::move(s0), std::move(actions), std::move(goal), l_storage};
 }
 
 
@@ -230,7 +230,7 @@ search::planning_task collaboration_communication::build_task(unsigned long agen
     action_deque actions = collaboration_communication::build_actions(agents_no, rooms_no, boxes_no);
     formula_ptr goal = collaboration_communication::build_goal(language, boxes_no, goal_id);
 
-    return search::planning_task{std::move(name), std::move(id), language, std::move(s0), std::move(actions), std::move(goal)};
+    return search::planning_task{std::move(name), std::move(id), language, std::move(s0), std::move(actions), std::move(goal), l_storage};
 }
 
 std::vector<search::planning_task> collaboration_communication::build_tasks(label_storage &l_storage) {
@@ -132,7 +132,7 @@ search::planning_task consecutive_numbers::build_task(unsigned long n, label_sto
     formula_ptr B_a_has_b_n_b = std::make_shared<box_formula>(a, std::move(has_b_n_b));
     formula_ptr goal          = std::make_shared<box_formula>(b, std::move(B_a_has_b_n_b));
 
-    return search::planning_task{consecutive_numbers::get_name(), std::to_string(n), language, std::move(s0), std::move(actions), std::move(goal)};
+    return search::planning_task{consecutive_numbers::get_name(), std::to_string(n), language, std::move(s0), std::move(actions), std::move(goal), l_storage};
 }
 
 std::vector<search::planning_task> consecutive_numbers::build_tasks(label_storage &l_storage) {
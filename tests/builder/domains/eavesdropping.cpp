@@ -114,7 +114,7 @@ search::planning_task eavesdropping::build_task(unsigned long agents_no, unsigne
     formula_ptr goal = std::make_shared<and_formula>(std::move(fs));
 //    formula_ptr goal = std::make_shared<box_formula>(agents_no-1, std::make_shared<and_formula>(std::move(fs)));
 
-    return search::planning_task{std::move(name), std::move(id), language, std::move(s0), std::move(actions), std::move(goal)};
+    return search::planning_task{std::move(name), std::move(id), language, std::move(s0), std::move(actions), std::move(goal), l_storage};
 }
 
 std::vector<search::planning_task> eavesdropping::build_tasks(del::label_storage &l_storage) {
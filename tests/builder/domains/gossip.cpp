@@ -28,6 +28,7 @@
 #include "../../../include/del/formulas/modal/box_formula.h"
 #include "../../../include/del/formulas/propositional/not_formula.h"
 #include "../../../include/del/formulas/propositional/and_formula.h"
+#include "../../../include/del/formulas/propositional/true_formula.h"
 #include "ma_star_utils.h"
 #include <filesystem>
 #include <fstream>
@@ -101,6 +102,23 @@ kripke::state gossip::build_initial_state(unsigned long agents_no, unsigned long
     return state{language, worlds_number, std::move(r), std::move(ls), std::move(designated_worlds)};
 }
 
+symbolic::state gossip::build_symbolic_initial_state(unsigned long agents_no, unsigned long secrets_no, const bdd_manager_ptr &manager) {
+    language_ptr language = gossip::build_language(agents_no, secrets_no);
+
+    // Every agent with a secret only observes its own secret, the remaining agents observe nothing
+    std::vector<std::vector<atom>> observables(language->get_agents_number());
+
+    for (agent ag = 0; ag < secrets_no; ++ag)
+        observables[ag] = {ag};
+
+    formula_deque fs;
+
+    for (atom p = 0; p < secrets_no; ++p)
+        fs.push_back(std::make_shared<atom_formula>(p));
+
+    return symbolic::state::build_knowledge_structure(language, manager, true_formula{}, observables, and_formula{std::move(fs)});
+}
+
 kripke::action_deque gossip::build_actions(unsigned long agents_no, unsigned long secrets_no) {
     action_deque actions;
 
@@ -121,7 +139,7 @@ search::planning_task gossip::build_task(unsigned long agents_no, unsigned long
     action_deque actions = gossip::build_actions(agents_no, secrets_no);
     formula_ptr goal = gossip::build_goal(agents_no, secrets_no, goal_id);
 
-    return search::planning_task{std::move(name), std::move(id), language, std::move(s0), std::move(actions), std::move(goal)};
+    return search::planning_task{std::move(name), std::move(id), language, std::move(s0), std::move(actions), std::move(goal), l_storage};
 }
 
 std::vector<search::planning_task> gossip::build_tasks(label_storage &l_storage) {
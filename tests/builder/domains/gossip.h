@@ -26,6 +26,7 @@
 
 #include "../../../include/del/language/language.h"
 #include "../../../include/del/semantics/kripke/states/state.h"
+#include "../../../include/del/semantics/symbolic/states/state.h"
 #include "../../../include/search/planning_task.h"
 
 namespace daedalus::tester {
@@ -35,6 +36,7 @@ namespace daedalus::tester {
 
         static del::language_ptr build_language(unsigned long agents_no, unsigned long secrets_no);
         static kripke::state build_initial_state(unsigned long agents_no, unsigned long secrets_no, del::label_storage &l_storage);
+        static symbolic::state build_symbolic_initial_state(unsigned long agents_no, unsigned long secrets_no, const bdd_manager_ptr &manager);
 
         static kripke::action_deque build_actions(unsigned long agents_no, unsigned long secrets_no);
         static search::planning_task build_task(unsigned long agents_no, unsigned long secrets_no, unsigned long goal_id, del::label_storage &l_storage);
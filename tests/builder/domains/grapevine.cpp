@@ -142,7 +142,7 @@ search::planning_task grapevine::build_task(unsigned long agents_no, unsigned lo
     action_deque actions = grapevine::build_actions(agents_no, secrets_no);
     formula_ptr goal = grapevine::build_goal(agents_no, secrets_no, learning_ags_no);
 
-    return search::planning_task{std::move(name), std::move(id), language, std::move(s0), std::move(actions), std::move(goal)};
+    return search::planning_task{std::move(name), std::move(id), language, std::move(s0), std::move(actions), std::move(goal), l_storage};
 }
 
 std::vector<search::planning_task> grapevine::build_tasks(label_storage &l_storage) {
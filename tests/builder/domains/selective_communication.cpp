@@ -198,7 +198,7 @@ search::planning_task selective_communication::build_task(unsigned long agents_n
     action_deque actions = selective_communication::build_actions(agents_no, rooms_no);
     formula_ptr goal = selective_communication::build_goal(language, goal_id);
 
-    return search::planning_task{std::move(name), std::move(id), language, std::move(s0), std::move(actions), std::move(goal)};
+    return search::planning_task{std::move(name), std::move(id), language, std::move(s0), std::move(actions), std::move(goal), l_storage};
 }
 
 std::vector<search::planning_task> selective_communication::build_tasks(del::label_storage &l_storage) {
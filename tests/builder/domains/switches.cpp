@@ -112,7 +112,7 @@ search::planning_task switches::build_task(unsigned long n, label_storage &l_sto
 
     formula_ptr goal = std::make_shared<and_formula>(std::move(fs));
 
-    return search::planning_task{switches::get_name(), std::to_string(n), language, std::move(s0), std::move(actions), std::move(goal)};
+    return search::planning_task{switches::get_name(), std::to_string(n), language, std::move(s0), std::move(actions), std::move(goal), l_storage};
 }
 
 std::vector<search::planning_task> switches::build_tasks(label_storage &l_storage) {
@@ -143,7 +143,7 @@ search::planning_task tiger::build_task(unsigned long doors_no, unsigned long ti
     fs.push_back(std::move(saved_princess));
     formula_ptr goal = std::make_shared<and_formula>(std::move(fs));
 
-    return search::planning_task{std::move(name), std::move(id), language, std::move(s0), std::move(actions), std::move(goal)};
+    return search::planning_task{std::move(name), std::move(id), language, std::move(s0), std::move(actions), std::move(goal), l_storage};
 }
 
 std::vector<search::planning_task> tiger::build_tasks(label_storage &l_storage) {
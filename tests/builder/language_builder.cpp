@@ -40,3 +40,15 @@ language_ptr language_builder::build_language3() {
     name_vector atom_names = {"p"}, agent_names = {"a"};
     return std::make_shared<language>(std::move(language{atom_names, agent_names}));
 }
+
+language_ptr language_builder::build_language(unsigned long atoms_number, unsigned long agents_number) {
+    name_vector atom_names, agent_names;
+
+    for (unsigned long p = 0; p < atoms_number; ++p)
+        atom_names.emplace_back("p" + std::to_string(p));
+
+    for (unsigned long ag = 0; ag < agents_number; ++ag)
+        agent_names.emplace_back("a" + std::to_string(ag));
+
+    return std::make_shared<language>(std::move(language{atom_names, agent_names}));
+}
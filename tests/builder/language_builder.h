@@ -32,6 +32,9 @@ namespace daedalus::tester {
         static del::language_ptr build_language1();
         static del::language_ptr build_language2();
         static del::language_ptr build_language3();
+
+        // Language with atoms p0, p1, ... and agents a0, a1, ...
+        static del::language_ptr build_language(unsigned long atoms_number, unsigned long agents_number);
     };
 }
 
@@ -25,6 +25,8 @@
 #include "language_builder.h"
 #include <memory>
 #include <deque>
+#include <numeric>
+#include <algorithm>
 
 using namespace daedalus::tester;
 using namespace del;
@@ -66,7 +68,7 @@ state state_builder::build_test_state1(del::label_storage &l_storage) {
     r[a][w5] = world_bitset(worlds_number);
     r[a][w6] = world_bitset(worlds_number);
 
-    label_vector v = label_vector{worlds_number};
+    label_vector v = label_vector(worlds_number);
     v[w0] = l_storage.emplace(label{bs0});
     v[w1] = l_storage.emplace(label{bs0});
     v[w2] = l_storage.emplace(label{bs0});
@@ -100,7 +102,7 @@ state state_builder::build_singleton(bool has_loop, del::label_storage &l_storag
     if (has_loop)
         r[a][0] = world_bitset{worlds_number, world_set{0}};
 
-    label_vector v = label_vector{worlds_number};
+    label_vector v = label_vector(worlds_number);
     v[0] = l_storage.emplace(label{std::move(bs0)});
 
     return state{language, worlds_number, std::move(r), std::move(v), world_bitset{worlds_number, world_set{0}}};
@@ -127,7 +129,7 @@ state state_builder::build_chain(unsigned long length, del::label_storage &l_sto
             r[ag][w] = world_bitset(worlds_number);
     }
 
-    label_vector v = label_vector{worlds_number};
+    label_vector v = label_vector(worlds_number);
 
     for (world_id w = 0; w < worlds_number; ++w) {
         if (has_final_loop)
@@ -161,7 +163,7 @@ state state_builder::build_k_tree(const unsigned long k, del::label_storage &l_s
 
     auto worlds_number = static_cast<world_id>(std::exp2(k));
     relations r = relations{ag_number};
-    label_vector v = label_vector{worlds_number};
+    label_vector v = label_vector(worlds_number);
 
     for (agent ag = 0; ag < ag_number; ++ag) {
         r[ag] = agent_relation(worlds_number);
@@ -215,4 +217,146 @@ state state_builder::build_k_tree(const unsigned long k, del::label_storage &l_s
 //    for (unsigned long r = 1; r <= k; ++r) {
 //        for (unsigned long k_ = 0; w)
 //    }
-}
\ No newline at end of file
+}
+
+state state_builder::build_random_s5(unsigned long worlds_number, unsigned long agents_number, unsigned long classes_number,
+                                     unsigned long atoms_number, unsigned long seed, del::label_storage &l_storage) {
+    language_ptr language = language_builder::build_language(atoms_number, agents_number);
+    std::mt19937_64 generator{seed};
+
+    relations r = relations{agents_number};
+    std::vector<std::vector<world_id>> classes = std::vector<std::vector<world_id>>(classes_number);
+    std::vector<unsigned long> world_class = std::vector<unsigned long>(worlds_number);
+
+    for (agent ag = 0; ag < agents_number; ++ag) {
+        r[ag] = agent_relation(worlds_number);
+
+        for (auto &c : classes)
+            c.clear();
+
+        for (world_id w = 0; w < worlds_number; ++w) {
+            world_class[w] = generator() % classes_number;
+            classes[world_class[w]].emplace_back(w);
+        }
+
+        for (world_id w = 0; w < worlds_number; ++w) {
+            r[ag][w] = world_bitset(worlds_number);
+
+            for (const world_id v : classes[world_class[w]])
+                r[ag][w].push_back(v);
+        }
+    }
+
+    label_vector v = build_random_labels(worlds_number, atoms_number, generator, l_storage);
+    return state{language, worlds_number, std::move(r), std::move(v), world_bitset{worlds_number, world_set{0}}};
+}
+
+state state_builder::build_random_kd45(unsigned long worlds_number, unsigned long agents_number, unsigned long clusters_number,
+                                       unsigned long atoms_number, unsigned long seed, del::label_storage &l_storage) {
+    language_ptr language = language_builder::build_language(atoms_number, agents_number);
+    std::mt19937_64 generator{seed};
+
+    relations r = relations{agents_number};
+    std::vector<std::vector<world_id>> believed = std::vector<std::vector<world_id>>(clusters_number);
+    std::vector<unsigned long> world_cluster = std::vector<unsigned long>(worlds_number);
+
+    for (agent ag = 0; ag < agents_number; ++ag) {
+        r[ag] = agent_relation(worlds_number);
+
+        for (auto &c : believed)
+            c.clear();
+
+        // The first world of each cluster is always believed, so that the relation is serial
+        for (world_id w = 0; w < worlds_number; ++w) {
+            world_cluster[w] = generator() % clusters_number;
+            auto &c = believed[world_cluster[w]];
+
+            if (c.empty() or generator() % 2 == 0)
+                c.emplace_back(w);
+        }
+
+        for (world_id w = 0; w < worlds_number; ++w) {
+            r[ag][w] = world_bitset(worlds_number);
+
+            for (const world_id v : believed[world_cluster[w]])
+                r[ag][w].push_back(v);
+        }
+    }
+
+    label_vector v = build_random_labels(worlds_number, atoms_number, generator, l_storage);
+    return state{language, worlds_number, std::move(r), std::move(v), world_bitset{worlds_number, world_set{0}}};
+}
+
+state state_builder::build_hypercube(unsigned long agents_number, del::label_storage &l_storage) {
+    language_ptr language = language_builder::build_language(agents_number, agents_number);
+    const world_id worlds_number = 1ULL << agents_number;
+
+    relations r = relations{agents_number};
+    label_vector v = label_vector(worlds_number);
+
+    for (agent ag = 0; ag < agents_number; ++ag) {
+        r[ag] = agent_relation(worlds_number);
+
+        for (world_id w = 0; w < worlds_number; ++w) {
+            r[ag][w] = world_bitset(worlds_number);
+            r[ag][w].push_back(w);
+            r[ag][w].push_back(w ^ (1ULL << ag));
+        }
+    }
+
+    for (world_id w = 0; w < worlds_number; ++w) {
+        boost::dynamic_bitset<> bs(agents_number, w);
+        v[w] = l_storage.emplace(label{std::move(bs)});
+    }
+
+    // In the designated world all children are muddy
+    return state{language, worlds_number, std::move(r), std::move(v), world_bitset{worlds_number, world_set{worlds_number - 1}}};
+}
+
+state state_builder::build_permutation(const state &s, unsigned long seed) {
+    const world_id worlds_number = s.get_worlds_number();
+    const agent agents_number = s.get_language()->get_agents_number();
+
+    std::vector<world_id> renaming = std::vector<world_id>(worlds_number);
+    std::iota(renaming.begin(), renaming.end(), 0);
+    std::shuffle(renaming.begin(), renaming.end(), std::mt19937_64{seed});
+
+    relations r = relations{agents_number};
+    label_vector v = label_vector(worlds_number);
+    world_bitset designated_worlds = world_bitset(worlds_number);
+
+    for (agent ag = 0; ag < agents_number; ++ag) {
+        r[ag] = agent_relation(worlds_number);
+
+        for (world_id w = 0; w < worlds_number; ++w) {
+            world_bitset &ws = r[ag][renaming[w]] = world_bitset(worlds_number);
+
+            for (const world_id u : s.get_agent_possible_worlds(ag, w))
+                ws.push_back(renaming[u]);
+        }
+    }
+
+    for (world_id w = 0; w < worlds_number; ++w)
+        v[renaming[w]] = s.get_label_id(w);
+
+    for (const world_id wd : s.get_designated_worlds())
+        designated_worlds.push_back(renaming[wd]);
+
+    return state{s.get_language(), worlds_number, std::move(r), std::move(v), std::move(designated_worlds)};
+}
+
+label_vector state_builder::build_random_labels(unsigned long worlds_number, unsigned long atoms_number,
+                                                std::mt19937_64 &generator, del::label_storage &l_storage) {
+    label_vector v = label_vector(worlds_number);
+
+    for (world_id w = 0; w < worlds_number; ++w) {
+        boost::dynamic_bitset<> bs(atoms_number);
+
+        for (atom p = 0; p < atoms_number; ++p)
+            bs[p] = generator() % 2 == 0;
+
+        v[w] = l_storage.emplace(label{std::move(bs)});
+    }
+
+    return v;
+}
@@ -24,6 +24,7 @@
 #ifndef DAEDALUS_STATE_BUILDER_H
 #define DAEDALUS_STATE_BUILDER_H
 
+#include <random>
 #include "../../include/del/semantics/kripke/states/state.h"
 
 namespace daedalus::tester {
@@ -33,6 +34,25 @@ namespace daedalus::tester {
         static kripke::state build_singleton(bool has_loop, del::label_storage &l_storage);
         static kripke::state build_chain(unsigned long length, del::label_storage &l_storage, bool has_final_loop, bool all_designated = false);
         static kripke::state build_k_tree(unsigned long k, del::label_storage &l_storage);
+
+        // Random S5 state: the worlds are randomly partitioned into classes_number equivalence classes for each agent
+        static kripke::state build_random_s5(unsigned long worlds_number, unsigned long agents_number, unsigned long classes_number,
+                                             unsigned long atoms_number, unsigned long seed, del::label_storage &l_storage);
+
+        // Random KD45 state: the worlds are randomly partitioned into clusters_number clusters for each agent, and every
+        // world of a cluster points to a random non-empty subset of the cluster
+        static kripke::state build_random_kd45(unsigned long worlds_number, unsigned long agents_number, unsigned long clusters_number,
+                                               unsigned long atoms_number, unsigned long seed, del::label_storage &l_storage);
+
+        // Muddy-children-like hypercube: 2^n worlds, where agent i can not distinguish worlds that only differ on atom pi
+        static kripke::state build_hypercube(unsigned long agents_number, del::label_storage &l_storage);
+
+        // Copy of s where worlds are randomly renamed
+        static kripke::state build_permutation(const kripke::state &s, unsigned long seed);
+
+    private:
+        static kripke::label_vector build_random_labels(unsigned long worlds_number, unsigned long atoms_number,
+                                                        std::mt19937_64 &generator, del::label_storage &l_storage);
     };
 }
 
@@ -94,7 +94,8 @@ void printer::to_string(std::ofstream &os, const kripke::state &s, const del::la
             boost::dynamic_bitset<> out(s.get_worlds_number());
 
             for (del::agent ag = 0; ag < s.get_language()->get_agents_number(); ++ag)
-                out |= *s.get_agent_possible_worlds(ag, w);
+                for (const world_id v : s.get_agent_possible_worlds(ag, w))
+                    out.set(v);
 
             ranks[out.to_ulong()].emplace_back(w);
         }
@@ -0,0 +1,11 @@
+#!/bin/bash
+
+DAEDALUS_BENCHMARK=../../cmake-build-debug/DAEDALUS_BENCHMARK
+OUT=../results/benchmarks
+
+mkdir -p "$OUT"
+
+# One process per model, so that the peak memory of each model is measured separately
+for model in chain k_tree s5 kd45 hypercube; do
+    "$DAEDALUS_BENCHMARK" --models "$model" --worlds 1000 4096 16384 65536 1048576 --repetitions 5 --output "$OUT/$model.csv"
+done
@@ -108,6 +108,25 @@ void search_tester::run_contractions_tests(const del::storages_handler_ptr &hand
 //    bisimulation_tester::test_bisim_cn               (OUT_PATH + "contractions/", 5, 5, s_storage, is_storage);
 }
 
+void search_tester::run_composition_tests(del::storages_handler_ptr handler) {
+    // The plans of the tasks are applicable sequences, so their compositions must give the same states
+    for (const planning_task &task : coin_in_the_box::build_tasks(handler->get_label_storage())) {
+        const auto &[path, _] = planner::search(task, search::strategy::unbounded_search, contraction_type::full, handler);
+        std::vector<std::string> names;
+        kripke::action_deque as;
+
+        for (const node_ptr &n : path)
+            if (n->get_action()) {
+                names.push_back(n->get_action()->get_name());
+                as.push_back(n->get_action());
+            }
+
+        if (as.size() > 1)
+            update_tester::test_composition(*task.get_initial_state(), as, *task.get_macro_action(names),
+                                            handler->get_label_storage());
+    }
+}
+
 void search_tester::run_search_tests(const std::vector<planning_task> &tasks, del::storages_handler_ptr handler) {
     for (const planning_task &task : tasks) {
         planner::search(task, search::strategy::iterative_bounded_search, contraction_type::canonical, handler);
@@ -35,6 +35,7 @@ namespace daedalus::tester {
         static void run_actions_tests();
         static void run_product_update_tests(del::label_storage &l_storage);
         static void run_contractions_tests(const del::storages_handler_ptr &handler);
+        static void run_composition_tests(del::storages_handler_ptr handler);
 
         static void run_coin_in_the_box_search_tests(del::storages_handler_ptr handler);
         static void run_consecutive_numbers_search_tests(del::storages_handler_ptr handler);
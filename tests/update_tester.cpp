@@ -32,6 +32,8 @@
 #include "printer.h"
 #include "../include/del/formulas/propositional/true_formula.h"
 #include "builder/domains/coin_in_the_box.h"
+#include "../include/del/semantics/kripke/bisimulation/bisimulator.h"
+#include <iostream>
 
 using namespace daedalus::tester;
 using namespace kripke;
@@ -98,3 +100,16 @@ state update_tester::test_CB_3(const std::string &out_path, del::label_storage &
 
     return s_cb_open_peek;
 }
+
+bool update_tester::test_composition(const state &s, const kripke::action_deque &as, const action &composition,
+                                     del::label_storage &l_storage) {
+    state s_seq = updater::product_update(s, *as.front(), l_storage);
+
+    for (auto a = std::next(as.begin()); a != as.end(); ++a)
+        s_seq = updater::product_update(s_seq, **a, l_storage);
+
+    const bool is_bisim = bisimulator::are_bisimilar(updater::product_update(s, composition, l_storage), s_seq);
+
+    std::cout << "Composition of " << as.size() << " actions: " << (is_bisim ? "OK" : "FAILED") << std::endl;
+    return is_bisim;
+}
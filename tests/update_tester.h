@@ -25,6 +25,7 @@
 #define DAEDALUS_UPDATE_TESTER_H
 
 #include "../include/del/semantics/kripke/states/state.h"
+#include "../include/del/semantics/kripke/actions/action.h"
 
 namespace daedalus::tester {
     class update_tester {
@@ -32,6 +33,11 @@ namespace daedalus::tester {
         static kripke::state test_CB_1(const std::string &out_path, del::label_storage &l_storage, bool print = true);
         static kripke::state test_CB_2(const std::string &out_path, del::label_storage &l_storage, bool print = true);
         static kripke::state test_CB_3(const std::string &out_path, del::label_storage &l_storage, bool print = true);
+
+        // Checks that updating s with the composition of as (non empty) gives a state bisimilar to updating s with each
+        // action of as
+        static bool test_composition(const kripke::state &s, const kripke::action_deque &as, const kripke::action &composition,
+                                     del::label_storage &l_storage);
     };
 }
 